@@ -23,6 +23,7 @@ entity neorv32_dma is
     bus_rsp_o : out bus_rsp_t;  -- bus response
     dma_req_o : out bus_req_t;  -- DMA request
     dma_rsp_i : in  bus_rsp_t;  -- DMA response
+    req_i     : in  std_ulogic_vector(15 downto 0); -- peripheral transfer requests (processor FIRQ lines)
     irq_o     : out std_ulogic  -- transfer done interrupt
   );
 end neorv32_dma;
@@ -42,6 +43,9 @@ architecture neorv32_dma_rtl of neorv32_dma is
   -- control and status register bits --
   constant ctrl_en_c       : natural :=  0; -- r/w: DMA enable
   constant ctrl_start_c    : natural :=  1; -- -/s: start DMA operation
+  constant ctrl_req_en_c   : natural :=  2; -- r/w: pace transfer by peripheral request
+  constant ctrl_req_lo_c   : natural :=  3; -- r/w: peripheral request select, LSB
+  constant ctrl_req_hi_c   : natural :=  6; -- r/w: peripheral request select, MSB
   --
   constant ctrl_error_rd_c : natural := 28; -- r/-: error during read transfer
   constant ctrl_error_wr_c : natural := 29; -- r/-: error during write transfer
@@ -59,6 +63,8 @@ architecture neorv32_dma_rtl of neorv32_dma is
     enable   : std_ulogic; -- DMA enabled when set
     start    : std_ulogic; -- transfer start trigger
     done     : std_ulogic; -- transfer was executed (but might have failed)
+    req_en   : std_ulogic; -- wait for peripheral request before each write
+    req_sel  : std_ulogic_vector(3 downto 0); -- peripheral request select
     src_base : std_ulogic_vector(31 downto 0); -- source base address
     dst_base : std_ulogic_vector(31 downto 0); -- destination base address
     num      : std_ulogic_vector(23 downto 0); -- number of elements
@@ -70,7 +76,7 @@ architecture neorv32_dma_rtl of neorv32_dma is
   signal cfg : cfg_t;
 
   -- bus access engine --
-  type state_t is (S_IDLE, S_READ, S_WRITE, S_NEXT);
+  type state_t is (S_IDLE, S_READ, S_WAIT, S_WRITE, S_NEXT);
   type engine_t is record
     state    : state_t;
     stb      : std_ulogic;
@@ -101,6 +107,8 @@ begin
       cfg.enable   <= '0';
       cfg.start    <= '0';
       cfg.done     <= '0';
+      cfg.req_en   <= '0';
+      cfg.req_sel  <= (others => '0');
       cfg.src_base <= (others => '0');
       cfg.dst_base <= (others => '0');
       cfg.num      <= (others => '0');
@@ -122,9 +130,11 @@ begin
       if (bus_req_i.stb = '1') then
         if (bus_req_i.rw = '1') then -- write access
           if (bus_req_i.addr(3 downto 2) = "00") then -- control and status register
-            cfg.enable <= bus_req_i.data(ctrl_en_c);
-            cfg.start  <= bus_req_i.data(ctrl_start_c); -- start transfer
-            cfg.done   <= '0'; -- clear on write access
+            cfg.enable  <= bus_req_i.data(ctrl_en_c);
+            cfg.start   <= bus_req_i.data(ctrl_start_c); -- start transfer
+            cfg.req_en  <= bus_req_i.data(ctrl_req_en_c);
+            cfg.req_sel <= bus_req_i.data(ctrl_req_hi_c downto ctrl_req_lo_c);
+            cfg.done    <= '0'; -- clear on write access
           end if;
           if (bus_req_i.addr(3 downto 2) = "01") then -- source base address
             cfg.src_base <= bus_req_i.data;
@@ -142,11 +152,13 @@ begin
         else -- read access
           case bus_req_i.addr(3 downto 2) is
             when "00" => -- control and status register
-              bus_rsp_o.data(ctrl_en_c)       <= cfg.enable;
-              bus_rsp_o.data(ctrl_error_rd_c) <= engine.err_rd;
-              bus_rsp_o.data(ctrl_error_wr_c) <= engine.err_wr;
-              bus_rsp_o.data(ctrl_done_c)     <= cfg.done;
-              bus_rsp_o.data(ctrl_busy_c)     <= engine.busy;
+              bus_rsp_o.data(ctrl_en_c)                          <= cfg.enable;
+              bus_rsp_o.data(ctrl_req_en_c)                      <= cfg.req_en;
+              bus_rsp_o.data(ctrl_req_hi_c downto ctrl_req_lo_c) <= cfg.req_sel;
+              bus_rsp_o.data(ctrl_error_rd_c)                    <= engine.err_rd;
+              bus_rsp_o.data(ctrl_error_wr_c)                    <= engine.err_wr;
+              bus_rsp_o.data(ctrl_done_c)                        <= cfg.done;
+              bus_rsp_o.data(ctrl_busy_c)                        <= engine.busy;
             when "01" => -- address of last read access
               bus_rsp_o.data <= engine.src_addr;
             when "10" => -- address of last write access
@@ -211,7 +223,21 @@ begin
             engine.err_rd <= '1';
             engine.state  <= S_IDLE;
           elsif (dma_rsp_i.ack = '1') then
-            engine.rw    <= '1'; -- write
+            engine.rw <= '1'; -- write
+            if (cfg.req_en = '1') then -- wait for peripheral request
+              engine.state <= S_WAIT;
+            else
+              engine.stb   <= '1'; -- issue write request
+              engine.state <= S_WRITE;
+            end if;
+          end if;
+
+        when S_WAIT => -- wait for peripheral request (e.g. "UART TX FIFO not half-full")
+        -- ------------------------------------------------------------
+          if (cfg.enable = '0') then -- transfer aborted
+            engine.done  <= '1';
+            engine.state <= S_IDLE;
+          elsif (req_i(to_integer(unsigned(cfg.req_sel))) = '1') then
             engine.stb   <= '1'; -- issue write request
             engine.state <= S_WRITE;
           end if;
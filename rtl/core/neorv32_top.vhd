@@ -699,6 +699,7 @@ begin
       bus_rsp_o => iodev_rsp(IODEV_DMA),
       dma_req_o => dma_req,
       dma_rsp_i => dma_rsp,
+      req_i     => cpu_firq,
       irq_o     => firq(FIRQ_DMA)
     );
 
@@ -63,6 +63,8 @@ NEORV32_INC_PATH = $(NEORV32_HOME)/sw/lib/include
 NEORV32_SRC_PATH = $(NEORV32_HOME)/sw/lib/source
 # Path to NEORV32 executable generator
 NEORV32_EXG_PATH = $(NEORV32_HOME)/sw/image_gen
+# Path to NEORV32 deferred log decoder
+NEORV32_LDC_PATH = $(NEORV32_HOME)/sw/log_decode
 # Path to NEORV32 rtl folder
 NEORV32_RTL_PATH = $(NEORV32_HOME)/rtl
 # Path to NEORV32 sim folder
@@ -131,6 +133,12 @@ ifeq ($(OS),Windows_NT)
 IMAGE_GEN := $(IMAGE_GEN).exe
 endif
 
+# NEORV32 deferred log decoder (host tool)
+LOG_DECODE = $(NEORV32_LDC_PATH)/log_decode
+ifeq ($(OS),Windows_NT)
+LOG_DECODE := $(LOG_DECODE).exe
+endif
+
 # Compiler & linker flags
 CC_FLAGS  = -march=$(MARCH) -mabi=$(MABI) $(EFFORT) -Wall -ffunction-sections -fdata-sections -nostartfiles -mno-fdiv
 CC_FLAGS += -mstrict-align -mbranch-cost=10 -Wl,--gc-sections -ffp-contract=off -g
@@ -149,7 +157,7 @@ NEO_ASFLAGS  = $(CC_FLAGS) $(ASFLAGS)
 # Application output definitions
 # -----------------------------------------------------------------------------
 
-.PHONY: check info help elf_info clean clean_all
+.PHONY: check info help elf_info clean clean_all log_decode
 .DEFAULT_GOAL := help
 
 elf:     $(APP_ELF)
@@ -189,6 +197,13 @@ $(IMAGE_GEN): $(NEORV32_EXG_PATH)/image_gen.c
 	$(ECHO) Compiling image generator...
 	$(Q)$(CC_HOST) $< -o $(IMAGE_GEN)
 
+# Compile deferred log decoder
+$(LOG_DECODE): $(NEORV32_LDC_PATH)/log_decode.c
+	$(ECHO) Compiling log decoder...
+	$(Q)$(CC_HOST) $< -o $(LOG_DECODE)
+
+log_decode: $(LOG_DECODE)
+
 # -----------------------------------------------------------------------------
 # General targets: Assemble, compile, link, dump
 # -----------------------------------------------------------------------------
@@ -340,9 +355,9 @@ clean:
 	$(Q)$(RM) -f $(APP_EXE) $(APP_ELF) $(APP_HEX) $(APP_BIN) $(APP_COE) $(APP_MEM) $(APP_MIF) $(APP_ASM) $(APP_VHD) $(BOOT_VHD)
 	$(Q)$(RM) -f .gdb_history
 
-# also remove image generator
+# also remove image generator and log decoder
 clean_all: clean
-	$(Q)$(RM) -f $(IMAGE_GEN)
+	$(Q)$(RM) -f $(IMAGE_GEN) $(LOG_DECODE)
 	$(Q)$(RM) -rf $(NEORV32_SIM_PATH)/build
 
 # -----------------------------------------------------------------------------
@@ -438,7 +453,8 @@ help:
 	$(ECHO) "  elf_info      show ELF layout info"
 	$(ECHO) "  elf_sections  show ELF sections"
 	$(ECHO) "  clean         clean up project home folder"
-	$(ECHO) "  clean_all     clean up project home folder and image generator"
+	$(ECHO) "  clean_all     clean up project home folder, image generator and log decoder"
+	$(ECHO) "  log_decode    compile host-side decoder for the deferred binary log (sw/log_decode)"
 	$(ECHO) "  bl_image      compile and generate VHDL BOOTROM bootloader boot image <$(BOOT_VHD)> in local folder"
 	$(ECHO) "  bootloader    compile, generate and install VHDL BOOTROM bootloader boot image <$(BOOT_VHD)>"
 	$(ECHO) ""
@@ -0,0 +1,210 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_arena/main.c
+ * @brief Dual-core allocation throughput: shared (locked) heap vs. per-hart arenas.
+ **************************************************************************/
+#include <neorv32.h>
+#include <stdlib.h>
+
+/** User configuration */
+#define BAUD_RATE  19200 // UART0 Baud rate
+#define NUM_SLOTS  16    // allocation slots per core
+#define NUM_OPS    2000  // alloc/free operations per core
+#define ARENA_SIZE 6144  // arena size per core in bytes
+
+/** Benchmark commands for core 1 */
+enum cmd_enum {
+  CMD_SHARED = 1, // run workload using the shared heap (newlib malloc/free)
+  CMD_ARENA  = 2, // run workload using the arena of core 1
+  CMD_REMOTE = 3  // release all blocks that were allocated by core 0
+};
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+uint8_t __attribute__ ((aligned (8))) arena_mem[2][ARENA_SIZE]; // arena memory for each core
+void *slot[2][NUM_SLOTS]; // allocated blocks of each core
+
+
+/**********************************************************************//**
+ * Random alloc/free workload.
+ *
+ * @param[in] use_arena 0: newlib malloc/free, 1: per-hart arena.
+ * @return Number of failed allocations.
+ **************************************************************************/
+uint32_t workload(int use_arena) {
+
+  uint32_t hart = neorv32_smp_whoami();
+  uint32_t lfsr = 0x1234567u + hart; // each core uses a different sequence
+  uint32_t i, idx, size, fails = 0;
+  void **s = slot[hart];
+
+  for (i=0; i<NUM_OPS; i++) {
+    lfsr ^= lfsr << 13; lfsr ^= lfsr >> 17; lfsr ^= lfsr << 5;
+    idx = lfsr % NUM_SLOTS;
+    if (s[idx] == NULL) {
+      size = 8 + ((lfsr >> 8) & 0xff);
+      s[idx] = use_arena ? neorv32_arena_malloc(size) : malloc(size);
+      if (s[idx] == NULL) {
+        fails++;
+      }
+    }
+    else {
+      if (use_arena) {
+        neorv32_arena_free(s[idx]);
+      }
+      else {
+        free(s[idx]);
+      }
+      s[idx] = NULL;
+    }
+  }
+  return fails;
+}
+
+
+/**********************************************************************//**
+ * Release all blocks of a core.
+ *
+ * @param[in] hart Core whose blocks are released.
+ * @param[in] use_arena 0: newlib free, 1: arena free.
+ **************************************************************************/
+void release_all(int hart, int use_arena) {
+
+  int i;
+  for (i=0; i<NUM_SLOTS; i++) {
+    if (use_arena) {
+      neorv32_arena_free(slot[hart][i]);
+    }
+    else {
+      free(slot[hart][i]);
+    }
+    slot[hart][i] = NULL;
+  }
+}
+
+
+/**********************************************************************//**
+ * Main function for core 1 (secondary core): execute commands from core 0.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int core1_entry(void) {
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core1)
+  neorv32_rte_setup();
+
+  uint32_t res;
+  while (1) {
+    res = 0;
+    switch (neorv32_smp_icc_pop()) {
+      case CMD_SHARED: res = workload(0); break;
+      case CMD_ARENA:  res = workload(1); break;
+      case CMD_REMOTE: asm volatile ("fence"); release_all(0, 1); break;
+      default: break;
+    }
+    asm volatile ("fence"); // synchronize data cache with main memory (shared slot arrays)
+    neorv32_smp_icc_push(res);
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Run workload on both cores in parallel.
+ *
+ * @param[in] use_arena 0: newlib malloc/free, 1: per-hart arena.
+ **************************************************************************/
+void run(int use_arena) {
+
+  uint64_t time_delta = neorv32_clint_time_get();
+
+  neorv32_smp_icc_push(use_arena ? CMD_ARENA : CMD_SHARED); // start core 1
+  uint32_t fails = workload(use_arena);
+  fails += neorv32_smp_icc_pop(); // wait for core 1
+
+  time_delta = neorv32_clint_time_get() - time_delta;
+
+  neorv32_uart0_printf("%s %u alloc/free operations in %u cycles (%u failed allocations)\n",
+                       use_arena ? "[ARENA] " : "[SHARED]", 2*NUM_OPS, (uint32_t)time_delta, fails);
+}
+
+
+/**********************************************************************//**
+ * Compare allocation throughput of a shared heap and per-hart arenas.
+ *
+ * @note This program requires the dual-core configuration, the CLINT and UART0.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  neorv32_tlsf_stats_t stats;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Dual-Core Allocation Arenas >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+
+  // setup one arena per core
+  if (neorv32_arena_setup(0, arena_mem[0], ARENA_SIZE) || neorv32_arena_setup(1, arena_mem[1], ARENA_SIZE)) {
+    neorv32_uart0_printf("[ERROR] Arena setup failed (requires the A ISA extension or the HWSPINLOCK)!\n");
+    return -1;
+  }
+
+  // launch secondary CPU core
+  neorv32_uart0_printf("Launching core 1...\n");
+  int smp_launch_rc = neorv32_smp_launch(core1_entry, (uint8_t*)core1_stack, sizeof(core1_stack));
+
+  // check if launching was successful
+  if (smp_launch_rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", smp_launch_rc);
+    return -1;
+  }
+
+  // shared heap: every operation acquires newlib's malloc lock
+  run(0);
+  release_all(0, 0);
+  release_all(1, 0);
+
+  // per-hart arenas: no locking
+  run(1);
+
+  // cross-core release: core 1 releases core 0's blocks, core 0 releases core 1's blocks
+  asm volatile ("fence");
+  neorv32_smp_icc_push(CMD_REMOTE);
+  release_all(1, 1);
+  neorv32_smp_icc_pop();
+  asm volatile ("fence");
+
+  // core 0 takes back its blocks during the next allocation
+  neorv32_arena_free(neorv32_arena_malloc(8));
+
+  neorv32_arena_get_stats(0, &stats);
+  neorv32_uart0_printf("Arena 0: %u bytes in use, peak %u bytes, largest free block %u bytes\n",
+                       stats.used, stats.peak, stats.largest);
+
+  return 0;
+}
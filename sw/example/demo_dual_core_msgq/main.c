@@ -0,0 +1,265 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_msgq/main.c
+ * @brief Zero-copy message queue demo: latency and throughput compared to
+ * copying the payload through the inter-core communication (ICC) link.
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+#define NUM_MSG   256   // messages per benchmark run
+#define NUM_BUF   16    // number of payload buffers (= number of queue slots)
+#define BUF_SIZE  256   // payload buffer size in bytes (multiple of the cache block size)
+
+/** ICC header flag: core1 replies with the checksum of this message */
+#define ICC_REPLY 0x80000000u
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+uint32_t __attribute__ ((aligned (64))) buffer[NUM_BUF][BUF_SIZE/4]; // payload buffers
+uint32_t expected[NUM_BUF]; // expected checksum of each buffer
+NEORV32_MSGQ_DEFINE(txq, NUM_BUF); // core0 -> core1: filled buffers
+NEORV32_MSGQ_DEFINE(rxq, NUM_BUF); // core1 -> core0: processed buffers
+
+
+/**********************************************************************//**
+ * Payload checksum (all words except the first one, which returns the result).
+ *
+ * @param[in] buf Payload buffer.
+ * @param[in] len Payload length in bytes.
+ * @return Checksum.
+ **************************************************************************/
+uint32_t checksum(const uint32_t *buf, uint32_t len) {
+
+  uint32_t i, sum = 0;
+  for (i=1; i<(len/4); i++) {
+    sum += buf[i];
+  }
+  return sum;
+}
+
+
+/**********************************************************************//**
+ * Main function for core 1: process messages from core 0.
+ *
+ * @return Irrelevant (never returns).
+ **************************************************************************/
+int core1_entry(void) {
+
+  uint32_t hdr, sum, i;
+  int n;
+  neorv32_msgq_msg_t msg[NUM_BUF];
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core1)
+  neorv32_rte_setup();
+
+  // phase 1: the payload is copied through the ICC link: header (number of words and
+  // reply flag) followed by the payload words; a zero header ends this phase
+  while (1) {
+    hdr = neorv32_smp_icc_pop();
+    if (hdr == 0) {
+      break;
+    }
+    sum = 0;
+    neorv32_smp_icc_pop(); // first word is not part of the checksum
+    for (i=1; i<(hdr & 0xffff); i++) {
+      sum += neorv32_smp_icc_pop();
+    }
+    if (hdr & ICC_REPLY) {
+      neorv32_smp_icc_push(sum);
+    }
+  }
+
+  // phase 2: only buffer descriptors are passed; the checksum is stored in the first
+  // word of each buffer and the entire batch is handed back to core 0
+  while (1) {
+    n = neorv32_msgq_recv_wait(&txq, msg, NUM_BUF);
+    for (i=0; i<(uint32_t)n; i++) {
+      ((uint32_t*)msg[i].buf)[0] = checksum((uint32_t*)msg[i].buf, msg[i].len);
+    }
+    neorv32_msgq_send_batch(&rxq, msg, (uint32_t)n); // cannot fail: there are only NUM_BUF buffers
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Copy one message through the ICC link.
+ *
+ * @param[in] buf Payload buffer.
+ * @param[in] len Payload length in bytes.
+ * @param[in] flags Header flags.
+ **************************************************************************/
+void icc_send(const uint32_t *buf, uint32_t len, uint32_t flags) {
+
+  uint32_t i;
+  neorv32_smp_icc_push((len/4) | flags);
+  for (i=0; i<(len/4); i++) {
+    neorv32_smp_icc_push(buf[i]);
+  }
+}
+
+
+/**********************************************************************//**
+ * Stream NUM_MSG messages through the message queues using batches.
+ *
+ * @param[in] len Payload length in bytes.
+ * @param[in] batch Number of messages per batch (has to divide NUM_MSG and NUM_BUF).
+ * @return Number of wrong checksums.
+ **************************************************************************/
+uint32_t msgq_stream(uint32_t len, uint32_t batch) {
+
+  uint32_t sent = 0, done = 0, errors = 0, i, b;
+  int n;
+  neorv32_msgq_msg_t msg[NUM_BUF];
+
+  while (done < NUM_MSG) {
+    // buffers are used round-robin as both queues preserve the order
+    if ((sent < NUM_MSG) && ((NUM_BUF - (sent - done)) >= batch)) {
+      for (i=0; i<batch; i++) {
+        msg[i].buf = buffer[(sent + i) % NUM_BUF];
+        msg[i].len = len;
+      }
+      neorv32_msgq_send_batch(&txq, msg, batch);
+      sent += batch;
+    }
+    n = neorv32_msgq_recv(&rxq, msg, NUM_BUF);
+    for (i=0; i<(uint32_t)n; i++) {
+      b = ((uint32_t)msg[i].buf - (uint32_t)buffer) / BUF_SIZE;
+      if (((uint32_t*)msg[i].buf)[0] != expected[b]) {
+        errors++;
+      }
+    }
+    done += (uint32_t)n;
+  }
+  return errors;
+}
+
+
+/**********************************************************************//**
+ * Message queue demo.
+ *
+ * @note This program requires the dual-core configuration, the A ISA extension,
+ * the CLINT, UART0 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  const uint32_t size[3] = {16, 64, BUF_SIZE};
+  uint32_t icc_lat[3], icc_thr[3];
+  uint32_t s, m, i, b, len, batch, errors = 0;
+  uint64_t t;
+  neorv32_msgq_msg_t msg;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Zero-Copy Message Queue >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+
+  // fill payload buffers
+  for (b=0; b<NUM_BUF; b++) {
+    for (i=0; i<(BUF_SIZE/4); i++) {
+      buffer[b][i] = (b << 16) ^ (i * 2654435761u);
+    }
+  }
+
+  // setup queues before core1 accesses them
+  if (neorv32_msgq_init(&txq, txq_slot, NUM_BUF, 1) || neorv32_msgq_init(&rxq, rxq_slot, NUM_BUF, 0)) {
+    neorv32_uart0_printf("[ERROR] Message queue setup failed (A ISA extension required)!\n");
+    return -1;
+  }
+
+  // launch secondary CPU core
+  int smp_launch_rc = neorv32_smp_launch(core1_entry, (uint8_t*)core1_stack, sizeof(core1_stack));
+  if (smp_launch_rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", smp_launch_rc);
+    return -1;
+  }
+
+  // raw ICC link: latency (round trip) and throughput (streaming)
+  for (s=0; s<3; s++) {
+    len = size[s];
+    for (b=0; b<NUM_BUF; b++) {
+      expected[b] = checksum(buffer[b], len);
+    }
+
+    t = neorv32_cpu_get_cycle();
+    for (m=0; m<NUM_MSG; m++) {
+      icc_send(buffer[m % NUM_BUF], len, ICC_REPLY);
+      if (neorv32_smp_icc_pop() != expected[m % NUM_BUF]) {
+        errors++;
+      }
+    }
+    icc_lat[s] = (uint32_t)(neorv32_cpu_get_cycle() - t) / NUM_MSG;
+
+    t = neorv32_cpu_get_cycle();
+    for (m=0; m<NUM_MSG; m++) {
+      icc_send(buffer[m % NUM_BUF], len, (m == (NUM_MSG-1)) ? ICC_REPLY : 0);
+    }
+    if (neorv32_smp_icc_pop() != expected[(NUM_MSG-1) % NUM_BUF]) {
+      errors++;
+    }
+    icc_thr[s] = (uint32_t)(neorv32_cpu_get_cycle() - t) / NUM_MSG;
+  }
+  neorv32_smp_icc_push(0); // switch core1 to the message queues
+
+  // zero-copy message queues (the payload size has no impact on the queue itself)
+  neorv32_uart0_printf("payload | ICC latency | ICC thrput | MSGQ latency | MSGQ thrput batch 1/4/16\n");
+  for (s=0; s<3; s++) {
+    len = size[s];
+    for (b=0; b<NUM_BUF; b++) {
+      expected[b] = checksum(buffer[b], len);
+    }
+    neorv32_uart0_printf("%u bytes | %u | %u |", len, icc_lat[s], icc_thr[s]);
+
+    t = neorv32_cpu_get_cycle();
+    for (m=0; m<NUM_MSG; m++) {
+      neorv32_msgq_send(&txq, buffer[m % NUM_BUF], len);
+      while (neorv32_msgq_recv(&rxq, &msg, 1) == 0);
+      if (((uint32_t*)msg.buf)[0] != expected[m % NUM_BUF]) {
+        errors++;
+      }
+    }
+    neorv32_uart0_printf(" %u |", (uint32_t)(neorv32_cpu_get_cycle() - t) / NUM_MSG);
+
+    for (batch=1; batch<=NUM_BUF; batch*=4) {
+      t = neorv32_cpu_get_cycle();
+      errors += msgq_stream(len, batch);
+      neorv32_uart0_printf(" %u", (uint32_t)(neorv32_cpu_get_cycle() - t) / NUM_MSG);
+    }
+    neorv32_uart0_printf("\n");
+  }
+  neorv32_uart0_printf("(all values in CPU cycles per message)\n\n");
+
+  if (errors) {
+    neorv32_uart0_printf("[FAILED] %u wrong checksums\n", errors);
+    return -1;
+  }
+  neorv32_uart0_printf("[OK] all checksums correct\n");
+  return 0;
+}
@@ -0,0 +1,157 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_mutex/main.c
+ * @brief Sleeping mutex demo: critical section length when waiting by spinning on the
+ * HWSPINLOCK compared to sleeping in the mutex, plus mutex contention statistics.
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+#define NUM_ITER  500   // lock acquisitions per core
+#define NUM_WORDS 64    // size of the shared data that is updated in the critical section
+#define SPINLOCK  0     // HWSPINLOCK lock used for spinning
+#define MUTEXLOCK 1     // HWSPINLOCK lock used by the mutex
+
+/** Per-core results (one cache block per core) */
+typedef struct __attribute__((aligned(64))) {
+  uint32_t hold; // cycles spent in the critical section
+} result_t;
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+neorv32_sync_barrier_t barrier;
+neorv32_mutex_t mutex;
+uint32_t __attribute__ ((aligned (64))) shared[NUM_WORDS]; // data protected by the lock
+uint32_t __attribute__ ((aligned (64))) mode[16]; // 0 = spin, 1 = mutex (written before a barrier)
+result_t result[2];
+
+
+/**********************************************************************//**
+ * Critical section: update all words of the shared data.
+ **************************************************************************/
+void critical_section(void) {
+
+  uint32_t i;
+  for (i=0; i<NUM_WORDS; i++) {
+    shared[i] += i;
+  }
+}
+
+
+/**********************************************************************//**
+ * Benchmark loop executed by both cores.
+ *
+ * @param[in] core Core ID.
+ **************************************************************************/
+void bench(uint32_t core) {
+
+  uint32_t i, t, hold = 0;
+
+  neorv32_sync_barrier_wait(&barrier); // mode is valid now
+  for (i=0; i<NUM_ITER; i++) {
+    if (mode[0] == 0) {
+      neorv32_hwspinlock_acquire_blocking(SPINLOCK); // waiting core keeps polling the bus
+      asm volatile ("fence");
+      t = neorv32_cpu_csr_read(CSR_MCYCLE);
+      critical_section();
+      hold += neorv32_cpu_csr_read(CSR_MCYCLE) - t;
+      asm volatile ("fence");
+      neorv32_hwspinlock_release(SPINLOCK);
+    }
+    else {
+      neorv32_mutex_lock(&mutex); // waiting core sleeps
+      t = neorv32_cpu_csr_read(CSR_MCYCLE);
+      critical_section();
+      hold += neorv32_cpu_csr_read(CSR_MCYCLE) - t;
+      neorv32_mutex_unlock(&mutex);
+    }
+  }
+  result[core].hold = hold;
+  neorv32_sync_barrier_wait(&barrier); // results are valid now
+}
+
+
+/**********************************************************************//**
+ * Main function for core 1.
+ *
+ * @return Irrelevant.
+ **************************************************************************/
+int core1_entry(void) {
+
+  neorv32_rte_setup();
+  while (1) {
+    bench(1);
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Sleeping mutex demo.
+ *
+ * @note This program requires the dual-core configuration, the HWSPINLOCK, the
+ * A ISA extension, the CLINT, UART0 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  uint32_t m;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Sleeping Mutex >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+  if (neorv32_hwspinlock_available() == 0) { // HWSPINLOCK available?
+    neorv32_uart0_printf("[ERROR] HWSPINLOCK module not available!\n");
+    return -1;
+  }
+
+  // initialize synchronization objects before core1 is launched
+  neorv32_hwspinlock_clear();
+  neorv32_mutex_init(&mutex, MUTEXLOCK);
+  neorv32_sync_barrier_init(&barrier, 2);
+
+  // launch secondary CPU core
+  int smp_launch_rc = neorv32_smp_launch(core1_entry, (uint8_t*)core1_stack, sizeof(core1_stack));
+  if (smp_launch_rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", smp_launch_rc);
+    return -1;
+  }
+
+  // the critical section of the lock owner takes longer if the other core keeps polling the bus
+  for (m=0; m<2; m++) {
+    mode[0] = m;
+    bench(0);
+    neorv32_uart0_printf("%s: average critical section %u cycles (core0), %u cycles (core1)\n",
+                         m ? "sleeping mutex    " : "spinning HWSPINLOCK",
+                         result[0].hold / NUM_ITER, result[1].hold / NUM_ITER);
+  }
+
+  neorv32_uart0_printf("\n");
+  neorv32_mutex_print_stats(&mutex, "demo");
+  return 0;
+}
@@ -0,0 +1,204 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_parallel/main.c
+ * @brief Speedup benchmarks for the parallel loop API (persistent core 1 worker).
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+#define NUM_PRIME 4000  // count prime numbers between 0 and this value
+#define NUM_ARRAY 1024  // number of array elements
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+uint32_t array[NUM_ARRAY];
+
+
+/**********************************************************************//**
+ * Check if number is prime (the cost grows with n, so the loop is unbalanced).
+ *
+ * @param[in] n Number to check.
+ * @return 1 if number is prime; 0 otherwise.
+ **************************************************************************/
+uint32_t is_prime(uint32_t n) {
+
+  uint32_t i = 0;
+  if (n < 2) {
+    return 0;
+  }
+  for (i = 2; i*i <= n; ++i) {
+    if (n % i == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+
+/**********************************************************************//**
+ * Reduction body: count primes in [beg, end).
+ **************************************************************************/
+uint32_t count_primes(uint32_t beg, uint32_t end, void *ctx) {
+
+  uint32_t i, num = 0;
+  (void)ctx;
+  for (i=beg; i<end; i++) {
+    num += is_prime(i);
+  }
+  return num;
+}
+
+
+/**********************************************************************//**
+ * Loop body: fill array with integer square roots of the element index squared plus one.
+ **************************************************************************/
+void fill_array(uint32_t beg, uint32_t end, void *ctx) {
+
+  uint32_t i, r, x;
+  uint32_t *a = (uint32_t*)ctx;
+  for (i=beg; i<end; i++) {
+    x = i * i + 1;
+    r = 0;
+    while ((r + 1) * (r + 1) <= x) {
+      r++;
+    }
+    a[i] = r;
+  }
+}
+
+
+/**********************************************************************//**
+ * Reduction body: sum of array elements in [beg, end).
+ **************************************************************************/
+uint32_t sum_array(uint32_t beg, uint32_t end, void *ctx) {
+
+  uint32_t i, sum = 0;
+  uint32_t *a = (uint32_t*)ctx;
+  for (i=beg; i<end; i++) {
+    sum += a[i];
+  }
+  return sum;
+}
+
+
+/**********************************************************************//**
+ * Combine partial results: sum.
+ **************************************************************************/
+uint32_t add(uint32_t a, uint32_t b) {
+
+  return a + b;
+}
+
+
+/**********************************************************************//**
+ * Print benchmark result.
+ *
+ * @param[in] name Benchmark name.
+ * @param[in] single Single-core cycles.
+ * @param[in] dual Dual-core cycles.
+ * @param[in] result Result of the dual-core run.
+ **************************************************************************/
+void report(const char *name, uint32_t single, uint32_t dual, uint32_t result) {
+
+  uint32_t speedup = (uint32_t)((100ULL * single) / (dual ? dual : 1));
+  neorv32_uart0_printf("%s: %u -> %u cycles, speedup %u.%u%u (result %u)\n", name, single, dual,
+                       speedup / 100, (speedup / 10) % 10, speedup % 10, result);
+}
+
+
+/**********************************************************************//**
+ * Parallel loop speedup benchmarks.
+ *
+ * @note This program requires the dual-core configuration, the CLINT and UART0.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  uint64_t t;
+  uint32_t single, dual, res, grain;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Parallel Loop Benchmarks >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+
+  // launch persistent worker on core 1
+  int rc = neorv32_smp_worker_start((uint8_t*)core1_stack, sizeof(core1_stack));
+  if (rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", rc);
+    return -1;
+  }
+
+  // -------------------------------------------
+  // Unbalanced reduction: static halves vs. dynamic chunks
+  // -------------------------------------------
+  t = neorv32_clint_time_get();
+  res = count_primes(0, NUM_PRIME, NULL);
+  single = (uint32_t)(neorv32_clint_time_get() - t);
+
+  for (grain = NUM_PRIME/2; grain >= NUM_PRIME/64; grain /= 4) {
+    t = neorv32_clint_time_get();
+    res = neorv32_smp_parallel_reduce(0, NUM_PRIME, grain, count_primes, add, 0, NULL);
+    dual = (uint32_t)(neorv32_clint_time_get() - t);
+    neorv32_uart0_printf("[grain %u] ", grain);
+    report("count primes (unbalanced)", single, dual, res);
+  }
+
+  // -------------------------------------------
+  // parallel_for: compute-bound array fill
+  // -------------------------------------------
+  t = neorv32_clint_time_get();
+  fill_array(0, NUM_ARRAY, array);
+  single = (uint32_t)(neorv32_clint_time_get() - t);
+
+  t = neorv32_clint_time_get();
+  neorv32_smp_parallel_for(0, NUM_ARRAY, 0, fill_array, array);
+  dual = (uint32_t)(neorv32_clint_time_get() - t);
+  report("fill array (compute-bound) ", single, dual, array[NUM_ARRAY-1]);
+
+  // -------------------------------------------
+  // Balanced reduction: memory-bound array sum
+  // -------------------------------------------
+  t = neorv32_clint_time_get();
+  res = sum_array(0, NUM_ARRAY, array);
+  single = (uint32_t)(neorv32_clint_time_get() - t);
+
+  t = neorv32_clint_time_get();
+  res = neorv32_smp_parallel_reduce(0, NUM_ARRAY, 0, sum_array, add, 0, array);
+  dual = (uint32_t)(neorv32_clint_time_get() - t);
+  report("sum array (memory-bound)   ", single, dual, res);
+
+  // -------------------------------------------
+  // Overhead: empty loop
+  // -------------------------------------------
+  t = neorv32_clint_time_get();
+  res = neorv32_smp_parallel_reduce(0, 2, 1, sum_array, add, 0, array);
+  dual = (uint32_t)(neorv32_clint_time_get() - t);
+  neorv32_uart0_printf("\nDispatch overhead (2 iterations): %u cycles\n", dual);
+
+  return 0;
+}
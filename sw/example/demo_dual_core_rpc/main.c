@@ -0,0 +1,160 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_rpc/main.c
+ * @brief Inter-core remote procedure call demo: offload CRC computations to core 1.
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE  19200 // UART0 Baud rate
+#define NUM_BLOCKS 4     // number of data blocks
+#define BLOCK_SIZE 512   // bytes per data block (multiple of the cache block size)
+#define NUM_CALLS  100   // number of calls for the latency measurement
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+uint8_t __attribute__ ((aligned (64))) data[NUM_BLOCKS][BLOCK_SIZE];
+neorv32_rpc_future_t future[NUM_BLOCKS];
+
+/** Data block descriptor (argument of the remote procedure) */
+typedef struct {
+  const uint8_t *buf;
+  uint32_t len;
+} block_t;
+block_t block[NUM_BLOCKS];
+
+
+/**********************************************************************//**
+ * CRC32 (bitwise, polynomial 0xEDB88320).
+ *
+ * @param[in] arg Data block (block_t).
+ * @return CRC32 of the data block.
+ **************************************************************************/
+uint32_t crc32(void *arg) {
+
+  const block_t *b = (const block_t*)arg;
+  uint32_t i, k, crc = 0xffffffffu;
+
+  for (i=0; i<b->len; i++) {
+    crc ^= b->buf[i];
+    for (k=0; k<8; k++) {
+      crc = (crc >> 1) ^ (0xedb88320u & (-(crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+
+/**********************************************************************//**
+ * Empty remote procedure (call overhead).
+ *
+ * @param[in] arg Value to be returned.
+ * @return arg.
+ **************************************************************************/
+uint32_t echo(void *arg) {
+
+  return (uint32_t)arg;
+}
+
+
+/**********************************************************************//**
+ * Remote procedure call demo.
+ *
+ * @note This program requires the dual-core configuration, the CLINT, UART0
+ * and the Zicntr ISA extension.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  uint32_t i, j, single, dual, speedup, errors = 0;
+  uint32_t reference[NUM_BLOCKS];
+  uint64_t t;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Remote Procedure Calls >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+
+  // initialize data blocks
+  for (i=0; i<NUM_BLOCKS; i++) {
+    for (j=0; j<BLOCK_SIZE; j++) {
+      data[i][j] = (uint8_t)((i * 131) + (j * 7));
+    }
+    block[i].buf = data[i];
+    block[i].len = BLOCK_SIZE;
+  }
+
+  // single-core reference
+  t = neorv32_cpu_get_cycle();
+  for (i=0; i<NUM_BLOCKS; i++) {
+    reference[i] = crc32(&block[i]);
+  }
+  single = (uint32_t)(neorv32_cpu_get_cycle() - t);
+  neorv32_uart0_printf("single core: %u cycles for %u blocks\n", single, NUM_BLOCKS);
+
+  // launch RPC server on core 1
+  int rc = neorv32_rpc_server_start((uint8_t*)core1_stack, sizeof(core1_stack));
+  if (rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", rc);
+    return -1;
+  }
+
+  // call overhead: synchronous round trip of an empty function
+  t = neorv32_cpu_get_cycle();
+  for (i=0; i<NUM_CALLS; i++) {
+    if (neorv32_rpc_call(echo, (void*)i) != i) {
+      errors++;
+    }
+  }
+  neorv32_uart0_printf("round trip:  %u cycles per call\n", (uint32_t)(neorv32_cpu_get_cycle() - t) / NUM_CALLS);
+
+  // offload the odd blocks to core 1 and process the even blocks locally in the meantime
+  t = neorv32_cpu_get_cycle();
+  for (i=1; i<NUM_BLOCKS; i+=2) {
+    neorv32_rpc_call_async(&future[i], crc32, &block[i]);
+  }
+  for (i=0; i<NUM_BLOCKS; i+=2) {
+    if (crc32(&block[i]) != reference[i]) {
+      errors++;
+    }
+  }
+  for (i=1; i<NUM_BLOCKS; i+=2) {
+    if (neorv32_rpc_wait(&future[i]) != reference[i]) {
+      errors++;
+    }
+  }
+  dual = (uint32_t)(neorv32_cpu_get_cycle() - t);
+  speedup = (uint32_t)((100ULL * single) / (dual ? dual : 1));
+  neorv32_uart0_printf("offloaded:   %u cycles, speedup %u.%u%u\n\n", dual,
+                       speedup / 100, (speedup / 10) % 10, speedup % 10);
+
+  if (errors) {
+    neorv32_uart0_printf("[FAILED] %u wrong results\n", errors);
+    return -1;
+  }
+  neorv32_uart0_printf("[OK] all results correct\n");
+  return 0;
+}
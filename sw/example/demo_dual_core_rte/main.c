@@ -95,23 +95,28 @@ void trap_handler_ecall(void) {
  **************************************************************************/
 int app_main(void) {
 
-  // (re-)setup NEORV32 runtime-environment (RTE) for the core that is executing this code
-  neorv32_rte_setup();
+  uint32_t core_id = neorv32_smp_whoami(); // find out which core is currently executing this
+
+  // setup NEORV32 runtime-environment (RTE) for core 1; core 0 has already been set up in main()
+  // and must not do so again as this would reset the trap handler tables of ALL cores
+  if (core_id != 0) {
+    neorv32_rte_setup();
+  }
 
 
   // print message; use spinlock to have exclusive access to UART0
-  uint32_t core_id = neorv32_smp_whoami(); // find out which core is currently executing this
   spin_lock();
   neorv32_uart0_printf("[core %u] Hello world! This is core %u starting 'app_main()'.\n", core_id, core_id);
   spin_unlock();
 
 
-  // The NEORV32 Runtime Environment (RTE) provides an internal trap vector table. Each entry
-  // corresponds to a specific trap (exception or interrupt). Application software can install
-  // specific trap handler function to take care of each type of trap.
+  // The NEORV32 Runtime Environment (RTE) provides an internal trap vector table for each core.
+  // Each entry corresponds to a specific trap (exception or interrupt). Application software can
+  // install specific trap handler function to take care of each type of trap.
 
-  // However, there is only a single trap vector table. Hence, both cores will execute the SAME
-  // handler function if they encounter the same trap.
+  // neorv32_rte_handler_install() installs the handler for ALL cores. Hence, both cores will
+  // execute the SAME handler function if they encounter the same trap. Core-specific handlers
+  // can be installed using neorv32_rte_handler_install_hart().
 
   // setup machine timer interrupt for ALL cores
   neorv32_clint_mtimecmp_set(0); // initialize core-specific MTIMECMP
@@ -0,0 +1,256 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_sync/main.c
+ * @brief Lock contention benchmark: HWSPINLOCK, plain test-and-set spinlock and
+ * ticket lock with backoff.
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+#define NUM_ITER  1000  // lock acquisitions per core
+#define CS_WORK   32    // critical section length (loop iterations)
+#define NCS_WORK  32    // work between two acquisitions (loop iterations)
+
+/** Benchmark modes */
+enum {
+  MODE_HWSPINLOCK = 0,
+  MODE_SPINLOCK   = 1,
+  MODE_TICKET     = 2,
+  MODE_NUM        = 3,
+  MODE_END        = 0xff
+};
+
+/** Per-core results (one cache block per core) */
+typedef struct __attribute__((aligned(64))) {
+  uint32_t wait; // cycles spent acquiring the lock
+  uint32_t hold; // cycles spent in the critical section
+} result_t;
+
+/** Benchmark command (written by core 0 before a barrier) */
+typedef struct __attribute__((aligned(64))) {
+  uint32_t mode;      // lock type
+  uint32_t contended; // core 1 participates
+} command_t;
+
+/** Data protected by the locks */
+typedef struct __attribute__((aligned(64))) {
+  uint32_t counter;
+} shared_t;
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[2048]; // stack memory for core1
+neorv32_sync_barrier_t barrier;
+neorv32_sync_ticket_t ticket;
+volatile uint32_t __attribute__ ((aligned (64))) spinlock[16]; // plain spinlock (own cache block)
+command_t command;
+shared_t shared;
+result_t result[2];
+
+static const char *mode_name[MODE_NUM] = {"HWSPINLOCK", "spinlock  ", "ticket    "};
+
+
+/**********************************************************************//**
+ * Busy wait.
+ *
+ * @param[in] n Number of iterations.
+ **************************************************************************/
+void work(uint32_t n) {
+
+  while (n--) {
+    asm volatile ("nop");
+  }
+}
+
+
+/**********************************************************************//**
+ * Acquire lock.
+ *
+ * @param[in] mode Lock type.
+ **************************************************************************/
+void lock(uint32_t mode) {
+
+  if (mode == MODE_HWSPINLOCK) {
+    neorv32_hwspinlock_acquire_blocking(0); // polls the lock via the bus
+    asm volatile ("fence");
+  }
+  else if (mode == MODE_SPINLOCK) {
+    while (__sync_lock_test_and_set(&spinlock[0], 1)); // -> amoswap.w, no backoff
+    asm volatile ("fence");
+  }
+  else {
+    neorv32_sync_ticket_acquire(&ticket);
+  }
+}
+
+
+/**********************************************************************//**
+ * Release lock.
+ *
+ * @param[in] mode Lock type.
+ **************************************************************************/
+void unlock(uint32_t mode) {
+
+  if (mode == MODE_HWSPINLOCK) {
+    asm volatile ("fence");
+    neorv32_hwspinlock_release(0);
+  }
+  else if (mode == MODE_SPINLOCK) {
+    asm volatile ("fence");
+    __sync_lock_release(&spinlock[0]); // -> amoswap.w
+  }
+  else {
+    neorv32_sync_ticket_release(&ticket);
+  }
+}
+
+
+/**********************************************************************//**
+ * Benchmark loop executed by both cores: repeatedly acquire the lock, update the
+ * shared data and release the lock.
+ *
+ * @param[in] core Core ID.
+ * @return 0 if the benchmark has been executed, -1 if finished.
+ **************************************************************************/
+int bench(uint32_t core) {
+
+  uint32_t i, mode, t0, t1, t2, wait = 0, hold = 0;
+
+  neorv32_sync_barrier_wait(&barrier); // command is valid now
+  mode = command.mode;
+  if (mode == MODE_END) {
+    return -1;
+  }
+
+  if ((core == 0) || command.contended) {
+    for (i=0; i<NUM_ITER; i++) {
+      t0 = neorv32_cpu_csr_read(CSR_MCYCLE);
+      lock(mode);
+      t1 = neorv32_cpu_csr_read(CSR_MCYCLE);
+      shared.counter++;
+      work(CS_WORK);
+      t2 = neorv32_cpu_csr_read(CSR_MCYCLE);
+      unlock(mode);
+      wait += t1 - t0;
+      hold += t2 - t1;
+      work(NCS_WORK);
+    }
+  }
+  result[core].wait = wait;
+  result[core].hold = hold;
+
+  neorv32_sync_barrier_wait(&barrier); // results are valid now
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Main function for core 1.
+ *
+ * @return Irrelevant.
+ **************************************************************************/
+int core1_entry(void) {
+
+  neorv32_rte_setup();
+  while (bench(1) == 0);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Synchronization library demo.
+ *
+ * @note This program requires the dual-core configuration, the A ISA extension,
+ * the CLINT, UART0 and the Zicntr ISA extension. The HWSPINLOCK benchmark is
+ * skipped if the HWSPINLOCK module is not implemented.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  uint32_t mode, alone, expected;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Lock Contention Benchmark >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1<<CSR_MXISA_ZAAMO)) == 0) { // atomic memory operations available?
+    neorv32_uart0_printf("[ERROR] 'A'/'Zaamo' ISA extension not available!\n");
+    return -1;
+  }
+#ifndef __riscv_atomic
+  #warning "Application has to be compiled with RISC-V 'A' ISA extension!"
+  neorv32_uart0_printf("[ERROR] Application has to be compiled with 'A' ISA extension!\n");
+  return -1;
+#endif
+
+  // initialize synchronization objects before core1 is launched
+  neorv32_sync_barrier_init(&barrier, 2);
+  neorv32_sync_ticket_init(&ticket);
+  if (neorv32_hwspinlock_available()) {
+    neorv32_hwspinlock_clear();
+  }
+
+  // launch secondary CPU core
+  int smp_launch_rc = neorv32_smp_launch(core1_entry, (uint8_t*)core1_stack, sizeof(core1_stack));
+  if (smp_launch_rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", smp_launch_rc);
+    return -1;
+  }
+
+  neorv32_uart0_printf("%u acquisitions per core, all values in CPU cycles per acquisition\n", NUM_ITER);
+  neorv32_uart0_printf("lock       | hold (alone) | hold (contended) | wait core0 | wait core1\n");
+  for (mode=0; mode<MODE_NUM; mode++) {
+    if ((mode == MODE_HWSPINLOCK) && (neorv32_hwspinlock_available() == 0)) {
+      continue;
+    }
+
+    // uncontended reference (core 1 does not acquire the lock)
+    command.mode = mode;
+    command.contended = 0;
+    shared.counter = 0;
+    bench(0);
+    alone = result[0].hold / NUM_ITER;
+
+    // both cores compete for the lock; the longer hold time is caused by the bus
+    // traffic of the spinning core
+    command.contended = 1;
+    bench(0);
+    expected = 3 * NUM_ITER;
+
+    neorv32_uart0_printf("%s | %u | %u | %u | %u", mode_name[mode], alone,
+                         (result[0].hold + result[1].hold) / (2 * NUM_ITER),
+                         result[0].wait / NUM_ITER, result[1].wait / NUM_ITER);
+    if (shared.counter != expected) {
+      neorv32_uart0_printf(" [FAILED: counter %u, expected %u]", shared.counter, expected);
+    }
+    neorv32_uart0_printf("\n");
+  }
+
+  command.mode = MODE_END;
+  neorv32_sync_barrier_wait(&barrier);
+  neorv32_uart0_printf("\nDone.\n");
+  return 0;
+}
@@ -0,0 +1,173 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**********************************************************************//**
+ * @file demo_dual_core_wstask/main.c
+ * @brief Work-stealing task runtime demo: irregular workload with different grain sizes.
+ **************************************************************************/
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+#define NUM_ITEMS 1024  // number of work items
+#define MAX_COST  4096  // maximum cost of a work item (loop iterations)
+
+/** Global variables */
+volatile uint8_t __attribute__ ((aligned (16))) core1_stack[4096]; // stack memory for core1
+uint16_t cost[NUM_ITEMS];
+uint32_t __attribute__ ((aligned (64))) result[NUM_ITEMS];
+
+/** Range of work items (divide-and-conquer task argument) */
+typedef struct {
+  uint32_t begin, end, grain;
+} range_t;
+
+
+/**********************************************************************//**
+ * Process one work item with irregular cost.
+ *
+ * @param[in] i Work item index.
+ * @return Item result.
+ **************************************************************************/
+uint32_t work(uint32_t i) {
+
+  uint32_t n, x = i;
+  for (n=0; n<cost[i]; n++) {
+    x = (x * 1103515245u) + 12345u;
+  }
+  return x;
+}
+
+
+/**********************************************************************//**
+ * Task: process a range of work items; ranges larger than the grain size are split
+ * into two sub-tasks.
+ *
+ * @param[in] arg Range (range_t).
+ **************************************************************************/
+void process(void *arg) {
+
+  range_t *r = (range_t*)arg;
+  uint32_t i;
+
+  if ((r->end - r->begin) <= r->grain) {
+    for (i=r->begin; i<r->end; i++) {
+      result[i] = work(i);
+    }
+    return;
+  }
+
+  uint32_t mid = r->begin + (r->end - r->begin) / 2;
+  range_t left = {r->begin, mid, r->grain}, right = {mid, r->end, r->grain};
+  neorv32_wstask_group_t group;
+  neorv32_wstask_t task;
+
+  neorv32_wstask_group_init(&group);
+  neorv32_wstask_spawn(&group, &task, process, &right);
+  process(&left);
+  neorv32_wstask_sync(&group);
+}
+
+
+/**********************************************************************//**
+ * Work-stealing demo.
+ *
+ * @note This program requires the dual-core configuration, the A ISA extension,
+ * the CLINT, UART0 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  uint32_t i, lfsr = 0xace1u, grain, single, dual, check, speedup;
+  uint64_t t;
+  neorv32_wstask_stats_t stats[2];
+  range_t all;
+
+  // setup NEORV32 runtime-environment (RTE) for _this_ core (core0)
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) { // UART0 available?
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 SMP Work-Stealing Task Runtime >>\n\n");
+
+  // check hardware/software configuration
+  if (neorv32_sysinfo_get_numcores() < 2) { // two cores available?
+    neorv32_uart0_printf("[ERROR] dual-core option not enabled!\n");
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) { // CLINT available?
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+
+  // irregular item costs: mostly cheap, some very expensive
+  for (i=0; i<NUM_ITEMS; i++) {
+    lfsr ^= lfsr << 7; lfsr ^= lfsr >> 9; lfsr ^= lfsr << 8;
+    cost[i] = (lfsr & 7) ? (lfsr & 63) : (lfsr & (MAX_COST - 1));
+  }
+
+  // single-core reference
+  t = neorv32_cpu_get_cycle();
+  for (i=0; i<NUM_ITEMS; i++) {
+    result[i] = work(i);
+  }
+  single = (uint32_t)(neorv32_cpu_get_cycle() - t);
+  check = 0;
+  for (i=0; i<NUM_ITEMS; i++) {
+    check += result[i];
+  }
+  neorv32_uart0_printf("single core: %u cycles (checksum 0x%x)\n\n", single, check);
+
+  // launch work-stealing worker on core 1
+  neorv32_wstask_setup();
+  int rc = neorv32_wstask_start((uint8_t*)core1_stack, sizeof(core1_stack));
+  if (rc) {
+    neorv32_uart0_printf("[ERROR] Launching core1 failed (%d)!\n", rc);
+    return -1;
+  }
+
+  // grain >= 16 items: tasks of different cores never write to the same (64-byte) cache block of result[]
+  for (grain = NUM_ITEMS/2; grain >= 16; grain /= 2) {
+    for (i=0; i<NUM_ITEMS; i++) {
+      result[i] = 0;
+    }
+    asm volatile ("fence");
+    neorv32_wstask_get_stats(0, &stats[0], 1);
+    neorv32_wstask_get_stats(1, &stats[1], 1);
+
+    all.begin = 0;
+    all.end = NUM_ITEMS;
+    all.grain = grain;
+    t = neorv32_cpu_get_cycle();
+    process(&all);
+    dual = (uint32_t)(neorv32_cpu_get_cycle() - t);
+
+    check = 0;
+    for (i=0; i<NUM_ITEMS; i++) {
+      check += result[i];
+    }
+    neorv32_wstask_get_stats(0, &stats[0], 0);
+    neorv32_wstask_get_stats(1, &stats[1], 0);
+
+    speedup = (uint32_t)((100ULL * single) / (dual ? dual : 1));
+    neorv32_uart0_printf("[grain %u] %u cycles, speedup %u.%u%u (checksum 0x%x)\n", grain, dual,
+                         speedup / 100, (speedup / 10) % 10, speedup % 10, check);
+    // core 0 works all the time except while waiting in sync; core 1 works while executing tasks
+    neorv32_uart0_printf("  core0: %u tasks, %u steals, utilization %u%%\n", stats[0].executed, stats[0].steals,
+                         (uint32_t)((100 * (dual - stats[0].idle)) / dual));
+    neorv32_uart0_printf("  core1: %u tasks, %u steals (%u failed), %u sleeps, utilization %u%%\n",
+                         stats[1].executed, stats[1].steals, stats[1].steal_fails, stats[1].sleeps,
+                         (uint32_t)((100 * stats[1].busy) / dual));
+  }
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_evloop/main.c
+ * @brief Event loop demo program: UART0 and GPTMR interrupts are handled by
+ * callbacks of the event loop; the core sleeps in between.
+ **************************************************************************/
+
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE 19200 // UART0 Baud rate
+
+/** Event IDs */
+enum {
+  EVENT_UART0_RX = 0,
+  EVENT_GPTMR    = 1
+};
+
+/** Global variables */
+uint32_t ticks = 0;
+
+
+/**********************************************************************//**
+ * UART0 RX callback: echo all received characters; print statistics on 's',
+ * leave the event loop on 'q'.
+ *
+ * @param[in] data FIRQ channel (not used).
+ * @param[in] arg Not used.
+ **************************************************************************/
+void uart0_rx(uint32_t data, void *arg) {
+
+  neorv32_evloop_stats_t stats;
+  char c;
+
+  (void)data;
+  (void)arg;
+
+  while (neorv32_uart0_char_received()) { // drain RX FIFO
+    c = neorv32_uart0_char_received_get();
+    if (c == 's') {
+      neorv32_evloop_get_stats(&stats, 1);
+      neorv32_uart0_printf("\n%u events, %u dropped, idle %u%%\n", stats.events, stats.dropped,
+                           (uint32_t)((100 * stats.idle) / ((stats.idle + stats.busy) | 1)));
+    }
+    else if (c == 'q') {
+      neorv32_evloop_stop();
+    }
+    else {
+      neorv32_uart0_putc(c);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * GPTMR callback: acknowledge interrupt and toggle GPIO.output(0).
+ *
+ * @param[in] data FIRQ channel (not used).
+ * @param[in] arg Not used.
+ **************************************************************************/
+void gptmr_tick(uint32_t data, void *arg) {
+
+  (void)data;
+  (void)arg;
+
+  neorv32_gptmr_irq_ack();
+  neorv32_gpio_pin_toggle(0);
+  ticks++;
+}
+
+
+/**********************************************************************//**
+ * Event loop demo.
+ *
+ * @note This program requires UART0, the GPTMR and the Zicntr ISA extension
+ * (for the idle time statistics).
+ *
+ * @return 0 after the event loop has been stopped.
+ **************************************************************************/
+int main() {
+
+  // setup NEORV32 runtime environment (for trap handling)
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, interrupt if RX FIFO not empty
+  neorv32_uart0_setup(BAUD_RATE, 1 << UART_CTRL_IRQ_RX_NEMPTY);
+
+  // check if GPTMR unit is implemented at all
+  if (neorv32_gptmr_available() == 0) {
+    neorv32_uart0_puts("ERROR! General purpose timer not implemented!\n");
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_puts("Event loop demo program.\n"
+                     "Toggles GPIO.output(0) at 1Hz and echoes UART0 input.\n"
+                     "Press 's' to print statistics, 'q' to quit.\n\n");
+
+  neorv32_gpio_port_set(0);
+
+  // setup event loop and attach interrupt sources
+  neorv32_evloop_setup();
+  neorv32_evloop_register(EVENT_UART0_RX, uart0_rx, NULL);
+  neorv32_evloop_register(EVENT_GPTMR, gptmr_tick, NULL);
+  neorv32_evloop_attach(UART0_RX_RTE_ID - RTE_TRAP_FIRQ_0, EVENT_UART0_RX);
+  neorv32_evloop_attach(GPTMR_RTE_ID - RTE_TRAP_FIRQ_0, EVENT_GPTMR);
+
+  // configure timer for 0.5s ticks with clock divisor = 8
+  neorv32_gptmr_setup(CLK_PRSC_8, neorv32_sysinfo_get_clk() / (8 * 2));
+
+  // enable machine-mode interrupts and run callbacks until 'q' has been received
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  neorv32_evloop_run();
+
+  neorv32_gptmr_disable();
+  neorv32_uart0_printf("\nEvent loop stopped after %u timer ticks.\n", ticks);
+  return 0;
+}
@@ -0,0 +1,265 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_kernel/main.c
+ * @brief Multitasking kernel demo: context switch latency benchmarks and blocking
+ * calls from a nested interrupt handler.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE   19200
+/** Number of measurements per benchmark */
+#define NUM_RUNS    1000
+/** Stack size of each task in bytes */
+#define STACK_SIZE  1024
+/**@}*/
+
+
+/**********************************************************************//**
+ * Latency statistics (CPU cycles).
+ **************************************************************************/
+typedef struct {
+  uint32_t num, min, max;
+  uint64_t sum;
+} stats_t;
+
+
+/**********************************************************************//**
+ * Global variables.
+ **************************************************************************/
+static uint32_t __attribute__((aligned(16))) stack[4][STACK_SIZE/4];
+static neorv32_kernel_task_t task_ping, task_pong, task_high, task_main;
+static neorv32_kernel_sem_t sem_ping, sem_pong, sem_irq, sem_done, sem_go, sem_never;
+static neorv32_swtimer_t irq_timer, nest_timer;
+static volatile int nest_res, nest_mie, nest_depth; // results of the nested handler check
+static volatile uint64_t stamp; // cycle counter before the switch
+static stats_t stats;
+
+
+/**********************************************************************//**
+ * Add a sample (cycles since stamp) to the statistics.
+ **************************************************************************/
+static void sample(void) {
+
+  uint32_t delta = (uint32_t)(neorv32_cpu_get_cycle() - stamp);
+
+  stats.num++;
+  stats.sum += delta;
+  if (delta < stats.min) {
+    stats.min = delta;
+  }
+  if (delta > stats.max) {
+    stats.max = delta;
+  }
+}
+
+
+/**********************************************************************//**
+ * Reset and print statistics.
+ *
+ * @param[in] name Benchmark name; NULL to reset only.
+ **************************************************************************/
+static void report(const char *name) {
+
+  if (name != NULL) {
+    neorv32_uart0_printf("%s: min %u, avg %u, max %u cycles (%u samples)\n", name,
+                         stats.min, (uint32_t)(stats.sum / (stats.num ? stats.num : 1)), stats.max, stats.num);
+  }
+  stats.num = 0;
+  stats.sum = 0;
+  stats.min = UINT32_MAX;
+  stats.max = 0;
+}
+
+
+/**********************************************************************//**
+ * Benchmark 1 (yield): two tasks of the same priority pass the CPU to each other.
+ * Benchmark 2 (semaphore): both tasks wake each other via semaphores (including the
+ * semaphore operations).
+ *
+ * @param[in] arg 0 = ping task, 1 = pong task.
+ **************************************************************************/
+static void ping_pong(void *arg) {
+
+  int i, pong = (int)arg;
+
+  for (i=0; i<NUM_RUNS; i++) {
+    if (pong || i) {
+      sample();
+    }
+    stamp = neorv32_cpu_get_cycle();
+    neorv32_kernel_yield();
+  }
+
+  // wait until the results have been printed
+  neorv32_kernel_sem_post(&sem_done);
+  neorv32_kernel_sem_wait(&sem_go, NEORV32_KERNEL_FOREVER);
+
+  for (i=0; i<NUM_RUNS; i++) {
+    if (pong) {
+      neorv32_kernel_sem_wait(&sem_pong, NEORV32_KERNEL_FOREVER);
+      sample();
+      stamp = neorv32_cpu_get_cycle();
+      neorv32_kernel_sem_post(&sem_ping);
+    }
+    else {
+      stamp = neorv32_cpu_get_cycle();
+      neorv32_kernel_sem_post(&sem_pong);
+      neorv32_kernel_sem_wait(&sem_ping, NEORV32_KERNEL_FOREVER);
+      sample();
+    }
+  }
+
+  neorv32_kernel_sem_post(&sem_done);
+}
+
+
+/**********************************************************************//**
+ * Benchmark 3 (interrupt): timer interrupt callback wakes a high-priority task.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+static void irq_callback(void *arg) {
+
+  (void)arg;
+  stamp = neorv32_cpu_get_cycle();
+  neorv32_kernel_sem_post(&sem_irq);
+}
+
+
+/**********************************************************************//**
+ * High-priority task for benchmark 3.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+static void high(void *arg) {
+
+  int i;
+  (void)arg;
+
+  for (i=0; i<NUM_RUNS; i++) {
+    neorv32_kernel_sem_wait(&sem_irq, NEORV32_KERNEL_FOREVER);
+    sample();
+  }
+  neorv32_swtimer_stop(&irq_timer);
+  neorv32_kernel_sem_post(&sem_done);
+}
+
+
+/**********************************************************************//**
+ * Check 4 (nested handler): timer interrupt callback that is executed with interrupts
+ * enabled (handler nesting) tries to wait for a semaphore that is never posted. This
+ * must not block but has to return immediately with an error.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+static void nest_callback(void *arg) {
+
+  (void)arg;
+  nest_mie   = (neorv32_cpu_csr_read(CSR_MSTATUS) >> CSR_MSTATUS_MIE) & 1;
+  nest_depth = neorv32_rte_irq_nesting();
+  nest_res   = neorv32_kernel_sem_wait(&sem_never, NEORV32_KERNEL_FOREVER);
+  neorv32_kernel_sem_post(&sem_done);
+}
+
+
+/**********************************************************************//**
+ * Main task: run the benchmarks and print the results.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+static void bench(void *arg) {
+
+  (void)arg;
+
+  // benchmark 1
+  report(NULL);
+  neorv32_kernel_task_create(&task_ping, ping_pong, (void*)0, stack[1], STACK_SIZE, 1, "ping");
+  neorv32_kernel_task_create(&task_pong, ping_pong, (void*)1, stack[2], STACK_SIZE, 1, "pong");
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  report("yield task-to-task switch        ");
+
+  // benchmark 2
+  neorv32_kernel_sem_post(&sem_go);
+  neorv32_kernel_sem_post(&sem_go);
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  report("semaphore task-to-task switch    ");
+
+  // benchmark 3
+  neorv32_kernel_task_create(&task_high, high, NULL, stack[3], STACK_SIZE, 3, "high");
+  neorv32_swtimer_start(&irq_timer, 5000, 5000);
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  report("interrupt-to-task wake-up        ");
+
+  // check 4: a higher-priority source (MEI) makes the timer interrupt handler nestable
+  neorv32_rte_irq_priority_set(0, RTE_TRAP_MEI, 1);
+  neorv32_swtimer_start(&nest_timer, 5000, 0);
+  neorv32_kernel_sem_wait(&sem_done, NEORV32_KERNEL_FOREVER);
+  neorv32_rte_irq_priority_set(0, RTE_TRAP_MEI, 0);
+  neorv32_uart0_printf("sem_wait in nested handler        : mstatus.MIE=%u, nesting=%u, %s\n",
+                       nest_mie, nest_depth, (nest_res == -1) ? "returned immediately [OK]" : "[FAILED]");
+
+  neorv32_uart0_printf("\nTotal context switches: %u\n", neorv32_kernel_get_switches());
+}
+
+
+/**********************************************************************//**
+ * Multitasking kernel demo: measure context switch latencies with neorv32_cpu_get_cycle().
+ *
+ * @note This program requires the CLINT, UART0 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant (but can be inspected by the debugger).
+ **************************************************************************/
+int main(void) {
+
+  // capture all exceptions and give debug info via UART
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<< NEORV32 Multitasking Kernel Demo >>\n\n");
+
+  // check hardware configuration
+  if (neorv32_clint_available() == 0) {
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return -1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("[ERROR] Zicntr ISA extension not available!\n");
+    return -1;
+  }
+
+  // kernel with 1ms time slices
+  neorv32_kernel_setup(neorv32_sysinfo_get_clk() / 1000);
+
+  neorv32_kernel_sem_init(&sem_ping, 0);
+  neorv32_kernel_sem_init(&sem_pong, 0);
+  neorv32_kernel_sem_init(&sem_irq, 0);
+  neorv32_kernel_sem_init(&sem_done, 0);
+  neorv32_kernel_sem_init(&sem_go, 0);
+  neorv32_kernel_sem_init(&sem_never, 0);
+  neorv32_swtimer_init(&irq_timer, irq_callback, NULL);
+  neorv32_swtimer_init(&nest_timer, nest_callback, NULL);
+
+  neorv32_kernel_task_create(&task_main, bench, NULL, stack[0], STACK_SIZE, 2, "main");
+
+  // this context becomes the idle task
+  neorv32_kernel_start();
+
+  return 0;
+}
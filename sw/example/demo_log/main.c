@@ -0,0 +1,101 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_log/main.c
+ * @author Stephan Nolting
+ * @brief Deferred binary logging demo: compare the cost of NEORV32_LOG and printf.
+ * Decode the UART1 output on the host using sw/log_decode and this program's ELF file.
+ **************************************************************************/
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Log ring buffer size in bytes (has to be a power of two) */
+#define LOG_BUF_SIZE 1024
+/**@}*/
+
+
+/**********************************************************************//**
+ * Log ring buffer.
+ **************************************************************************/
+uint32_t log_buf[LOG_BUF_SIZE/4];
+
+
+/**********************************************************************//**
+ * Demo program. Text output is sent via UART0, binary log data via UART1.
+ *
+ * @note This program requires UART0, UART1 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant.
+ **************************************************************************/
+int main() {
+
+  uint32_t t_log, t_printf, i;
+
+  // setup NEORV32 runtime environment
+  neorv32_rte_setup();
+
+  // setup UARTs at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart1_setup(BAUD_RATE, 0);
+
+  // check if UART0 unit is implemented at all
+  if (neorv32_uart0_available() == 0) {
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< Deferred Binary Logging Demo >>>\n\n");
+
+  // check hardware
+  if (neorv32_uart1_available() == 0) {
+    neorv32_uart0_printf("[ERROR] UART1 not available!\n");
+    return 1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("[ERROR] Zicntr ISA extension not available!\n");
+    return 1;
+  }
+
+  // setup logging system: records are sent via UART1 in the background
+  if (neorv32_log_setup(NEORV32_UART1, log_buf, LOG_BUF_SIZE)) {
+    neorv32_uart0_printf("[ERROR] Log setup failed!\n");
+    return 1;
+  }
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  NEORV32_LOG("demo_log started");
+
+  // cost of a log record vs. formatted text output
+  for (i=0; i<4; i++) {
+    t_log = neorv32_cpu_csr_read(CSR_MCYCLE);
+    NEORV32_LOG("iteration %u: value = 0x%x, delta = %d\n", i, i << 20, (int32_t)i - 2);
+    t_log = neorv32_cpu_csr_read(CSR_MCYCLE) - t_log;
+
+    while (neorv32_uart0_tx_busy()); // no pending output
+    t_printf = neorv32_cpu_csr_read(CSR_MCYCLE);
+    neorv32_uart0_printf("iteration %u: value = 0x%x, delta = %d\n", i, i << 20, (int32_t)i - 2);
+    t_printf = neorv32_cpu_csr_read(CSR_MCYCLE) - t_printf;
+
+    neorv32_uart0_printf("cycles: NEORV32_LOG = %u, printf = %u\n\n", t_log, t_printf);
+  }
+
+  NEORV32_LOG("demo_log done, dropped records: %u", neorv32_log_get_dropped());
+  neorv32_log_flush();
+
+  neorv32_uart0_printf("Program completed.\n");
+  return 0;
+}
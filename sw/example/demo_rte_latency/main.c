@@ -0,0 +1,318 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_rte_latency/main.c
+ * @brief Measure interrupt entry latency and round-trip time of the NEORV32
+ * runtime environment (RTE) using the CLINT machine software interrupt. A second
+ * benchmark raises two interrupts at once to show the effect of tail-chaining. A
+ * third benchmark measures the latency of a high-priority interrupt that is raised
+ * while a slow low-priority handler is being executed (with and without nesting).
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of interrupts per measurement */
+#define NUM_RUNS  64
+/** Execution time of the slow low-priority handler in cycles */
+#define SLOW_CYCLES 2000
+/** Delay until the high-priority interrupt is raised by the slow handler in timer ticks */
+#define SLOW_DELAY  100
+/**@}*/
+
+// Global variables
+volatile uint32_t irq_entry; // cycle counter value at handler entry
+volatile uint32_t irq_done;  // number of executed handlers
+int hpm_available;           // HPM counters 3 and 4 available
+uint64_t mti_target;         // timer interrupt trigger time
+uint32_t mti_latency;        // timer interrupt latency
+
+// Prototypes
+void msi_handler(void);
+void mti_handler(void);
+uint32_t run_benchmark(const char *name);
+void run_burst(const char *name, uint32_t single);
+void slow_msi_handler(void);
+void mti_latency_handler(void);
+void run_nesting(const char *name);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the CLINT, UART0 and the Zicntr ISA extension.
+ * The Zihpm ISA extension (with at least 2 counters) is optional.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // setup NEORV32 runtime environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 RTE Interrupt Latency Benchmark >>>\n\n");
+
+  // check hardware configuration
+  if (neorv32_clint_available() == 0) {
+    neorv32_uart0_printf("[ERROR] CLINT module not available!\n");
+    return 1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("[ERROR] Zicntr ISA extension not available!\n");
+    return 1;
+  }
+
+  // HPM counter 3: entered traps, HPM counter 4: load/store operations
+  hpm_available = 0;
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZIHPM)) && (neorv32_cpu_hpm_get_num_counters() >= 2)) {
+    neorv32_cpu_csr_write(CSR_MHPMEVENT3, 1 << HPMCNT_EVENT_TRAP);
+    neorv32_cpu_csr_write(CSR_MHPMEVENT4, (1 << HPMCNT_EVENT_LOAD) | (1 << HPMCNT_EVENT_STORE));
+    neorv32_cpu_csr_clr(CSR_MCOUNTINHIBIT, (1 << 3) | (1 << 4));
+    hpm_available = 1;
+  }
+
+  // enable software and timer interrupts
+  neorv32_clint_msi_clr(neorv32_smp_whoami());
+  neorv32_clint_mtimecmp_set(-1); // no timer interrupt yet
+  neorv32_rte_handler_install(RTE_TRAP_MTI, mti_handler);
+  neorv32_cpu_csr_set(CSR_MIE, (1 << CSR_MIE_MSIE) | (1 << CSR_MIE_MTIE));
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  neorv32_uart0_printf("Cycles from triggering the interrupt until the second-level handler starts (entry)\n"
+                       "and until the interrupted code continues (round-trip); %u runs each.\n\n", NUM_RUNS);
+
+  // regular handler: complete register context is saved
+  neorv32_rte_handler_install(RTE_TRAP_MSI, msi_handler);
+
+  uint32_t single_regular, single_fast;
+
+  // direct mode: single RTE core, trap source is decoded from mcause
+  neorv32_rte_vectored_disable();
+  run_benchmark("direct,   regular");
+
+  // vectored mode: per-cause entry stubs
+  neorv32_rte_vectored_enable();
+  single_regular = run_benchmark("vectored, regular");
+
+  // fast handler: only caller-saved registers are saved
+  neorv32_rte_handler_install_fast(RTE_TRAP_MSI, msi_handler);
+  neorv32_rte_handler_install_fast(RTE_TRAP_MTI, mti_handler);
+
+  neorv32_rte_vectored_disable();
+  run_benchmark("direct,   fast   ");
+
+  neorv32_rte_vectored_enable();
+  single_fast = run_benchmark("vectored, fast   ");
+
+  // burst: MSI and MTI are pending at the same time; the second one is tail-chained
+  neorv32_uart0_printf("\nBurst of two interrupts (MSI + MTI) compared to two individual interrupts\n"
+                       "(average round-trip cycles; traps and load/store operations per burst via HPM).\n\n");
+
+  neorv32_rte_handler_install(RTE_TRAP_MSI, msi_handler);
+  neorv32_rte_handler_install(RTE_TRAP_MTI, mti_handler);
+  run_burst("vectored, regular", single_regular);
+
+  neorv32_rte_handler_install_fast(RTE_TRAP_MSI, msi_handler);
+  neorv32_rte_handler_install_fast(RTE_TRAP_MTI, mti_handler);
+  run_burst("vectored, fast   ", single_fast);
+
+  // nesting: timer interrupt is raised while the slow software interrupt handler is being executed
+  neorv32_uart0_printf("\nLatency (timer ticks) of MTI raised during a slow (%u cycles) MSI handler.\n\n", SLOW_CYCLES);
+
+  neorv32_rte_handler_install_prio(RTE_TRAP_MSI, slow_msi_handler, 0);
+  neorv32_rte_handler_install_prio(RTE_TRAP_MTI, mti_latency_handler, 0);
+  run_nesting("MTI prio = MSI prio");
+
+  neorv32_rte_handler_install_prio(RTE_TRAP_MTI, mti_latency_handler, 1);
+  run_nesting("MTI prio > MSI prio");
+
+  neorv32_rte_handler_install_prio(RTE_TRAP_MTI, mti_latency_handler, 0); // back to default
+
+  // back to default
+  neorv32_rte_vectored_disable();
+  neorv32_cpu_csr_clr(CSR_MIE, (1 << CSR_MIE_MSIE) | (1 << CSR_MIE_MTIE));
+
+  neorv32_uart0_printf("\nProgram completed.\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Trigger the machine software interrupt several times and print timing statistics.
+ *
+ * @param[in] name Name of the current configuration.
+ *
+ * @return Average round-trip cycles.
+ **************************************************************************/
+uint32_t run_benchmark(const char *name) {
+
+  int i;
+  uint32_t start, stop, entry, total;
+  uint32_t entry_min = -1, entry_max = 0, entry_sum = 0;
+  uint32_t total_min = -1, total_max = 0, total_sum = 0;
+  int hart = (int)neorv32_smp_whoami();
+
+  for (i=0; i<NUM_RUNS; i++) {
+
+    irq_done = 0;
+    start = neorv32_cpu_csr_read(CSR_MCYCLE);
+    neorv32_clint_msi_set(hart); // fire!
+    while (irq_done == 0);
+    stop = neorv32_cpu_csr_read(CSR_MCYCLE);
+
+    entry = irq_entry - start;
+    total = stop - start;
+
+    entry_sum += entry;
+    total_sum += total;
+    if (entry < entry_min) { entry_min = entry; }
+    if (entry > entry_max) { entry_max = entry; }
+    if (total < total_min) { total_min = total; }
+    if (total > total_max) { total_max = total; }
+  }
+
+  neorv32_uart0_printf("[%s] entry: min %u, avg %u, max %u | round-trip: min %u, avg %u, max %u\n",
+                       name, entry_min, entry_sum / NUM_RUNS, entry_max,
+                       total_min, total_sum / NUM_RUNS, total_max);
+
+  return total_sum / NUM_RUNS;
+}
+
+
+/**********************************************************************//**
+ * Trigger the machine software and the machine timer interrupt at the
+ * same time several times and print timing statistics.
+ *
+ * @param[in] name Name of the current configuration.
+ * @param[in] single Average round-trip cycles of a single interrupt.
+ **************************************************************************/
+void run_burst(const char *name, uint32_t single) {
+
+  int i;
+  uint32_t start, total_sum = 0, traps_sum = 0, mem_sum = 0;
+  int hart = (int)neorv32_smp_whoami();
+
+  for (i=0; i<NUM_RUNS; i++) {
+
+    // make both interrupts pending while interrupts are globally disabled
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    irq_done = 0;
+    neorv32_clint_msi_set(hart);
+    neorv32_clint_mtimecmp_set(0);
+    if (hpm_available) {
+      neorv32_cpu_csr_write(CSR_MHPMCOUNTER3, 0);
+      neorv32_cpu_csr_write(CSR_MHPMCOUNTER4, 0);
+    }
+
+    start = neorv32_cpu_csr_read(CSR_MCYCLE);
+    neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE); // fire!
+    while (irq_done < 2);
+    total_sum += neorv32_cpu_csr_read(CSR_MCYCLE) - start;
+
+    if (hpm_available) {
+      traps_sum += neorv32_cpu_csr_read(CSR_MHPMCOUNTER3);
+      mem_sum   += neorv32_cpu_csr_read(CSR_MHPMCOUNTER4);
+    }
+  }
+
+  neorv32_uart0_printf("[%s] burst: %u, 2x single: %u, saved: %i", name,
+                       total_sum / NUM_RUNS, 2 * single, (int)(2 * single) - (int)(total_sum / NUM_RUNS));
+  if (hpm_available) {
+    neorv32_uart0_printf(" | traps: %u, load/store: %u", traps_sum / NUM_RUNS, mem_sum / NUM_RUNS);
+  }
+  neorv32_uart0_printf("\n");
+}
+
+
+/**********************************************************************//**
+ * Trigger the slow machine software interrupt handler several times and
+ * print latency statistics of the timer interrupt raised by this handler.
+ *
+ * @param[in] name Name of the current configuration.
+ **************************************************************************/
+void run_nesting(const char *name) {
+
+  int i;
+  uint32_t lat_max = 0, lat_sum = 0;
+  int hart = (int)neorv32_smp_whoami();
+
+  for (i=0; i<NUM_RUNS; i++) {
+
+    irq_done = 0;
+    neorv32_clint_msi_set(hart); // fire!
+    while (irq_done < 2);
+
+    lat_sum += mti_latency;
+    if (mti_latency > lat_max) { lat_max = mti_latency; }
+  }
+
+  neorv32_uart0_printf("[%s] MTI latency: avg %u, max %u\n", name, lat_sum / NUM_RUNS, lat_max);
+}
+
+
+/**********************************************************************//**
+ * Slow machine software interrupt handler: raise the timer interrupt
+ * and keep busy for a while.
+ **************************************************************************/
+void slow_msi_handler(void) {
+
+  mti_target = neorv32_clint_time_get() + SLOW_DELAY;
+  neorv32_clint_mtimecmp_set(mti_target);
+
+  uint32_t start = neorv32_cpu_csr_read(CSR_MCYCLE);
+  while ((neorv32_cpu_csr_read(CSR_MCYCLE) - start) < SLOW_CYCLES);
+
+  neorv32_clint_msi_clr(neorv32_smp_whoami());
+  irq_done++;
+}
+
+
+/**********************************************************************//**
+ * Machine timer interrupt handler: measure latency.
+ **************************************************************************/
+void mti_latency_handler(void) {
+
+  mti_latency = (uint32_t)(neorv32_clint_time_get() - mti_target);
+  neorv32_clint_mtimecmp_set(-1);
+  irq_done++;
+}
+
+
+/**********************************************************************//**
+ * Machine software interrupt handler.
+ **************************************************************************/
+void msi_handler(void) {
+
+  irq_entry = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_clint_msi_clr(neorv32_smp_whoami());
+  irq_done++;
+}
+
+
+/**********************************************************************//**
+ * Machine timer interrupt handler.
+ **************************************************************************/
+void mti_handler(void) {
+
+  neorv32_clint_mtimecmp_set(-1);
+  irq_done++;
+}
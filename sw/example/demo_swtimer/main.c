@@ -0,0 +1,129 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_swtimer/main.c
+ * @brief Software timer (timing wheel) demo program.
+ **************************************************************************/
+
+#include <neorv32.h>
+
+/** User configuration */
+#define BAUD_RATE  19200 // UART0 Baud rate
+#define NUM_TIMERS 100   // number of concurrent one-shot timers
+
+/** Global variables */
+neorv32_swtimer_t blink_timer, report_timer, oneshot_timer[NUM_TIMERS];
+volatile uint32_t oneshot_count = 0;
+volatile uint32_t oneshot_late_max = 0;
+uint64_t oneshot_deadline[NUM_TIMERS];
+
+
+/**********************************************************************//**
+ * Periodic timer callback: toggle GPIO.output(0).
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void blink(void *arg) {
+
+  (void)arg;
+  neorv32_gpio_pin_toggle(0);
+}
+
+
+/**********************************************************************//**
+ * One-shot timer callback: check latency and restart with a random timeout.
+ *
+ * @param[in] arg Timer index.
+ **************************************************************************/
+void oneshot(void *arg) {
+
+  uint32_t idx = (uint32_t)arg;
+  uint64_t now = neorv32_clint_time_get();
+  uint32_t late = (uint32_t)(now - oneshot_deadline[idx]);
+  static uint32_t lfsr = 0xabcdef01u;
+
+  if (late > oneshot_late_max) {
+    oneshot_late_max = late;
+  }
+  oneshot_count++;
+
+  lfsr ^= lfsr << 13; lfsr ^= lfsr >> 17; lfsr ^= lfsr << 5;
+  oneshot_deadline[idx] = now + 1000 + (lfsr & 0xfffff); // up to ~1M cycles
+  neorv32_swtimer_start_at(&oneshot_timer[idx], oneshot_deadline[idx], 0);
+}
+
+
+/**********************************************************************//**
+ * Periodic timer callback: print statistics.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void report(void *arg) {
+
+  (void)arg;
+  neorv32_uart0_printf("%u one-shot timers expired, maximum latency %u cycles\n",
+                       oneshot_count, oneshot_late_max);
+}
+
+
+/**********************************************************************//**
+ * Software timer demo: a periodic LED blink timer, a periodic report timer and
+ * NUM_TIMERS one-shot timers with random timeouts, all multiplexed onto MTIMECMP.
+ *
+ * @note This program requires the CLINT, UART0 and GPIO.
+ *
+ * @return Should not return.
+ **************************************************************************/
+int main() {
+
+  uint32_t i, clk;
+
+  // capture all exceptions and give debug info via UART
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if CLINT unit is implemented at all
+  if (neorv32_clint_available() == 0) {
+    neorv32_uart0_puts("[ERROR] CLINT not implemented!\n");
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_puts("Software timer demo program.\n"
+                     "Toggles GPIO.output(0) at 1Hz and prints statistics every 5s.\n\n");
+
+  // setup software timer service for this core
+  neorv32_swtimer_setup();
+
+  clk = neorv32_sysinfo_get_clk();
+
+  neorv32_swtimer_init(&blink_timer, blink, NULL);
+  neorv32_swtimer_start(&blink_timer, clk / 2, clk / 2);
+
+  neorv32_swtimer_init(&report_timer, report, NULL);
+  neorv32_swtimer_start(&report_timer, 5 * (uint64_t)clk, 5 * (uint64_t)clk);
+
+  for (i=0; i<NUM_TIMERS; i++) {
+    neorv32_swtimer_init(&oneshot_timer[i], oneshot, (void*)i);
+    oneshot_deadline[i] = neorv32_clint_time_get() + 10000 * (i + 1);
+    neorv32_swtimer_start_at(&oneshot_timer[i], oneshot_deadline[i], 0);
+  }
+
+  // enable interrupts globally; all work is done by the timer callbacks
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  while (1) {
+    neorv32_cpu_sleep();
+  }
+
+  return 0;
+}
@@ -0,0 +1,233 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_tlsf/main.c
+ * @author Stephan Nolting
+ * @brief Allocation latency benchmark: newlib's malloc/free vs. the TLSF allocator.
+ **************************************************************************/
+#include <neorv32.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE  19200
+/** Number of allocation slots */
+#define NUM_SLOTS  32
+/** Number of alloc/free operations */
+#define NUM_OPS    4000
+/** TLSF pool size in bytes (same as heap size, see makefile) */
+#define POOL_SIZE  (8*1024)
+/** Number of histogram buckets (log2 of cycles) */
+#define NUM_BUCKETS 12
+/**@}*/
+
+
+/**********************************************************************//**
+ * Latency statistics.
+ **************************************************************************/
+typedef struct {
+  uint32_t num, fail, min, max;
+  uint64_t sum;
+  uint32_t hist[NUM_BUCKETS]; // bucket i: cycles < 2^(i+4) (last bucket: all others)
+} stats_t;
+
+
+/**********************************************************************//**
+ * Global variables.
+ **************************************************************************/
+static uint8_t __attribute__((aligned(8))) tlsf_pool[POOL_SIZE];
+static neorv32_tlsf_t tlsf;
+static void *slot[NUM_SLOTS];
+static uint32_t lfsr;
+
+
+/**********************************************************************//**
+ * Pseudo-random number generator (32-bit xorshift).
+ *
+ * @return Random number.
+ **************************************************************************/
+static uint32_t get_rnd(void) {
+
+  lfsr ^= lfsr << 13;
+  lfsr ^= lfsr >> 17;
+  lfsr ^= lfsr << 5;
+  return lfsr;
+}
+
+
+/**********************************************************************//**
+ * Add sample to statistics.
+ *
+ * @param[in,out] s Statistics.
+ * @param[in] cycles Latency in clock cycles.
+ **************************************************************************/
+static void stats_add(stats_t *s, uint32_t cycles) {
+
+  int i = 0;
+
+  if ((s->num == 0) || (cycles < s->min)) {
+    s->min = cycles;
+  }
+  if (cycles > s->max) {
+    s->max = cycles;
+  }
+  s->num++;
+  s->sum += cycles;
+  while ((i < (NUM_BUCKETS - 1)) && (cycles >= (16u << i))) {
+    i++;
+  }
+  s->hist[i]++;
+}
+
+
+/**********************************************************************//**
+ * Print statistics.
+ *
+ * @param[in] name Operation name.
+ * @param[in] s Statistics.
+ **************************************************************************/
+static void stats_print(const char *name, stats_t *s) {
+
+  int i;
+
+  neorv32_uart0_printf("%s: %u ops, %u failed, min %u, avg %u, max %u cycles\n", name, s->num, s->fail,
+                       s->min, (uint32_t)(s->sum / (s->num ? s->num : 1)), s->max);
+  for (i=0; i<NUM_BUCKETS; i++) {
+    if (s->hist[i]) {
+      if (i < (NUM_BUCKETS - 1)) {
+        neorv32_uart0_printf("  < %u cycles: %u\n", 16u << i, s->hist[i]);
+      }
+      else {
+        neorv32_uart0_printf("  >= %u cycles: %u\n", 16u << (i - 1), s->hist[i]);
+      }
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Run benchmark: identical random sequence of alloc/free operations for both allocators.
+ *
+ * @param[in] use_tlsf 0: newlib malloc/free, 1: TLSF.
+ **************************************************************************/
+static void run(int use_tlsf) {
+
+  stats_t s_alloc, s_free;
+  uint32_t i, idx, size, t;
+  void *p;
+
+  memset((void*)&s_alloc, 0, sizeof(stats_t));
+  memset((void*)&s_free, 0, sizeof(stats_t));
+  memset((void*)slot, 0, sizeof(slot));
+  lfsr = 0x12345678u;
+
+  for (i=0; i<NUM_OPS; i++) {
+    idx = get_rnd() % NUM_SLOTS;
+    if (slot[idx] == NULL) {
+      size = 8 + (get_rnd() & 0xff); // mostly small objects...
+      if ((get_rnd() & 15) == 0) {
+        size <<= 2; // ...and some larger ones
+      }
+      t = neorv32_cpu_csr_read(CSR_MCYCLE);
+      p = use_tlsf ? neorv32_tlsf_malloc(&tlsf, size) : malloc(size);
+      t = neorv32_cpu_csr_read(CSR_MCYCLE) - t;
+      if (p == NULL) {
+        s_alloc.fail++;
+      }
+      else {
+        stats_add(&s_alloc, t);
+        slot[idx] = p;
+      }
+    }
+    else {
+      p = slot[idx];
+      t = neorv32_cpu_csr_read(CSR_MCYCLE);
+      if (use_tlsf) {
+        neorv32_tlsf_free(&tlsf, p);
+      }
+      else {
+        free(p);
+      }
+      t = neorv32_cpu_csr_read(CSR_MCYCLE) - t;
+      stats_add(&s_free, t);
+      slot[idx] = NULL;
+    }
+  }
+
+  // clean up
+  for (i=0; i<NUM_SLOTS; i++) {
+    if (use_tlsf) {
+      neorv32_tlsf_free(&tlsf, slot[i]);
+    }
+    else {
+      free(slot[i]);
+    }
+  }
+
+  stats_print("alloc", &s_alloc);
+  stats_print("free ", &s_free);
+}
+
+
+/**********************************************************************//**
+ * Main function.
+ *
+ * @note This program requires UART0 and the Zicntr ISA extension.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  neorv32_tlsf_stats_t tstats;
+
+  // setup NEORV32 runtime environment
+  neorv32_rte_setup();
+
+  // setup UART0 at default baud rate, no interrupts
+  if (neorv32_uart0_available() == 0) {
+    return -1;
+  }
+  neorv32_uart0_setup(BAUD_RATE, 0);
+  neorv32_uart0_printf("\n<<< TLSF Allocator Benchmark >>>\n\n");
+
+  // check hardware/software configuration
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("[ERROR] Zicntr ISA extension not available!\n");
+    return -1;
+  }
+  if (NEORV32_HEAP_SIZE == 0) {
+    neorv32_uart0_printf("[ERROR] No heap available!\n");
+    return -1;
+  }
+
+  neorv32_uart0_printf("%u random operations on %u slots, 8..263 bytes (1 in 16: 32..1052 bytes) per allocation\n\n", NUM_OPS, NUM_SLOTS);
+
+  neorv32_uart0_printf("[newlib malloc/free]\n");
+  run(0);
+
+  neorv32_uart0_printf("\n[TLSF]\n");
+  if (neorv32_tlsf_init(&tlsf, tlsf_pool, sizeof(tlsf_pool))) {
+    neorv32_uart0_printf("[ERROR] TLSF init failed!\n");
+    return -1;
+  }
+  run(1);
+
+  neorv32_tlsf_get_stats(&tlsf, &tstats);
+  neorv32_uart0_printf("\nTLSF pool: %u bytes, peak usage %u bytes, %u bytes free, largest free block %u bytes\n",
+                       tstats.total, tstats.peak, tstats.free, tstats.largest);
+
+  neorv32_uart0_printf("\nProgram completed.\n");
+  return 0;
+}
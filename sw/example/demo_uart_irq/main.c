@@ -0,0 +1,162 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+
+/**********************************************************************//**
+ * @file demo_uart_irq/main.c
+ * @author Stephan Nolting
+ * @brief Interrupt-driven (non-blocking) UART0 using software ring buffers and DMA.
+ **************************************************************************/
+
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** TX ring buffer size in bytes (has to be a power of two) */
+#define TX_BUF_SIZE 256
+/** RX ring buffer size in bytes (has to be a power of two) */
+#define RX_BUF_SIZE 64
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Ring buffers
+ **************************************************************************/
+/**@{*/
+char tx_buf[TX_BUF_SIZE];
+char rx_buf[RX_BUF_SIZE];
+/**@}*/
+
+
+/**********************************************************************//**
+ * Test message.
+ **************************************************************************/
+const char message[] = "The quick brown fox jumps over the lazy dog. 0123456789\n";
+
+
+/**********************************************************************//**
+ * DMA transfer done flag.
+ **************************************************************************/
+volatile int dma_done;
+
+
+/**********************************************************************//**
+ * DMA interrupt handler.
+ **************************************************************************/
+void dma_firq_handler(void) {
+
+  neorv32_uart0_write_dma_done(); // restores UART TX interrupt, also clears the DMA interrupt
+  dma_done = 1;
+}
+
+
+/**********************************************************************//**
+ * Demo program: compare blocking, non-blocking and DMA-based output and echo
+ * received data (in upper case) via the ring buffers.
+ *
+ * @note This program requires UART0 and the Zicntr ISA extension.
+ *
+ * @return Irrelevant.
+ **************************************************************************/
+int main() {
+
+  uint32_t t_block, t_nonblock, loops;
+  char buf[16];
+  int i, n;
+
+  // setup NEORV32 runtime environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 unit is implemented at all
+  if (neorv32_uart0_available() == 0) {
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< Interrupt-driven UART0 Demo >>>\n\n");
+
+  // check if Zicntr ISA extension is implemented at all
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("[ERROR] Zicntr ISA extension not available!\n");
+    return 1;
+  }
+
+  // blocking output: CPU waits for the UART
+  neorv32_uart0_printf("Blocking output:\n");
+  while (neorv32_uart0_tx_busy());
+  t_block = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_uart0_puts(message);
+  t_block = neorv32_cpu_csr_read(CSR_MCYCLE) - t_block;
+  while (neorv32_uart0_tx_busy());
+
+  // setup interrupt-driven operation
+  if (neorv32_uart0_irq_setup(tx_buf, TX_BUF_SIZE, rx_buf, RX_BUF_SIZE)) {
+    neorv32_uart0_printf("[ERROR] Setup failed!\n");
+    return 1;
+  }
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  // non-blocking output: data is copied to the TX ring buffer
+  neorv32_uart0_irq_write("Non-blocking output:\n", strlen("Non-blocking output:\n"));
+  neorv32_uart0_irq_flush();
+  t_nonblock = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_uart0_irq_write(message, strlen(message));
+  t_nonblock = neorv32_cpu_csr_read(CSR_MCYCLE) - t_nonblock;
+  neorv32_uart0_irq_flush();
+
+  // results; the TX ring buffer is empty so the blocking functions can be used again
+  neorv32_uart0_printf("\nCPU cycles spent in the output call (%u bytes):\n", (uint32_t)strlen(message));
+  neorv32_uart0_printf("blocking:     %u\n", t_block);
+  neorv32_uart0_printf("non-blocking: %u\n\n", t_nonblock);
+
+  // DMA: the CPU is free while the whole buffer is transmitted
+  if (neorv32_dma_available()) {
+    neorv32_uart0_printf("DMA output:\n");
+    while (neorv32_uart0_tx_busy());
+    neorv32_rte_handler_install(DMA_RTE_ID, dma_firq_handler);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+    dma_done = 0;
+    loops = 0;
+    neorv32_uart0_write_dma(message, strlen(message));
+    while (dma_done == 0) {
+      loops++; // do something useful here
+    }
+    while (neorv32_uart0_tx_busy());
+    neorv32_cpu_csr_clr(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+    neorv32_uart0_printf("\nCPU loop iterations during DMA transfer: %u\n\n", loops);
+  }
+
+  // echo loop: received data is collected by the RX interrupt
+  neorv32_uart0_printf("Type something (echo in upper case, ESC to exit):\n");
+  while (1) {
+    n = neorv32_uart0_irq_read(buf, sizeof(buf));
+    for (i = 0; i < n; i++) {
+      if (buf[i] == 27) { // ESC
+        neorv32_uart0_irq_flush();
+        neorv32_uart0_printf("\nProgram completed.\n");
+        return 0;
+      }
+      if ((buf[i] >= 'a') && (buf[i] <= 'z')) {
+        buf[i] -= 'a' - 'A';
+      }
+    }
+    while (neorv32_uart0_irq_tx_free() < n); // wait for enough space
+    neorv32_uart0_irq_write(buf, n);
+  }
+
+  return 0;
+}
@@ -453,7 +453,8 @@ int main() {
   if ((NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_XBUS)) && (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_IS_SIM))) {
     cnt_test++;
 
-    // clear scratch CSR
+    // clear scratch CSR (used by the RTE, restore afterwards)
+    tmp_b = neorv32_cpu_csr_read(CSR_MSCRATCH);
     neorv32_cpu_csr_write(CSR_MSCRATCH, 0);
 
     // setup test program in external memory
@@ -465,8 +466,11 @@ int main() {
     tmp_a = (uint32_t)EXT_MEM_BASE; // call the dummy sub program
     asm volatile ("jalr ra, %[input_i]" :  : [input_i] "r" (tmp_a));
 
+    tmp_a = neorv32_cpu_csr_read(CSR_MSCRATCH);
+    neorv32_cpu_csr_write(CSR_MSCRATCH, tmp_b);
+
     if ((neorv32_cpu_csr_read(CSR_MCAUSE) == mcause_never_c) && // make sure there was no exception
-        (neorv32_cpu_csr_read(CSR_MSCRATCH) == 15)) { // make sure the program was executed in the right way
+        (tmp_a == 15)) { // make sure the program was executed in the right way
       test_ok();
     }
     else {
@@ -1518,6 +1522,79 @@ int main() {
   }
 
 
+  // ----------------------------------------------------------
+  // DMA transfer paced by peripheral request (UART1.TX) + CRC
+  // ----------------------------------------------------------
+  neorv32_cpu_csr_write(CSR_MCAUSE, mcause_never_c);
+  PRINT_STANDARD("[%i] DMA paced ", cnt_test);
+
+  if ((NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_IO_DMA)) &&
+      (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_IO_UART1))) {
+    cnt_test++;
+
+    // backup current UART1 configuration; TX interrupt request is low
+    tmp_a = NEORV32_UART1->CTRL;
+    NEORV32_UART1->CTRL &= ~((uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF));
+
+    // enable DMA paced by the UART1 TX interrupt request, no interrupts
+    neorv32_dma_enable();
+    neorv32_dma_request_enable(UART1_TX_FIRQ_ENABLE - CSR_MIE_FIRQ0E);
+    neorv32_cpu_csr_write(CSR_MIE, 0);
+
+    // setup source data
+    dma_src = 0x7788ee11;
+
+    // flush/reload d-cache
+    asm volatile ("fence");
+
+    // setup CRC unit
+    neorv32_crc_setup(CRC_MODE32, 0x04C11DB7, 0xFFFFFFFF);
+
+    // configure and trigger DMA transfer
+    neorv32_dma_desc_t dma_desc;
+    dma_desc.src = (uint32_t)(&dma_src);
+    dma_desc.dst = (uint32_t)(&NEORV32_CRC->DATA);
+    dma_desc.num = 4;
+    dma_desc.cmd = DMA_CMD_B2UW | DMA_CMD_SRC_INC | DMA_CMD_DST_CONST | DMA_CMD_ENDIAN;
+    neorv32_dma_transfer(&dma_desc);
+
+    // transfer has to wait for the request
+    for (tmp_b=0; tmp_b<16; tmp_b++) {
+      asm volatile ("nop");
+    }
+    tmp_b = neorv32_dma_status();
+
+    // raise request: UART1 TX FIFO is not half-full
+    NEORV32_UART1->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF);
+
+    // wait for completion (with timeout)
+    int timeout = 1000;
+    while ((neorv32_dma_status() == DMA_STATUS_BUSY) && (timeout > 0)) {
+      timeout--;
+    }
+
+    // flush/reload d-cache
+    asm volatile ("fence");
+
+    if ((tmp_b == DMA_STATUS_BUSY) && // waiting for request
+        (neorv32_dma_status() == DMA_STATUS_DONE) && // DMA transfer completed without errors
+        (neorv32_crc_get() == 0x31DC476E)) { // correct CRC sum
+      test_ok();
+    }
+    else {
+      test_fail();
+    }
+
+    // disable DMA, restore UART1 configuration
+    neorv32_dma_request_disable();
+    neorv32_dma_disable();
+    NEORV32_UART1->CTRL = tmp_a;
+  }
+  else {
+    PRINT_STANDARD("[n.a.]\n");
+  }
+
+
   // ----------------------------------------------------------
   // Fast interrupt channel 11 (SDI)
   // ----------------------------------------------------------
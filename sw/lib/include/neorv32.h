@@ -181,11 +181,17 @@ extern char __heap_start[];    /**< heap start address */
 extern char __heap_end[];      /**< heap last address */
 extern char __crt0_max_heap[]; /**< heap size in bytes */
 extern char __crt0_entry[];    /**< crt0 entry point */
+extern char __isr_stack_start[];     /**< ISR stacks start address */
+extern char __isr_stack_end[];       /**< ISR stacks end address */
+extern char __crt0_isr_stack_size[]; /**< ISR stack size in bytes (per core) */
 // aliases
-#define NEORV32_HEAP_BEGIN ((uint32_t)&__heap_start[0])
-#define NEORV32_HEAP_END   ((uint32_t)&__heap_end[0])
-#define NEORV32_HEAP_SIZE  ((uint32_t)&__crt0_max_heap[0])
-#define NEORV32_CRT0_ENTRY ((uint32_t)&__crt0_entry[0])
+#define NEORV32_HEAP_BEGIN      ((uint32_t)&__heap_start[0])
+#define NEORV32_HEAP_END        ((uint32_t)&__heap_end[0])
+#define NEORV32_HEAP_SIZE       ((uint32_t)&__crt0_max_heap[0])
+#define NEORV32_CRT0_ENTRY      ((uint32_t)&__crt0_entry[0])
+#define NEORV32_ISR_STACK_BEGIN ((uint32_t)&__isr_stack_start[0])
+#define NEORV32_ISR_STACK_END   ((uint32_t)&__isr_stack_end[0])
+#define NEORV32_ISR_STACK_SIZE  ((uint32_t)&__crt0_isr_stack_size[0])
 /**@}*/
 
 
@@ -239,6 +245,7 @@ typedef union {
 
 // helper functions
 #include "neorv32_aux.h"
+#include "neorv32_fmt.h"
 
 // CPU core
 #include "neorv32_cpu.h"
@@ -270,6 +277,41 @@ typedef union {
 #include "neorv32_uart.h"
 #include "neorv32_wdt.h"
 
+// logging (uses UART)
+#include "neorv32_log.h"
+
+// newlib system calls
+#include "neorv32_newlib.h"
+
+// memory allocators
+#include "neorv32_tlsf.h"
+#include "neorv32_arena.h"
+#include "neorv32_pool.h"
+
+// software timers (uses CLINT)
+#include "neorv32_swtimer.h"
+
+// multitasking kernel (uses RTE and software timers)
+#include "neorv32_kernel.h"
+
+// event loop (uses RTE)
+#include "neorv32_evloop.h"
+
+// work-stealing task runtime (uses SMP)
+#include "neorv32_wstask.h"
+
+// zero-copy message queue (uses SMP)
+#include "neorv32_msgq.h"
+
+// inter-core remote procedure calls (uses SMP and RTE)
+#include "neorv32_rpc.h"
+
+// synchronization primitives (uses HWSPINLOCK)
+#include "neorv32_sync.h"
+
+// sleeping inter-core mutex (uses HWSPINLOCK and CLINT)
+#include "neorv32_mutex.h"
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,50 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_arena.h
+ * @brief Per-hart memory arenas (SMP) header file.
+ *
+ * @note Each core allocates from its own TLSF pool without any locking. Memory that is
+ * released by another core is put on a lock-free list of the owning arena and is
+ * returned to the pool by the owner during its next allocation.
+ */
+
+#ifndef NEORV32_ARENA_H
+#define NEORV32_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/**********************************************************************//**
+ * @name Arena configuration
+ **************************************************************************/
+/**@{*/
+/** Maximum number of arenas (one per core) */
+#define NEORV32_ARENA_NUM 2
+/** HWSPINLOCK lock that guards the cross-core free lists if the A ISA extension is not available */
+#ifndef NEORV32_ARENA_HWSPINLOCK
+#define NEORV32_ARENA_HWSPINLOCK 30
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int   neorv32_arena_setup(int hart, void *mem, size_t size);
+int   neorv32_arena_setup_heap(void);
+void *neorv32_arena_malloc(size_t size);
+void  neorv32_arena_free(void *ptr);
+int   neorv32_arena_get_stats(int hart, neorv32_tlsf_stats_t *stats);
+/**@}*/
+
+
+#endif // NEORV32_ARENA_H
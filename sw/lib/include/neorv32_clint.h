@@ -47,6 +47,12 @@ void     neorv32_clint_mtimecmp_set(uint64_t timecmp);
 uint64_t neorv32_clint_mtimecmp_get(void);
 void     neorv32_clint_unixtime_set(uint64_t unixtime);
 uint64_t neorv32_clint_unixtime_get(void);
+uint64_t neorv32_clint_ticks2ns(uint64_t ticks);
+uint64_t neorv32_clint_ns2ticks(uint64_t ns);
+uint64_t neorv32_clint_time_get_ns(void);
+uint64_t neorv32_clint_ns2sec(uint64_t ns, uint32_t *nsec);
+void     neorv32_clint_sleep_until(uint64_t time);
+void     neorv32_clint_delay_us(uint32_t time_us);
 /**@}*/
 
 
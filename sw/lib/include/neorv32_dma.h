@@ -36,6 +36,9 @@ typedef volatile struct __attribute__((packed,aligned(4))) {
 enum NEORV32_DMA_CTRL_enum {
   DMA_CTRL_EN           =  0, /**< DMA control register(0) (r/w): DMA enable */
   DMA_CTRL_START        =  1, /**< DMA control register(1) (-/s): Start configured DMA transfer */
+  DMA_CTRL_REQ_EN       =  2, /**< DMA control register(2) (r/w): Wait for peripheral request before each write */
+  DMA_CTRL_REQ_SEL_LSB  =  3, /**< DMA control register(3) (r/w): Peripheral request select (FIRQ channel), LSB */
+  DMA_CTRL_REQ_SEL_MSB  =  6, /**< DMA control register(6) (r/w): Peripheral request select (FIRQ channel), MSB */
 
   DMA_CTRL_ERROR_RD     = 28, /**< DMA control register(28) (r/-): Error during read access; SRC_BASE shows the faulting address */
   DMA_CTRL_ERROR_WR     = 29, /**< DMA control register(29) (r/-): Error during write access; DST_BASE shows the faulting address */
@@ -106,6 +109,8 @@ typedef struct __attribute__((packed,aligned(4))) {
 int  neorv32_dma_available(void);
 void neorv32_dma_enable(void);
 void neorv32_dma_disable(void);
+void neorv32_dma_request_enable(int channel);
+void neorv32_dma_request_disable(void);
 void neorv32_dma_transfer(neorv32_dma_desc_t *desc);
 int  neorv32_dma_status(void);
 /**@}*/
@@ -0,0 +1,76 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_evloop.h
+ * @brief Cooperative event loop (reactor) header file.
+ *
+ * @note Interrupt handlers post events into a lock-free queue; the application's callbacks
+ * are executed one after another by the event loop in thread mode. The core sleeps (WFI)
+ * while there are no events. Each core has its own event loop. The event loop does not
+ * require the multitasking kernel.
+ */
+
+#ifndef NEORV32_EVLOOP_H
+#define NEORV32_EVLOOP_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Event loop configuration
+ **************************************************************************/
+/**@{*/
+/** Number of event queue entries per core (has to be a power of two) */
+#ifndef NEORV32_EVLOOP_QUEUE_SIZE
+#define NEORV32_EVLOOP_QUEUE_SIZE 32
+#endif
+/** Number of event IDs (callbacks) per core */
+#ifndef NEORV32_EVLOOP_NUM_IDS
+#define NEORV32_EVLOOP_NUM_IDS 32
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * Event callback.
+ *
+ * @param[in] data Event data (FIRQ channel for attached interrupt sources).
+ * @param[in] arg User argument of the callback.
+ **************************************************************************/
+typedef void (*neorv32_evloop_callback_t)(uint32_t data, void *arg);
+
+
+/**********************************************************************//**
+ * Event loop statistics.
+ **************************************************************************/
+typedef struct {
+  uint64_t idle;     /**< CPU cycles spent sleeping */
+  uint64_t busy;     /**< CPU cycles spent running (since setup or last reset) */
+  uint32_t events;   /**< number of dispatched events */
+  uint32_t dropped;  /**< number of events dropped because the queue was full */
+} neorv32_evloop_stats_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int  neorv32_evloop_setup(void);
+int  neorv32_evloop_register(int id, neorv32_evloop_callback_t callback, void *arg);
+int  neorv32_evloop_post(int id, uint32_t data);
+int  neorv32_evloop_attach(int firq, int id);
+int  neorv32_evloop_detach(int firq);
+int  neorv32_evloop_poll(void);
+void neorv32_evloop_run(void);
+void neorv32_evloop_stop(void);
+void neorv32_evloop_get_stats(neorv32_evloop_stats_t *stats, int reset);
+/**@}*/
+
+
+#endif // NEORV32_EVLOOP_H
@@ -0,0 +1,58 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_fmt.h
+ * @brief Lightweight string formatting engine header file.
+ */
+
+#ifndef NEORV32_FMT_H
+#define NEORV32_FMT_H
+
+#include <stdint.h>
+#include <stdarg.h>
+
+
+/**********************************************************************//**
+ * Size of the local render buffer (bytes) used by #neorv32_fmt_vprintf();
+ * the sink is called once per filled buffer.
+ **************************************************************************/
+#ifndef NEORV32_FMT_BUF_SIZE
+#define NEORV32_FMT_BUF_SIZE 64
+#endif
+
+
+/**********************************************************************//**
+ * @name Formatting options
+ **************************************************************************/
+/**@{*/
+#define NEORV32_FMT_CRLF (1 << 0) /**< convert "\n" into "\r\n" */
+/**@}*/
+
+
+/**********************************************************************//**
+ * Output sink: consumes a block of rendered characters.
+ *
+ * @param[in,out] ctx Sink-specific context (e.g. UART handle).
+ * @param[in] buffer Rendered characters (not zero-terminated).
+ * @param[in] length Number of characters.
+ **************************************************************************/
+typedef void (*neorv32_fmt_sink_t)(void *ctx, const char *buffer, int length);
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int neorv32_fmt_vprintf(neorv32_fmt_sink_t sink, void *ctx, int options, const char *format, va_list args);
+int neorv32_fmt_vsnprintf(char *buffer, int size, const char *format, va_list args);
+int neorv32_fmt_snprintf(char *buffer, int size, const char *format, ...);
+/**@}*/
+
+
+#endif // NEORV32_FMT_H
@@ -0,0 +1,110 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_kernel.h
+ * @brief Lightweight preemptive multitasking kernel header file.
+ *
+ * @note Fixed-priority preemptive scheduling with round-robin time slicing among tasks of
+ * the same priority. Context switches are executed by the machine software interrupt handler
+ * via the RTE (#neorv32_rte_context_switch()); time slices and timeouts use the software
+ * timer service (#neorv32_swtimer_setup()). Each core has its own scheduler and run queue.
+ */
+
+#ifndef NEORV32_KERNEL_H
+#define NEORV32_KERNEL_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Kernel configuration
+ **************************************************************************/
+/**@{*/
+/** Number of task priorities (1..32); higher value = higher priority */
+#ifndef NEORV32_KERNEL_PRIOS
+#define NEORV32_KERNEL_PRIOS 8
+#endif
+/** Timeout value: wait forever */
+#define NEORV32_KERNEL_FOREVER UINT64_MAX
+/**@}*/
+
+
+/**********************************************************************//**
+ * Task control block.
+ **************************************************************************/
+typedef struct neorv32_kernel_task_struct {
+  uint32_t context[NEORV32_RTE_CONTEXT_WORDS];     /**< saved context (return address, x1..xn) */
+  struct neorv32_kernel_task_struct *next;         /**< next task in run queue / wait list */
+  struct neorv32_kernel_task_struct **wait;        /**< wait list the task is blocked on (NULL if none) */
+  neorv32_swtimer_t timer;                         /**< sleep / timeout timer */
+  const char *name;                                /**< task name */
+  uint32_t switches;                               /**< number of times the task has been dispatched */
+  uint8_t  prio;                                   /**< priority (0..#NEORV32_KERNEL_PRIOS-1) */
+  uint8_t  state;                                  /**< task state (#NEORV32_KERNEL_STATE_enum) */
+  uint8_t  hart;                                   /**< core the task is running on */
+  int8_t   result;                                 /**< result of the last blocking operation */
+} neorv32_kernel_task_t;
+
+
+/**********************************************************************//**
+ * Task states.
+ **************************************************************************/
+enum NEORV32_KERNEL_STATE_enum {
+  KERNEL_STATE_READY   = 0, /**< ready to run or running */
+  KERNEL_STATE_BLOCKED = 1, /**< waiting for an object or sleeping */
+  KERNEL_STATE_DONE    = 2  /**< task function has returned */
+};
+
+
+/**********************************************************************//**
+ * Counting semaphore.
+ **************************************************************************/
+typedef struct {
+  uint32_t count;                /**< current count */
+  neorv32_kernel_task_t *wait;   /**< waiting tasks (by priority) */
+} neorv32_kernel_sem_t;
+
+
+/**********************************************************************//**
+ * Message queue (items are copied).
+ **************************************************************************/
+typedef struct {
+  uint8_t *buf;                       /**< item storage (num * size bytes) */
+  uint32_t size;                      /**< item size in bytes */
+  uint32_t num;                       /**< queue capacity (items) */
+  uint32_t head;                      /**< read index */
+  uint32_t count;                     /**< number of items in the queue */
+  neorv32_kernel_task_t *wait_send;   /**< tasks waiting for free space */
+  neorv32_kernel_task_t *wait_recv;   /**< tasks waiting for data */
+} neorv32_kernel_queue_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int   neorv32_kernel_setup(uint64_t slice);
+int   neorv32_kernel_task_create(neorv32_kernel_task_t *task, void (*entry)(void *arg), void *arg,
+                                 void *stack, uint32_t stack_size, int prio, const char *name);
+void  neorv32_kernel_start(void);
+neorv32_kernel_task_t *neorv32_kernel_self(void);
+uint32_t neorv32_kernel_get_switches(void);
+void  neorv32_kernel_yield(void);
+void  neorv32_kernel_sleep(uint64_t ticks);
+void  neorv32_kernel_sleep_until(uint64_t time);
+void  neorv32_kernel_sem_init(neorv32_kernel_sem_t *sem, uint32_t count);
+int   neorv32_kernel_sem_wait(neorv32_kernel_sem_t *sem, uint64_t timeout);
+void  neorv32_kernel_sem_post(neorv32_kernel_sem_t *sem);
+int   neorv32_kernel_queue_init(neorv32_kernel_queue_t *queue, void *buf, uint32_t size, uint32_t num);
+int   neorv32_kernel_queue_send(neorv32_kernel_queue_t *queue, const void *item, uint64_t timeout);
+int   neorv32_kernel_queue_recv(neorv32_kernel_queue_t *queue, void *item, uint64_t timeout);
+/**@}*/
+
+
+#endif // NEORV32_KERNEL_H
@@ -0,0 +1,62 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_log.h
+ * @brief Deferred binary logging header file.
+ *
+ * @note Only the address of the format string (in the non-loaded ".neorv32_log" section),
+ * an mcycle time stamp and the raw 32-bit arguments are stored. The text is reconstructed
+ * on the host by sw/log_decode using the application's ELF file.
+ */
+
+#ifndef NEORV32_LOG_H
+#define NEORV32_LOG_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Record header word
+ **************************************************************************/
+/**@{*/
+#define NEORV32_LOG_SYNC     0xa /**< header word bits [3:0]: sync pattern */
+#define NEORV32_LOG_NUM_LSB  4   /**< header word bits [7:4]: number of arguments */
+#define NEORV32_LOG_ID_LSB   8   /**< header word bits [31:8]: format string ID (offset in .neorv32_log) */
+#define NEORV32_LOG_MAX_ARGS 15  /**< maximum number of arguments per record */
+/**@}*/
+
+
+/**********************************************************************//**
+ * Log a message. The format string is not stored in the executable image
+ * and the formatting is done on the host.
+ *
+ * @note All arguments are stored as 32-bit integers; the format string may use
+ * all 32-bit conversions of #neorv32_fmt_vprintf() except %s.
+ *
+ * @param[in] fmt Format string (string literal).
+ **************************************************************************/
+#define NEORV32_LOG(fmt, ...) do { \
+  static const char __neorv32_log_fmt[] __attribute__((section(".neorv32_log"),used)) = fmt; \
+  const uint32_t __neorv32_log_args[] = { 0, ##__VA_ARGS__ }; \
+  neorv32_log_write((uint32_t)__neorv32_log_fmt, &__neorv32_log_args[1], (sizeof(__neorv32_log_args) / 4) - 1); \
+} while(0)
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int      neorv32_log_setup(neorv32_uart_t *UARTx, uint32_t *buffer, int size);
+void     neorv32_log_write(uint32_t id, const uint32_t *args, int num);
+void     neorv32_log_flush(void);
+uint32_t neorv32_log_get_dropped(void);
+/**@}*/
+
+
+#endif // NEORV32_LOG_H
@@ -0,0 +1,93 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_msgq.h
+ * @brief Zero-copy shared-memory message queue (SMP) header file.
+ *
+ * @note Messages are descriptors (buffer address and length); the payload buffers stay in
+ * shared memory and are not copied. Multiple producers (cores and interrupt handlers) and a
+ * single consumer are supported. The data cache is synchronized (fence) once per batch of
+ * messages. Requires the A ISA extension.
+ */
+
+#ifndef NEORV32_MSGQ_H
+#define NEORV32_MSGQ_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * Alignment of all queue data that is shared by the cores (has to be at least the data
+ * cache block size).
+ **************************************************************************/
+#ifndef NEORV32_MSGQ_CACHE_BLOCK
+#define NEORV32_MSGQ_CACHE_BLOCK 64
+#endif
+
+
+/**********************************************************************//**
+ * Message descriptor.
+ **************************************************************************/
+typedef struct {
+  void     *buf; /**< payload buffer */
+  uint32_t len;  /**< payload length in bytes */
+} neorv32_msgq_msg_t;
+
+
+/**********************************************************************//**
+ * Queue slot (accessed by atomic memory operations only). The slot array has to occupy
+ * entire cache blocks (at least 4 slots for 64-byte blocks).
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t seq;      /**< sequence number (free: position, filled: position + 1) */
+  volatile uint32_t buf;      /**< payload buffer address */
+  volatile uint32_t len;      /**< payload length */
+  volatile uint32_t reserved; /**< padding */
+} neorv32_msgq_slot_t;
+
+
+/**********************************************************************//**
+ * Message queue control structure. Occupies entire cache blocks as it is modified by
+ * several cores (atomic memory operations only).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_MSGQ_CACHE_BLOCK))) {
+  neorv32_msgq_slot_t *slot;  /**< slot array (power-of-two number of slots) */
+  uint32_t          num;      /**< number of slots */
+  uint32_t          consumer; /**< hart ID of the consumer (MSI notification) */
+  volatile uint32_t reserve;  /**< next position to be reserved by a producer */
+  volatile uint32_t head;     /**< next position to be consumed */
+  volatile uint32_t sleeping; /**< consumer is waiting for a notification */
+} neorv32_msgq_t;
+
+
+/**********************************************************************//**
+ * Define a message queue and its slot array (cache block aligned).
+ * #neorv32_msgq_init() has to be called before the queue is used.
+ *
+ * @param[in] name Name of the queue (#neorv32_msgq_t); the slot array is called name_slot.
+ * @param[in] num Number of slots (power of two).
+ **************************************************************************/
+#define NEORV32_MSGQ_DEFINE(name, num) \
+  static neorv32_msgq_slot_t name##_slot[num] __attribute__((aligned(NEORV32_MSGQ_CACHE_BLOCK))); \
+  static neorv32_msgq_t name
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int neorv32_msgq_init(neorv32_msgq_t *q, neorv32_msgq_slot_t *slot, uint32_t num, int consumer);
+int neorv32_msgq_send(neorv32_msgq_t *q, void *buf, uint32_t len);
+int neorv32_msgq_send_batch(neorv32_msgq_t *q, const neorv32_msgq_msg_t *msg, uint32_t n);
+int neorv32_msgq_recv(neorv32_msgq_t *q, neorv32_msgq_msg_t *msg, uint32_t max);
+int neorv32_msgq_recv_wait(neorv32_msgq_t *q, neorv32_msgq_msg_t *msg, uint32_t max);
+/**@}*/
+
+
+#endif // NEORV32_MSGQ_H
@@ -0,0 +1,80 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_mutex.h
+ * @brief Sleeping inter-core mutex based on the HWSPINLOCK (SMP) header file.
+ *
+ * @note A core that cannot acquire the mutex sleeps until the owner releases the mutex
+ * and triggers the waiting core's machine software interrupt (MSI). Per-mutex contention
+ * statistics are recorded for tuning.
+ */
+
+#ifndef NEORV32_MUTEX_H
+#define NEORV32_MUTEX_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * Alignment of the mutex data (has to be at least the data cache block size).
+ **************************************************************************/
+#ifndef NEORV32_MUTEX_CACHE_BLOCK
+#define NEORV32_MUTEX_CACHE_BLOCK 64
+#endif
+
+
+/**********************************************************************//**
+ * Waiting flag of one core (occupies an entire cache block as it is written by that core only).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_MUTEX_CACHE_BLOCK))) {
+  volatile uint32_t waiting; /**< core sleeps until the mutex is released */
+} neorv32_mutex_waiter_t;
+
+
+/**********************************************************************//**
+ * Mutex. The first cache block (configuration and statistics) is written by the
+ * current owner only.
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_MUTEX_CACHE_BLOCK))) {
+  volatile uint32_t lock;       /**< HWSPINLOCK lock (0..31) */
+  volatile uint32_t acquires;   /**< number of acquisitions */
+  volatile uint32_t contended;  /**< number of acquisitions that had to wait */
+  volatile uint32_t wait_lo;    /**< total wait time (CPU cycles), low word */
+  volatile uint32_t wait_hi;    /**< total wait time (CPU cycles), high word */
+  volatile uint32_t hold_max;   /**< longest hold time (CPU cycles) */
+  volatile uint32_t hold_start; /**< cycle counter (low word) at the last acquisition */
+  neorv32_mutex_waiter_t waiter[NEORV32_RTE_MAX_HARTS]; /**< waiting flag of each core */
+} neorv32_mutex_t;
+
+
+/**********************************************************************//**
+ * Mutex contention statistics.
+ **************************************************************************/
+typedef struct {
+  uint32_t acquires;  /**< number of acquisitions */
+  uint32_t contended; /**< number of acquisitions that had to wait */
+  uint64_t wait;      /**< total time spent waiting for the mutex (CPU cycles) */
+  uint32_t hold_max;  /**< longest time the mutex has been held (CPU cycles) */
+} neorv32_mutex_stats_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int  neorv32_mutex_init(neorv32_mutex_t *mutex, int lock);
+void neorv32_mutex_lock(neorv32_mutex_t *mutex);
+int  neorv32_mutex_trylock(neorv32_mutex_t *mutex);
+void neorv32_mutex_unlock(neorv32_mutex_t *mutex);
+void neorv32_mutex_get_stats(neorv32_mutex_t *mutex, neorv32_mutex_stats_t *stats, int reset);
+void neorv32_mutex_print_stats(neorv32_mutex_t *mutex, const char *name);
+/**@}*/
+
+
+#endif // NEORV32_MUTEX_H
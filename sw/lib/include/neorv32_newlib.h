@@ -0,0 +1,47 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_newlib.h
+ * @brief NEORV32-specific Newlib system calls configuration header file.
+ */
+
+#ifndef NEORV32_NEWLIB_H
+#define NEORV32_NEWLIB_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name SMP locking configuration
+ **************************************************************************/
+/**@{*/
+/** HWSPINLOCK lock that guards the C library locks if the A ISA extension is not available */
+#ifndef NEORV32_NEWLIB_HWSPINLOCK
+#define NEORV32_NEWLIB_HWSPINLOCK 31
+#endif
+/** Number of locks for dynamically created newlib locks (e.g. stdio streams) */
+#ifndef NEORV32_NEWLIB_LOCKS
+#define NEORV32_NEWLIB_LOCKS 8
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ *
+ * @note Buffered stdio (#neorv32_newlib_stdio_setup()) is owned by the core that sets it up,
+ * as only this core executes the UART interrupt handlers. Other cores write directly to the
+ * UART after the TX ring buffer has been drained and cannot read from a buffered RX stream.
+ **************************************************************************/
+/**@{*/
+int neorv32_newlib_stdio_setup(neorv32_uart_t *UARTx, char *tx_buf, int tx_size, char *rx_buf, int rx_size);
+/**@}*/
+
+
+#endif // NEORV32_NEWLIB_H
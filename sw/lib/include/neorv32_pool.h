@@ -0,0 +1,91 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_pool.h
+ * @brief Fixed-size block pool allocator header file.
+ *
+ * @note Allocation and release are O(1) and can be used from interrupt handlers and
+ * from both cores. They are lock-free if the A ISA extension is enabled; otherwise they
+ * use interrupt masking (and the HWSPINLOCK, if available, for SMP configurations).
+ */
+
+#ifndef NEORV32_POOL_H
+#define NEORV32_POOL_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * HWSPINLOCK lock that guards the pools if the A ISA extension is not available.
+ **************************************************************************/
+#ifndef NEORV32_POOL_HWSPINLOCK
+#define NEORV32_POOL_HWSPINLOCK 29
+#endif
+
+
+/**********************************************************************//**
+ * Block pool control structure.
+ **************************************************************************/
+typedef struct {
+  void *volatile    free;       /**< list of released blocks (linked via first word) */
+  volatile uint32_t next;       /**< index of first block that has never been allocated */
+  volatile uint32_t used;       /**< number of allocated blocks */
+  volatile uint32_t peak;       /**< maximum number of allocated blocks (high-water mark) */
+  uint8_t           *mem;       /**< block memory */
+  uint32_t          block_size; /**< block size in bytes (multiple of 4) */
+  uint32_t          num;        /**< number of blocks */
+} neorv32_pool_t;
+
+
+/**********************************************************************//**
+ * Block size of a pool with blocks of at least size bytes.
+ **************************************************************************/
+#define NEORV32_POOL_BLOCK_SIZE(size) ((size) < 4 ? 4 : (((size) + 3) & ~3))
+
+
+/**********************************************************************//**
+ * Define a statically-initialized block pool in a specific memory section.
+ * No further initialization is required.
+ *
+ * @note The section has to be provided by the linker script (e.g. a NOLOAD section in
+ * processor-external memory).
+ *
+ * @param[in] name Name of the pool (#neorv32_pool_t).
+ * @param[in] size Size of each block in bytes.
+ * @param[in] num Number of blocks.
+ * @param[in] sec Section name (string).
+ **************************************************************************/
+#define NEORV32_POOL_DEFINE_IN(name, size, num, sec) \
+  static uint32_t name##_mem[(num) * NEORV32_POOL_BLOCK_SIZE(size) / 4] __attribute__((section(sec),aligned(8))); \
+  neorv32_pool_t name = { NULL, 0, 0, 0, (uint8_t*)name##_mem, NEORV32_POOL_BLOCK_SIZE(size), (num) }
+
+
+/**********************************************************************//**
+ * Define a statically-initialized block pool in the .bss section.
+ *
+ * @param[in] name Name of the pool (#neorv32_pool_t).
+ * @param[in] size Size of each block in bytes.
+ * @param[in] num Number of blocks.
+ **************************************************************************/
+#define NEORV32_POOL_DEFINE(name, size, num) NEORV32_POOL_DEFINE_IN(name, size, num, ".bss." #name)
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int      neorv32_pool_init(neorv32_pool_t *pool, void *mem, uint32_t block_size, uint32_t num);
+void    *neorv32_pool_alloc(neorv32_pool_t *pool);
+void     neorv32_pool_free(neorv32_pool_t *pool, void *block);
+uint32_t neorv32_pool_get_used(neorv32_pool_t *pool);
+uint32_t neorv32_pool_get_peak(neorv32_pool_t *pool);
+/**@}*/
+
+
+#endif // NEORV32_POOL_H
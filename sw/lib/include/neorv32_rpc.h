@@ -0,0 +1,73 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_rpc.h
+ * @brief Asynchronous inter-core remote procedure calls (SMP) header file.
+ *
+ * @note Core 0 sends requests (futures) to core 1 via the ICC link and core 1's machine software
+ * interrupt (MSI). Core 1 executes the requests in its MSI handler and signals completion via
+ * core 0's MSI.
+ */
+
+#ifndef NEORV32_RPC_H
+#define NEORV32_RPC_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * Alignment of futures (has to be at least the data cache block size).
+ **************************************************************************/
+#ifndef NEORV32_RPC_CACHE_BLOCK
+#define NEORV32_RPC_CACHE_BLOCK 64
+#endif
+
+
+/**********************************************************************//**
+ * Remote procedure: executed on core 1, returns the result of the call.
+ **************************************************************************/
+typedef uint32_t (*neorv32_rpc_fn_t)(void *arg);
+
+
+/**********************************************************************//**
+ * Future states.
+ **************************************************************************/
+enum NEORV32_RPC_STATE_enum {
+  RPC_IDLE    = 0, /**< no request or result has been fetched */
+  RPC_PENDING = 1, /**< request has been sent, not completed yet */
+  RPC_DONE    = 2  /**< request has been completed, result is available */
+};
+
+
+/**********************************************************************//**
+ * Future: request and result of an asynchronous call. Occupies an entire cache block
+ * as it is modified by both cores. Must only be accessed via the RPC functions.
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_RPC_CACHE_BLOCK))) {
+  volatile uint32_t fn;     /**< remote procedure */
+  volatile uint32_t arg;    /**< argument */
+  volatile uint32_t result; /**< return value of the remote procedure */
+  volatile uint32_t state;  /**< request state (#NEORV32_RPC_STATE_enum) */
+} neorv32_rpc_future_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int      neorv32_rpc_server_setup(void);
+int      neorv32_rpc_server_start(uint8_t* stack_memory, size_t stack_size_bytes);
+int      neorv32_rpc_call_async(neorv32_rpc_future_t *fut, neorv32_rpc_fn_t fn, void *arg);
+int      neorv32_rpc_poll(neorv32_rpc_future_t *fut);
+uint32_t neorv32_rpc_wait(neorv32_rpc_future_t *fut);
+uint32_t neorv32_rpc_call(neorv32_rpc_fn_t fn, void *arg);
+/**@}*/
+
+
+#endif // NEORV32_RPC_H
@@ -56,16 +56,45 @@ enum NEORV32_RTE_TRAP_enum {
 #define NEORV32_RTE_NUM_TRAPS 29
 /**@}*/
 
+/**********************************************************************//**
+ * Maximum number of cores (harts) handled by the RTE. Each core has its own
+ * trap handler table. Can be overridden by the application (e.g. via USER_FLAGS).
+ **************************************************************************/
+#ifndef NEORV32_RTE_MAX_HARTS
+#define NEORV32_RTE_MAX_HARTS 2
+#endif
+
+/**********************************************************************//**
+ * Number of words of a context saved by #neorv32_rte_context_switch()
+ * (return address and registers x1..x31 or x1..x15 for RV32E).
+ **************************************************************************/
+#ifndef __riscv_32e
+#define NEORV32_RTE_CONTEXT_WORDS 32
+#else
+#define NEORV32_RTE_CONTEXT_WORDS 16
+#endif
+
 /**********************************************************************//**
  * @name Prototypes
  **************************************************************************/
 /**@{*/
 void     neorv32_rte_setup(void);
+void     neorv32_rte_vectored_enable(void);
+void     neorv32_rte_vectored_disable(void);
 void     neorv32_rte_core(void);
+void     neorv32_rte_vector_table(void);
 int      neorv32_rte_handler_install(int id, void (*handler)(void));
+int      neorv32_rte_handler_install_hart(int hart, int id, void (*handler)(void));
+int      neorv32_rte_handler_install_fast(int id, void (*handler)(void));
+int      neorv32_rte_handler_install_fast_hart(int hart, int id, void (*handler)(void));
+int      neorv32_rte_handler_install_prio(int id, void (*handler)(void), int prio);
+int      neorv32_rte_irq_priority_set(int hart, int id, int prio);
+int      neorv32_rte_irq_disable(int id);
+int      neorv32_rte_irq_nesting(void);
 void     neorv32_rte_debug_handler(void);
 uint32_t neorv32_rte_context_get(int x);
 void     neorv32_rte_context_put(int x, uint32_t data);
+int      neorv32_rte_context_switch(uint32_t *save, const uint32_t *restore);
 /**@}*/
 
 #endif // NEORV32_RTE_H
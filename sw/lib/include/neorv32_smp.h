@@ -15,6 +15,33 @@
 #define NEORV32_SMP_H
 
 
+/**********************************************************************//**
+ * HWSPINLOCK lock that guards the parallel loop iteration counter if the
+ * A ISA extension is not available.
+ **************************************************************************/
+#ifndef NEORV32_SMP_HWSPINLOCK
+#define NEORV32_SMP_HWSPINLOCK 28
+#endif
+
+
+/**********************************************************************//**
+ * Parallel loop body: process iterations [begin, end).
+ **************************************************************************/
+typedef void (*neorv32_smp_for_t)(uint32_t begin, uint32_t end, void *ctx);
+
+
+/**********************************************************************//**
+ * Parallel reduction body: process iterations [begin, end) and return the partial result.
+ **************************************************************************/
+typedef uint32_t (*neorv32_smp_reduce_t)(uint32_t begin, uint32_t end, void *ctx);
+
+
+/**********************************************************************//**
+ * Parallel reduction: combine two partial results (has to be associative and commutative).
+ **************************************************************************/
+typedef uint32_t (*neorv32_smp_combine_t)(uint32_t a, uint32_t b);
+
+
 /**********************************************************************//**
  * @name Prototypes
  **************************************************************************/
@@ -22,6 +49,10 @@
 int      neorv32_smp_launch(int (*entry_point)(void), uint8_t* stack_memory, size_t stack_size_bytes);
 void     neorv32_smp_icc_push(uint32_t data);
 uint32_t neorv32_smp_icc_pop(void);
+int      neorv32_smp_worker_start(uint8_t* stack_memory, size_t stack_size_bytes);
+int      neorv32_smp_parallel_for(uint32_t begin, uint32_t end, uint32_t grain, neorv32_smp_for_t fn, void *ctx);
+uint32_t neorv32_smp_parallel_reduce(uint32_t begin, uint32_t end, uint32_t grain, neorv32_smp_reduce_t fn,
+                                     neorv32_smp_combine_t combine, uint32_t identity, void *ctx);
 /**@}*/
 
 
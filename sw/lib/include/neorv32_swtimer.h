@@ -0,0 +1,68 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_swtimer.h
+ * @brief Software timers (hierarchical timing wheel on CLINT MTIMECMP) header file.
+ *
+ * @note Any number of software timers is multiplexed onto the machine timer interrupt
+ * of a core. Starting and stopping a timer is O(1). The CLINT's MTIMECMP register is
+ * always programmed to the next expiration (tickless operation).
+ */
+
+#ifndef NEORV32_SWTIMER_H
+#define NEORV32_SWTIMER_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Timing wheel configuration
+ **************************************************************************/
+/**@{*/
+/** Timer resolution: 2^NEORV32_SWTIMER_SHIFT MTIME ticks */
+#ifndef NEORV32_SWTIMER_SHIFT
+#define NEORV32_SWTIMER_SHIFT 6
+#endif
+/** Number of wheel levels (32 slots each); timers beyond 2^(5*levels) resolution units are parked on an overflow list */
+#ifndef NEORV32_SWTIMER_LEVELS
+#define NEORV32_SWTIMER_LEVELS 6
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * Software timer. Can be located anywhere (e.g. static or on the stack of a task
+ * that stops the timer before returning); initialize via #neorv32_swtimer_init().
+ **************************************************************************/
+typedef struct neorv32_swtimer_struct {
+  struct neorv32_swtimer_struct  *next;  /**< next timer in the same list (internal) */
+  struct neorv32_swtimer_struct **pprev; /**< link that points to this timer (internal) */
+  uint64_t time;                         /**< expiration time (MTIME) */
+  uint64_t period;                       /**< reload period in MTIME ticks (0 = one-shot) */
+  void (*callback)(void *arg);           /**< callback function (executed in interrupt context) */
+  void *arg;                             /**< callback argument */
+  uint8_t list;                          /**< list the timer is linked to (internal) */
+  uint8_t hart;                          /**< core the timer is running on */
+} neorv32_swtimer_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int  neorv32_swtimer_setup(void);
+void neorv32_swtimer_init(neorv32_swtimer_t *timer, void (*callback)(void *arg), void *arg);
+int  neorv32_swtimer_start(neorv32_swtimer_t *timer, uint64_t delay, uint64_t period);
+int  neorv32_swtimer_start_at(neorv32_swtimer_t *timer, uint64_t time, uint64_t period);
+int  neorv32_swtimer_stop(neorv32_swtimer_t *timer);
+int  neorv32_swtimer_active(neorv32_swtimer_t *timer);
+/**@}*/
+
+
+#endif // NEORV32_SWTIMER_H
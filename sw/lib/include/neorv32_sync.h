@@ -0,0 +1,102 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_sync.h
+ * @brief SMP synchronization primitives (ticket locks, reader-writer locks, barriers,
+ * once-flags) header file.
+ *
+ * @note All synchronization objects are accessed by atomic memory operations (A ISA
+ * extension), which bypass the data caches. If the A ISA extension is not available the
+ * operations are guarded by interrupt masking and the HWSPINLOCK (SMP configurations).
+ * Acquiring a lock or passing a barrier also synchronizes the data cache (fence) so the
+ * protected data is up to date.
+ */
+
+#ifndef NEORV32_SYNC_H
+#define NEORV32_SYNC_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Synchronization library configuration
+ **************************************************************************/
+/**@{*/
+/** Alignment of all synchronization objects (has to be at least the data cache block size) */
+#ifndef NEORV32_SYNC_CACHE_BLOCK
+#define NEORV32_SYNC_CACHE_BLOCK 64
+#endif
+/** Maximum number of busy-wait iterations between two polls of a contended object */
+#ifndef NEORV32_SYNC_BACKOFF_MAX
+#define NEORV32_SYNC_BACKOFF_MAX 256
+#endif
+/** HWSPINLOCK lock that guards all synchronization objects if the A ISA extension is not available */
+#ifndef NEORV32_SYNC_HWSPINLOCK
+#define NEORV32_SYNC_HWSPINLOCK 27
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * Ticket lock (FIFO-fair spinlock).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_SYNC_CACHE_BLOCK))) {
+  volatile uint32_t next;  /**< next ticket to be drawn */
+  volatile uint32_t owner; /**< ticket that owns the lock */
+} neorv32_sync_ticket_t;
+
+
+/**********************************************************************//**
+ * Reader-writer lock (multiple readers or a single writer; waiting writers block new readers).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_SYNC_CACHE_BLOCK))) {
+  volatile uint32_t state; /**< writer flag, writer-waiting flag and number of readers */
+} neorv32_sync_rwlock_t;
+
+
+/**********************************************************************//**
+ * Sense-reversing barrier for up to one participant per core.
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_SYNC_CACHE_BLOCK))) {
+  volatile uint32_t count;                       /**< number of arrived participants */
+  volatile uint32_t sense;                       /**< global sense (flips when all have arrived) */
+  volatile uint32_t num;                         /**< number of participants */
+  volatile uint32_t local[NEORV32_RTE_MAX_HARTS]; /**< local sense of each core */
+} neorv32_sync_barrier_t;
+
+
+/**********************************************************************//**
+ * Once-flag (has to be zero-initialized).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_SYNC_CACHE_BLOCK))) {
+  volatile uint32_t state; /**< 0 = not executed, 1 = executing, 2 = done */
+} neorv32_sync_once_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+void neorv32_sync_backoff(uint32_t *delay);
+void neorv32_sync_ticket_init(neorv32_sync_ticket_t *lock);
+void neorv32_sync_ticket_acquire(neorv32_sync_ticket_t *lock);
+int  neorv32_sync_ticket_try(neorv32_sync_ticket_t *lock);
+void neorv32_sync_ticket_release(neorv32_sync_ticket_t *lock);
+void neorv32_sync_rwlock_init(neorv32_sync_rwlock_t *lock);
+void neorv32_sync_rwlock_rdlock(neorv32_sync_rwlock_t *lock);
+void neorv32_sync_rwlock_rdunlock(neorv32_sync_rwlock_t *lock);
+void neorv32_sync_rwlock_wrlock(neorv32_sync_rwlock_t *lock);
+void neorv32_sync_rwlock_wrunlock(neorv32_sync_rwlock_t *lock);
+int  neorv32_sync_barrier_init(neorv32_sync_barrier_t *barrier, uint32_t num);
+void neorv32_sync_barrier_wait(neorv32_sync_barrier_t *barrier);
+void neorv32_sync_once(neorv32_sync_once_t *once, void (*fn)(void));
+/**@}*/
+
+
+#endif // NEORV32_SYNC_H
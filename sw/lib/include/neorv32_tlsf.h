@@ -0,0 +1,72 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_tlsf.h
+ * @brief Two-level segregated fit (TLSF) memory allocator header file.
+ *
+ * @note Compile with "-DNEORV32_TLSF_MALLOC" (e.g. USER_FLAGS) to replace newlib's
+ * malloc/free/realloc/calloc by the TLSF allocator operating on the linker script's heap.
+ */
+
+#ifndef NEORV32_TLSF_H
+#define NEORV32_TLSF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/**********************************************************************//**
+ * @name TLSF configuration
+ **************************************************************************/
+/**@{*/
+#define NEORV32_TLSF_ALIGN   8  /**< block alignment and size granularity (bytes) */
+#define NEORV32_TLSF_SL_LOG2 4  /**< log2 of number of second-level lists per first-level class */
+#define NEORV32_TLSF_FL_NUM  22 /**< number of first-level classes; largest block is 2^(FL_NUM+6)-8 bytes */
+/**@}*/
+
+
+/**********************************************************************//**
+ * TLSF control structure (one per memory pool).
+ **************************************************************************/
+typedef struct {
+  uint32_t fl_bitmap;                                                    /**< first-level: non-empty classes */
+  uint32_t sl_bitmap[NEORV32_TLSF_FL_NUM];                               /**< second-level: non-empty lists */
+  void     *blocks[NEORV32_TLSF_FL_NUM][1 << NEORV32_TLSF_SL_LOG2];      /**< free list heads */
+  uint32_t total;                                                        /**< usable bytes in pool */
+  uint32_t used;                                                         /**< allocated bytes (excl. overhead) */
+  uint32_t peak;                                                         /**< maximum of used */
+} neorv32_tlsf_t;
+
+
+/**********************************************************************//**
+ * TLSF statistics.
+ **************************************************************************/
+typedef struct {
+  uint32_t total;   /**< usable bytes in pool */
+  uint32_t used;    /**< allocated bytes (excl. overhead) */
+  uint32_t peak;    /**< maximum number of allocated bytes since init */
+  uint32_t free;    /**< free bytes (sum of all free blocks) */
+  uint32_t largest; /**< size of the largest free block (largest possible allocation) */
+} neorv32_tlsf_stats_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int             neorv32_tlsf_init(neorv32_tlsf_t *tlsf, void *mem, size_t size);
+void           *neorv32_tlsf_malloc(neorv32_tlsf_t *tlsf, size_t size);
+void            neorv32_tlsf_free(neorv32_tlsf_t *tlsf, void *ptr);
+void           *neorv32_tlsf_realloc(neorv32_tlsf_t *tlsf, void *ptr, size_t size);
+void            neorv32_tlsf_get_stats(neorv32_tlsf_t *tlsf, neorv32_tlsf_stats_t *stats);
+neorv32_tlsf_t *neorv32_tlsf_get_heap(void);
+/**@}*/
+
+
+#endif // NEORV32_TLSF_H
@@ -108,9 +108,18 @@ char neorv32_uart_getc(neorv32_uart_t *UARTx);
 int  neorv32_uart_char_received(neorv32_uart_t *UARTx);
 char neorv32_uart_char_received_get(neorv32_uart_t *UARTx);
 void neorv32_uart_puts(neorv32_uart_t *UARTx, const char *s);
+void neorv32_uart_write(neorv32_uart_t *UARTx, const char *buffer, int length);
 void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args);
 void neorv32_uart_printf(neorv32_uart_t *UARTx, const char *format, ...);
 int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int echo);
+int  neorv32_uart_irq_setup(neorv32_uart_t *UARTx, char *tx_buf, int tx_size, char *rx_buf, int rx_size);
+int  neorv32_uart_irq_write(neorv32_uart_t *UARTx, const char *buffer, int length);
+int  neorv32_uart_irq_read(neorv32_uart_t *UARTx, char *buffer, int length);
+int  neorv32_uart_irq_tx_free(neorv32_uart_t *UARTx);
+int  neorv32_uart_irq_rx_available(neorv32_uart_t *UARTx);
+void neorv32_uart_irq_flush(neorv32_uart_t *UARTx);
+int  neorv32_uart_write_dma(neorv32_uart_t *UARTx, const char *buffer, int length);
+int  neorv32_uart_write_dma_done(neorv32_uart_t *UARTx);
 /**@}*/
 
 
@@ -136,8 +145,17 @@ int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int ec
 #define neorv32_uart0_char_received()              neorv32_uart_char_received(NEORV32_UART0)
 #define neorv32_uart0_char_received_get()          neorv32_uart_char_received_get(NEORV32_UART0)
 #define neorv32_uart0_puts(s)                      neorv32_uart_puts(NEORV32_UART0, s)
+#define neorv32_uart0_write(buffer, length)        neorv32_uart_write(NEORV32_UART0, buffer, length)
 #define neorv32_uart0_printf(...)                  neorv32_uart_printf(NEORV32_UART0, __VA_ARGS__)
 #define neorv32_uart0_scan(buffer, max_size, echo) neorv32_uart_scan(NEORV32_UART0, buffer, max_size, echo)
+#define neorv32_uart0_irq_setup(tx_buf, tx_size, rx_buf, rx_size) neorv32_uart_irq_setup(NEORV32_UART0, tx_buf, tx_size, rx_buf, rx_size)
+#define neorv32_uart0_irq_write(buffer, length)    neorv32_uart_irq_write(NEORV32_UART0, buffer, length)
+#define neorv32_uart0_irq_read(buffer, length)     neorv32_uart_irq_read(NEORV32_UART0, buffer, length)
+#define neorv32_uart0_irq_tx_free()                neorv32_uart_irq_tx_free(NEORV32_UART0)
+#define neorv32_uart0_irq_rx_available()           neorv32_uart_irq_rx_available(NEORV32_UART0)
+#define neorv32_uart0_irq_flush()                  neorv32_uart_irq_flush(NEORV32_UART0)
+#define neorv32_uart0_write_dma(buffer, length)    neorv32_uart_write_dma(NEORV32_UART0, buffer, length)
+#define neorv32_uart0_write_dma_done()             neorv32_uart_write_dma_done(NEORV32_UART0)
 
 #define neorv32_uart1_available()                  neorv32_uart_available(NEORV32_UART1)
 #define neorv32_uart1_get_rx_fifo_depth()          neorv32_uart_get_rx_fifo_depth(NEORV32_UART1)
@@ -157,8 +175,17 @@ int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int ec
 #define neorv32_uart1_char_received()              neorv32_uart_char_received(NEORV32_UART1)
 #define neorv32_uart1_char_received_get()          neorv32_uart_char_received_get(NEORV32_UART1)
 #define neorv32_uart1_puts(s)                      neorv32_uart_puts(NEORV32_UART1, s)
+#define neorv32_uart1_write(buffer, length)        neorv32_uart_write(NEORV32_UART1, buffer, length)
 #define neorv32_uart1_printf(...)                  neorv32_uart_printf(NEORV32_UART1, __VA_ARGS__)
 #define neorv32_uart1_scan(buffer, max_size, echo) neorv32_uart_scan(NEORV32_UART1, buffer, max_size, echo)
+#define neorv32_uart1_irq_setup(tx_buf, tx_size, rx_buf, rx_size) neorv32_uart_irq_setup(NEORV32_UART1, tx_buf, tx_size, rx_buf, rx_size)
+#define neorv32_uart1_irq_write(buffer, length)    neorv32_uart_irq_write(NEORV32_UART1, buffer, length)
+#define neorv32_uart1_irq_read(buffer, length)     neorv32_uart_irq_read(NEORV32_UART1, buffer, length)
+#define neorv32_uart1_irq_tx_free()                neorv32_uart_irq_tx_free(NEORV32_UART1)
+#define neorv32_uart1_irq_rx_available()           neorv32_uart_irq_rx_available(NEORV32_UART1)
+#define neorv32_uart1_irq_flush()                  neorv32_uart_irq_flush(NEORV32_UART1)
+#define neorv32_uart1_write_dma(buffer, length)    neorv32_uart_write_dma(NEORV32_UART1, buffer, length)
+#define neorv32_uart1_write_dma_done()             neorv32_uart_write_dma_done(NEORV32_UART1)
 /**@}*/
 
 
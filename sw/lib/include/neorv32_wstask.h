@@ -0,0 +1,91 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_wstask.h
+ * @brief Work-stealing task-parallel runtime (SMP) header file.
+ *
+ * @note Each core owns a Chase-Lev deque of spawned tasks in shared memory. A core executes
+ * its own tasks in LIFO order and steals the oldest task of the other core when it runs out
+ * of work. All shared deque accesses use atomic memory operations, which bypass the data
+ * caches. Requires the A ISA extension; otherwise tasks are executed right when they are spawned.
+ */
+
+#ifndef NEORV32_WSTASK_H
+#define NEORV32_WSTASK_H
+
+#include <stdint.h>
+
+
+/**********************************************************************//**
+ * @name Work-stealing runtime configuration
+ **************************************************************************/
+/**@{*/
+/** Deque capacity per core (has to be a power of two); a task is executed immediately if the deque is full */
+#ifndef NEORV32_WSTASK_DEQUE_SIZE
+#define NEORV32_WSTASK_DEQUE_SIZE 64
+#endif
+/** Alignment of all data that is shared by both cores (has to be at least the data cache block size) */
+#ifndef NEORV32_WSTASK_CACHE_BLOCK
+#define NEORV32_WSTASK_CACHE_BLOCK 64
+#endif
+/** Maximum number of busy-wait iterations between two steal attempts; the worker sleeps afterwards */
+#ifndef NEORV32_WSTASK_BACKOFF_MAX
+#define NEORV32_WSTASK_BACKOFF_MAX 1024
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * Task group: number of spawned tasks that have not been completed yet. Occupies an entire
+ * cache block as it is modified by both cores (atomic memory operations only).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_WSTASK_CACHE_BLOCK))) {
+  volatile uint32_t pending; /**< tasks spawned but not completed */
+} neorv32_wstask_group_t;
+
+
+/**********************************************************************//**
+ * Task descriptor. Has to remain valid until the task's group has been synchronized
+ * (e.g. located on the stack of the spawning function).
+ **************************************************************************/
+typedef struct {
+  void (*fn)(void *arg);          /**< task function */
+  void *arg;                      /**< task argument */
+  neorv32_wstask_group_t *group;  /**< group the task belongs to */
+} neorv32_wstask_t;
+
+
+/**********************************************************************//**
+ * Per-core runtime statistics.
+ **************************************************************************/
+typedef struct {
+  uint32_t spawned;      /**< tasks spawned by this core */
+  uint32_t executed;     /**< tasks executed by this core */
+  uint32_t steals;       /**< tasks stolen from the other core */
+  uint32_t steal_fails;  /**< unsuccessful steal attempts */
+  uint32_t sleeps;       /**< number of times the worker went to sleep */
+  uint64_t busy;         /**< CPU cycles spent executing tasks (outermost level) */
+  uint64_t idle;         /**< CPU cycles spent waiting for work outside of tasks (backoff and sleep) */
+} neorv32_wstask_stats_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+void neorv32_wstask_setup(void);
+int  neorv32_wstask_start(uint8_t* stack_memory, size_t stack_size_bytes);
+void neorv32_wstask_group_init(neorv32_wstask_group_t *group);
+void neorv32_wstask_spawn(neorv32_wstask_group_t *group, neorv32_wstask_t *task, void (*fn)(void *arg), void *arg);
+void neorv32_wstask_sync(neorv32_wstask_group_t *group);
+void neorv32_wstask_get_stats(int hart, neorv32_wstask_stats_t *stats, int reset);
+/**@}*/
+
+
+#endif // NEORV32_WSTASK_H
@@ -0,0 +1,252 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_arena.c
+ * @brief Per-hart memory arenas (SMP) source file.
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * Arena control structure (located at the beginning of the arena's memory).
+ **************************************************************************/
+typedef struct {
+  neorv32_tlsf_t tlsf;   /**< memory pool; accessed by the owning core only */
+  void *volatile remote; /**< blocks released by other cores (LIFO, linked via first payload word) */
+  uint32_t begin;        /**< pool begin address */
+  uint32_t end;          /**< pool end address */
+} __neorv32_arena_t;
+
+
+/**********************************************************************//**
+ * Arena of each core (NULL if not configured).
+ **************************************************************************/
+static __neorv32_arena_t *__neorv32_arena[NEORV32_ARENA_NUM];
+
+
+/**********************************************************************//**
+ * Private function: get the arena that contains an address.
+ *
+ * @param[in] addr Address.
+ * @return Arena index or -1 if address does not belong to any arena.
+ **************************************************************************/
+static int __neorv32_arena_find(uint32_t addr) {
+
+  int i;
+  __neorv32_arena_t *a;
+
+  for (i=0; i<NEORV32_ARENA_NUM; i++) {
+    a = __neorv32_arena[i];
+    if ((a != NULL) && (addr >= a->begin) && (addr < a->end)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+/**********************************************************************//**
+ * Private function: replace the remote list head if it still equals expected.
+ *
+ * @note Uses LR/SC if the A/Zalrsc ISA extension is enabled, the HWSPINLOCK if available
+ * and interrupt masking otherwise (single-core only, see #neorv32_arena_setup()).
+ *
+ * @param[in,out] a Arena.
+ * @param[in] expected Expected list head.
+ * @param[in] desired New list head.
+ * @return 1 if list head was replaced, 0 otherwise.
+ **************************************************************************/
+static int __neorv32_arena_cas(__neorv32_arena_t *a, void *expected, void *desired) {
+
+#if defined __riscv_atomic
+  return __sync_bool_compare_and_swap(&a->remote, expected, desired) ? 1 : 0; // -> lr/sc
+#else
+  int ok = 0;
+  int hwlock = neorv32_hwspinlock_available();
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  if (hwlock) {
+    neorv32_hwspinlock_acquire_blocking(NEORV32_ARENA_HWSPINLOCK);
+    asm volatile ("fence");
+  }
+  if (a->remote == expected) {
+    a->remote = desired;
+    ok = 1;
+  }
+  if (hwlock) {
+    asm volatile ("fence");
+    neorv32_hwspinlock_release(NEORV32_ARENA_HWSPINLOCK);
+  }
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  return ok;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Configure the arena of a core.
+ *
+ * @note The arena control structure is located at the beginning of the memory, so memory
+ * from any section (e.g. a core-specific memory or a dedicated linker section) can be used.
+ *
+ * @note In a multi-core configuration the arenas require the A/Zalrsc ISA extension or
+ * the HWSPINLOCK to release memory of another core's arena.
+ *
+ * @warning Setup all arenas before any core uses them.
+ *
+ * @param[in] hart Core ID (0..#NEORV32_ARENA_NUM-1).
+ * @param[in,out] mem Arena memory (word-aligned).
+ * @param[in] size Size of mem in bytes.
+ * @return 0 if success, -1 if invalid core ID, memory too small or no inter-core
+ * synchronization available (multi-core without A/Zalrsc ISA extension and HWSPINLOCK).
+ **************************************************************************/
+int neorv32_arena_setup(int hart, void *mem, size_t size) {
+
+  __neorv32_arena_t *a = (__neorv32_arena_t*)mem;
+
+  if ((hart < 0) || (hart >= NEORV32_ARENA_NUM) || (size < sizeof(__neorv32_arena_t))) {
+    return -1;
+  }
+#if !defined __riscv_atomic
+  // interrupt masking does not exclude the other core
+  if ((neorv32_sysinfo_get_numcores() > 1) && (neorv32_hwspinlock_available() == 0)) {
+    return -1;
+  }
+#endif
+  if (neorv32_tlsf_init(&a->tlsf, (uint8_t*)mem + sizeof(__neorv32_arena_t), size - sizeof(__neorv32_arena_t))) {
+    return -1;
+  }
+
+  a->remote = NULL;
+  a->begin  = (uint32_t)mem;
+  a->end    = (uint32_t)mem + (uint32_t)size;
+  asm volatile ("fence"); // make arena visible to the other core
+  __neorv32_arena[hart] = a;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Split the linker script's heap region (#NEORV32_HEAP_BEGIN to #NEORV32_HEAP_END)
+ * into equally-sized arenas, one for each core.
+ *
+ * @warning The heap must not be used by any other allocator (e.g. newlib's malloc).
+ *
+ * @return 0 if success, -1 if there is no heap, the heap is too small or no inter-core
+ * synchronization is available (see #neorv32_arena_setup()).
+ **************************************************************************/
+int neorv32_arena_setup_heap(void) {
+
+  int i, num = (int)neorv32_sysinfo_get_numcores();
+  uint32_t size;
+
+  if (NEORV32_HEAP_SIZE == 0) {
+    return -1;
+  }
+  if (num > NEORV32_ARENA_NUM) {
+    num = NEORV32_ARENA_NUM;
+  }
+
+  size = ((NEORV32_HEAP_END - NEORV32_HEAP_BEGIN) / (uint32_t)num) & ~7u;
+  for (i=0; i<num; i++) {
+    if (neorv32_arena_setup(i, (void*)(NEORV32_HEAP_BEGIN + (uint32_t)i * size), size)) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Allocate memory from the arena of the calling core. This does not require any locking.
+ * Memory released by other cores is returned to the arena first.
+ *
+ * @warning Not safe to be used from interrupt handlers.
+ *
+ * @param[in] size Number of bytes.
+ * @return Pointer to memory (8-byte aligned) or NULL if out of memory or arena not configured.
+ **************************************************************************/
+void *neorv32_arena_malloc(size_t size) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_arena_t *a;
+  void *list, *next;
+
+  if ((hart >= NEORV32_ARENA_NUM) || ((a = __neorv32_arena[hart]) == NULL)) {
+    return NULL;
+  }
+
+  // take all blocks that were released by other cores
+  if (a->remote != NULL) {
+    do {
+      list = a->remote;
+    } while (__neorv32_arena_cas(a, list, NULL) == 0);
+    asm volatile ("fence"); // get list links written by the other core
+    while (list != NULL) {
+      next = *(void**)list;
+      neorv32_tlsf_free(&a->tlsf, list);
+      list = next;
+    }
+  }
+
+  return neorv32_tlsf_malloc(&a->tlsf, size);
+}
+
+
+/**********************************************************************//**
+ * Release memory allocated by #neorv32_arena_malloc() of any core. Memory of the calling
+ * core's arena is released immediately without locking; memory of another core's
+ * arena is queued using a lock-free list.
+ *
+ * @warning Not safe to be used from interrupt handlers.
+ *
+ * @param[in,out] ptr Memory to release (NULL and addresses outside of all arenas are ignored).
+ **************************************************************************/
+void neorv32_arena_free(void *ptr) {
+
+  int owner = __neorv32_arena_find((uint32_t)ptr);
+  __neorv32_arena_t *a;
+  void *head;
+
+  if ((ptr == NULL) || (owner < 0)) {
+    return;
+  }
+  a = __neorv32_arena[owner];
+
+  if ((uint32_t)owner == neorv32_cpu_csr_read(CSR_MHARTID)) {
+    neorv32_tlsf_free(&a->tlsf, ptr);
+  }
+  else {
+    do {
+      head = a->remote;
+      *(void**)ptr = head;
+      asm volatile ("fence"); // make list link visible to the owning core
+    } while (__neorv32_arena_cas(a, head, ptr) == 0);
+  }
+}
+
+
+/**********************************************************************//**
+ * Get statistics of a core's arena.
+ *
+ * @note Memory that is queued on the cross-core list is counted as used.
+ *
+ * @param[in] hart Core ID (0..#NEORV32_ARENA_NUM-1).
+ * @param[out] stats Statistics, #neorv32_tlsf_stats_t.
+ * @return 0 if success, -1 if invalid core ID or arena not configured.
+ **************************************************************************/
+int neorv32_arena_get_stats(int hart, neorv32_tlsf_stats_t *stats) {
+
+  if ((hart < 0) || (hart >= NEORV32_ARENA_NUM) || (__neorv32_arena[hart] == NULL)) {
+    return -1;
+  }
+  neorv32_tlsf_get_stats(&__neorv32_arena[hart]->tlsf, stats);
+  return 0;
+}
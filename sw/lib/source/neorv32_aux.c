@@ -19,6 +19,9 @@
  *
  * @warning Timing is imprecise! Use CLINT.MTIME or CSR.[M]CYCLE[H] for precise timing.
  *
+ * @note If the CLINT is available, #neorv32_clint_delay_us() provides precise delays
+ * and puts the CPU to sleep mode while waiting.
+ *
  * @param[in] clock_hz CPU clock speed in Hz.
  * @param[in] time_ms Time in ms to wait (unsigned 32-bit).
  **************************************************************************/
@@ -164,3 +164,170 @@ uint64_t neorv32_clint_unixtime_get(void) {
 
   return neorv32_clint_time_get() / ((uint64_t)neorv32_sysinfo_get_clk());
 }
+
+
+/**********************************************************************//**
+ * Tick/nanosecond conversion factors (32.32 fixed-point) for the current clock speed.
+ **************************************************************************/
+static struct {
+  uint64_t to_ns;        /**< nanoseconds per tick */
+  uint64_t to_ticks;     /**< ticks per nanosecond */
+  volatile uint32_t clk; /**< clock speed the factors were computed for (0 = invalid) */
+} __neorv32_clint_conv;
+
+
+/**********************************************************************//**
+ * Private function: 64x64-bit multiplication using 32x32-bit partial products only.
+ *
+ * @param[in] a Factor.
+ * @param[in] b Factor.
+ * @param[in] shift 32: return product bits [95:32], 64: return product bits [127:64].
+ * @return Shifted product.
+ **************************************************************************/
+static uint64_t __neorv32_clint_mul(uint64_t a, uint64_t b, int shift) {
+
+  uint64_t p0 = (uint64_t)(uint32_t)a * (uint32_t)b;
+  uint64_t p1 = (uint64_t)(uint32_t)a * (uint32_t)(b >> 32);
+  uint64_t p2 = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)b;
+  uint64_t p3 = (uint64_t)(uint32_t)(a >> 32) * (uint32_t)(b >> 32);
+  uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+  uint64_t hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+
+  if (shift == 64) {
+    return hi;
+  }
+  return (hi << 32) | (uint32_t)mid;
+}
+
+
+/**********************************************************************//**
+ * Private function: update conversion factors if the clock speed has changed.
+ * This requires two 64-bit divisions once.
+ **************************************************************************/
+static void __neorv32_clint_conv_update(void) {
+
+  uint32_t clk = neorv32_sysinfo_get_clk();
+
+  if ((clk != __neorv32_clint_conv.clk) && (clk != 0)) {
+    __neorv32_clint_conv.to_ns    = (1000000000ULL << 32) / clk;
+    __neorv32_clint_conv.to_ticks = (((uint64_t)clk << 32) + 999999999ULL) / 1000000000ULL; // round up
+    asm volatile ("fence"); // factors before clock
+    __neorv32_clint_conv.clk = clk;
+  }
+}
+
+
+/**********************************************************************//**
+ * Convert CLINT timer ticks (processor clock cycles) to nanoseconds.
+ *
+ * @note This function does not use any division.
+ *
+ * @param[in] ticks Number of ticks.
+ * @return Time in nanoseconds.
+ **************************************************************************/
+uint64_t neorv32_clint_ticks2ns(uint64_t ticks) {
+
+  __neorv32_clint_conv_update();
+  return __neorv32_clint_mul(ticks, __neorv32_clint_conv.to_ns, 32);
+}
+
+
+/**********************************************************************//**
+ * Convert nanoseconds to CLINT timer ticks (processor clock cycles). The result is rounded up.
+ *
+ * @note This function does not use any division.
+ *
+ * @param[in] ns Time in nanoseconds.
+ * @return Number of ticks.
+ **************************************************************************/
+uint64_t neorv32_clint_ns2ticks(uint64_t ns) {
+
+  __neorv32_clint_conv_update();
+  return __neorv32_clint_mul(ns, __neorv32_clint_conv.to_ticks, 32) + 1;
+}
+
+
+/**********************************************************************//**
+ * Get current system time in nanoseconds.
+ *
+ * @return System time (MTIME) in nanoseconds.
+ **************************************************************************/
+uint64_t neorv32_clint_time_get_ns(void) {
+
+  return neorv32_clint_ticks2ns(neorv32_clint_time_get());
+}
+
+
+/**********************************************************************//**
+ * Split nanoseconds into seconds and remaining nanoseconds without division.
+ *
+ * @param[in] ns Time in nanoseconds.
+ * @param[out] nsec Remaining nanoseconds (0..999999999).
+ * @return Seconds.
+ **************************************************************************/
+uint64_t neorv32_clint_ns2sec(uint64_t ns, uint32_t *nsec) {
+
+  // multiply by floor(2^64 / 10^9); the estimate is at most one too small
+  uint64_t sec = __neorv32_clint_mul(ns, 18446744073ULL, 64);
+  uint64_t rem = ns - sec * 1000000000ULL;
+
+  while (rem >= 1000000000ULL) {
+    rem -= 1000000000ULL;
+    sec++;
+  }
+  *nsec = (uint32_t)rem;
+  return sec;
+}
+
+
+/**********************************************************************//**
+ * Sleep until the system time (MTIME) has reached a specific value. The CPU is put
+ * to sleep mode (wfi) and is woken up by an MTIMECMP match.
+ *
+ * @note Other interrupts are still serviced while sleeping. If the machine timer interrupt is
+ * enabled (mie.MTIE) the MTIMECMP register is in use by the application and this function falls
+ * back to busy-waiting.
+ *
+ * @note This function uses the calling hart's MTIMECMP register (restored when returning).
+ *
+ * @param[in] time System time to wake up at.
+ **************************************************************************/
+void neorv32_clint_sleep_until(uint64_t time) {
+
+  uint32_t mstatus;
+  uint64_t cmp;
+
+  // machine timer interrupt is in use: busy wait
+  if (neorv32_cpu_csr_read(CSR_MIE) & (1 << CSR_MIE_MTIE)) {
+    while (neorv32_clint_time_get() < time);
+    return;
+  }
+
+  cmp = neorv32_clint_mtimecmp_get();
+  neorv32_clint_mtimecmp_set(time);
+
+  while (neorv32_clint_time_get() < time) {
+    // wfi wakes up on any pending enabled interrupt even if interrupts are globally disabled
+    mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MTIE);
+    if (neorv32_clint_time_get() < time) {
+      neorv32_cpu_sleep();
+    }
+    neorv32_cpu_csr_clr(CSR_MIE, 1 << CSR_MIE_MTIE);
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus); // service other pending interrupts
+  }
+
+  neorv32_clint_mtimecmp_set(cmp);
+}
+
+
+/**********************************************************************//**
+ * Delay execution for a number of microseconds using #neorv32_clint_sleep_until().
+ *
+ * @param[in] time_us Time in microseconds.
+ **************************************************************************/
+void neorv32_clint_delay_us(uint32_t time_us) {
+
+  neorv32_clint_sleep_until(neorv32_clint_time_get() + neorv32_clint_ns2ticks((uint64_t)time_us * 1000));
+}
@@ -48,6 +48,32 @@ void neorv32_dma_disable(void) {
 }
 
 
+/**********************************************************************//**
+ * Enable peripheral-paced transfers: each write access is delayed until the
+ * selected processor fast interrupt request line is high.
+ *
+ * @param[in] channel FIRQ channel (0..15) to be used as transfer request
+ * (e.g. #UART0_TX_FIRQ_ENABLE - #CSR_MIE_FIRQ0E).
+ **************************************************************************/
+void neorv32_dma_request_enable(int channel) {
+
+  uint32_t tmp = NEORV32_DMA->CTRL;
+  tmp &= ~((uint32_t)(0xf << DMA_CTRL_REQ_SEL_LSB));
+  tmp |= (uint32_t)(1 << DMA_CTRL_REQ_EN);
+  tmp |= (uint32_t)((channel & 0xf) << DMA_CTRL_REQ_SEL_LSB);
+  NEORV32_DMA->CTRL = tmp;
+}
+
+
+/**********************************************************************//**
+ * Disable peripheral-paced transfers (default).
+ **************************************************************************/
+void neorv32_dma_request_disable(void) {
+
+  NEORV32_DMA->CTRL &= ~((uint32_t)(1 << DMA_CTRL_REQ_EN));
+}
+
+
 /**********************************************************************//**
  * Trigger manual DMA transfer.
  *
@@ -0,0 +1,455 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_evloop.c
+ * @brief Cooperative event loop (reactor) source file.
+ *
+ * @note The event queue is a bounded multi-producer / single-consumer ring buffer. Each entry
+ * carries a sequence number that tells whether the entry is free (sequence = position) or
+ * filled (sequence = position + 1). Producers reserve a position by advancing the tail
+ * index via compare-and-swap (LR/SC) so posting is lock-free even if interrupt handlers
+ * preempt each other. Without the A ISA extension the reservation is protected by
+ * disabling interrupts for a few instructions.
+ */
+
+#include <neorv32.h>
+
+#if (NEORV32_EVLOOP_QUEUE_SIZE < 2) || ((NEORV32_EVLOOP_QUEUE_SIZE & (NEORV32_EVLOOP_QUEUE_SIZE - 1)) != 0)
+#error "NEORV32_EVLOOP_QUEUE_SIZE has to be a power of two"
+#endif
+
+#if (NEORV32_EVLOOP_NUM_IDS < 1) || (NEORV32_EVLOOP_NUM_IDS > 255)
+#error "NEORV32_EVLOOP_NUM_IDS has to be 1..255"
+#endif
+
+/** Event ID flag: event has been posted by an attached FIRQ channel (data = channel) */
+#define EVLOOP_FIRQ_FLAG 0x80000000U
+
+
+/**********************************************************************//**
+ * Event queue entry.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t seq;  /**< sequence number */
+  uint32_t          id;   /**< event ID */
+  uint32_t          data; /**< event data */
+} __neorv32_evloop_entry_t;
+
+
+/**********************************************************************//**
+ * Event loop of one core.
+ **************************************************************************/
+typedef struct {
+  __neorv32_evloop_entry_t  queue[NEORV32_EVLOOP_QUEUE_SIZE]; /**< event queue */
+  volatile uint32_t         tail;                             /**< next write position (producers) */
+  uint32_t                  head;                             /**< next read position (event loop) */
+  neorv32_evloop_callback_t callback[NEORV32_EVLOOP_NUM_IDS]; /**< callback of each event ID */
+  void                      *arg[NEORV32_EVLOOP_NUM_IDS];     /**< callback argument of each event ID */
+  volatile uint8_t          firq[16];                         /**< event ID + 1 of each attached FIRQ channel (0 if none) */
+  volatile uint32_t         lost;                             /**< attached FIRQ channels whose event has been dropped */
+  volatile uint32_t         stop;                             /**< leave the event loop */
+  volatile uint32_t         dropped;                          /**< number of dropped events */
+  uint32_t                  events;                           /**< number of dispatched events */
+  uint64_t                  idle;                             /**< CPU cycles spent sleeping */
+  uint64_t                  start;                            /**< CPU cycle counter at setup / reset */
+} __neorv32_evloop_t;
+
+
+/**********************************************************************//**
+ * Event loop of each core.
+ **************************************************************************/
+static __neorv32_evloop_t __neorv32_evloop[NEORV32_RTE_MAX_HARTS];
+
+
+/**********************************************************************//**
+ * Private function: get event loop of the current core.
+ *
+ * @return Pointer to event loop; NULL if the core cannot use the RTE.
+ **************************************************************************/
+static __neorv32_evloop_t *__neorv32_evloop_self(void) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+
+  if (hart >= NEORV32_RTE_MAX_HARTS) {
+    return NULL;
+  }
+  return &__neorv32_evloop[hart];
+}
+
+
+/**********************************************************************//**
+ * Private function: add event to the queue.
+ *
+ * @param[in,out] loop Event loop.
+ * @param[in] id Event ID (including flags).
+ * @param[in] data Event data.
+ * @return 0 if success, -1 if the queue is full.
+ **************************************************************************/
+static int __neorv32_evloop_put(__neorv32_evloop_t *loop, uint32_t id, uint32_t data) {
+
+  __neorv32_evloop_entry_t *entry;
+  uint32_t pos;
+
+#if defined __riscv_atomic
+  while (1) {
+    pos = loop->tail;
+    entry = &loop->queue[pos & (NEORV32_EVLOOP_QUEUE_SIZE - 1)];
+    if (entry->seq != pos) { // entry has not been released for this position
+      if ((int32_t)(entry->seq - pos) < 0) {
+        __atomic_add_fetch(&loop->dropped, 1, __ATOMIC_RELAXED);
+        return -1; // queue full
+      }
+      continue; // another producer has reserved this position; retry
+    }
+    if (__sync_bool_compare_and_swap(&loop->tail, pos, pos + 1)) { // -> lr/sc
+      break;
+    }
+  }
+#else
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  pos = loop->tail;
+  entry = &loop->queue[pos & (NEORV32_EVLOOP_QUEUE_SIZE - 1)];
+  if (entry->seq != pos) {
+    loop->dropped++;
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+    return -1; // queue full
+  }
+  loop->tail = pos + 1;
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+#endif
+
+  // fill reserved entry and publish it
+  entry->id = id;
+  entry->data = data;
+  asm volatile ("fence" ::: "memory");
+  entry->seq = pos + 1;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Private function: get and remove the oldest event from the queue.
+ *
+ * @param[in,out] loop Event loop.
+ * @param[out] id Event ID.
+ * @param[out] data Event data.
+ * @return 0 if an event was fetched, -1 if the queue is empty.
+ **************************************************************************/
+static int __neorv32_evloop_fetch(__neorv32_evloop_t *loop, uint32_t *id, uint32_t *data) {
+
+  __neorv32_evloop_entry_t *entry = &loop->queue[loop->head & (NEORV32_EVLOOP_QUEUE_SIZE - 1)];
+
+  if (entry->seq != (loop->head + 1)) {
+    return -1; // empty
+  }
+  *id = entry->id;
+  *data = entry->data;
+
+  // release entry for the position one lap ahead
+  asm volatile ("fence" ::: "memory");
+  entry->seq = loop->head + NEORV32_EVLOOP_QUEUE_SIZE;
+  loop->head++;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Private function: fast interrupt handler of all attached FIRQ channels.
+ * Disables the (level-triggered) interrupt source in MIE and posts the according event;
+ * the event loop re-enables the source after the callback has been executed.
+ **************************************************************************/
+static void __neorv32_evloop_firq_handler(void) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  uint32_t cause = neorv32_cpu_csr_read(CSR_MCAUSE) & 0x1f; // = MIE bit of the FIRQ
+  uint32_t channel = cause - CSR_MIE_FIRQ0E;
+
+  neorv32_rte_irq_disable(RTE_TRAP_FIRQ_0 + (int)channel); // keep disabled if held by handler nesting
+  if ((loop != NULL) && (loop->firq[channel] != 0)) {
+    if (__neorv32_evloop_put(loop, (loop->firq[channel] - 1) | EVLOOP_FIRQ_FLAG, channel)) {
+      loop->lost |= 1 << channel; // queue full: re-enable channel when the queue has been drained
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Setup (or reset) the event loop of the current core: clear event queue, callbacks
+ * and statistics.
+ *
+ * @note #neorv32_rte_setup() has to be called before.
+ *
+ * @return 0 if success, -1 if the current core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_setup(void) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  uint32_t i;
+
+  if (loop == NULL) {
+    return -1;
+  }
+
+  for (i=0; i<16; i++) {
+    if (loop->firq[i] != 0) {
+      neorv32_evloop_detach(i);
+    }
+  }
+
+  for (i=0; i<NEORV32_EVLOOP_QUEUE_SIZE; i++) {
+    loop->queue[i].seq = i;
+  }
+  for (i=0; i<NEORV32_EVLOOP_NUM_IDS; i++) {
+    loop->callback[i] = NULL;
+    loop->arg[i] = NULL;
+  }
+  loop->tail = 0;
+  loop->head = 0;
+  loop->lost = 0;
+  loop->stop = 0;
+  loop->dropped = 0;
+  loop->events = 0;
+  loop->idle = 0;
+  loop->start = neorv32_cpu_get_cycle();
+  asm volatile ("fence");
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Register callback for an event ID of the current core's event loop.
+ *
+ * @param[in] id Event ID (0..#NEORV32_EVLOOP_NUM_IDS-1).
+ * @param[in] callback Callback function; NULL to ignore events of this ID.
+ * @param[in] arg User argument that is passed to the callback.
+ * @return 0 if success, -1 if invalid ID or the current core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_register(int id, neorv32_evloop_callback_t callback, void *arg) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+
+  if ((loop == NULL) || (((uint32_t)id) >= NEORV32_EVLOOP_NUM_IDS)) {
+    return -1;
+  }
+
+  loop->arg[id] = arg;
+  loop->callback[id] = callback;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Post an event to the current core's event loop. Lock-free; can be called from
+ * interrupt handlers (of any priority) and from the event loop's callbacks.
+ *
+ * @param[in] id Event ID (0..#NEORV32_EVLOOP_NUM_IDS-1).
+ * @param[in] data Event data that is passed to the callback.
+ * @return 0 if success, -1 if invalid ID, queue full (event dropped) or the current
+ * core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_post(int id, uint32_t data) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+
+  if ((loop == NULL) || (((uint32_t)id) >= NEORV32_EVLOOP_NUM_IDS)) {
+    return -1;
+  }
+  return __neorv32_evloop_put(loop, (uint32_t)id, data);
+}
+
+
+/**********************************************************************//**
+ * Attach a fast interrupt request (FIRQ) channel to an event ID of the current core's
+ * event loop. The FIRQ handler disables the channel in MIE and posts an event (data =
+ * FIRQ channel); the channel is re-enabled after the callback has been executed. Hence,
+ * the callback has to service the device (e.g. read the UART RX FIFO or acknowledge the
+ * GPTMR interrupt), otherwise the event is posted again.
+ *
+ * @note The FIRQ handler is installed as fast handler with the highest priority (255)
+ * so it is never preempted and the RTE's nesting logic does not re-enable the channel.
+ * The channel is enabled in MIE by this function.
+ *
+ * @param[in] firq FIRQ channel (0..15), e.g. #UART0_RX_RTE_ID - #RTE_TRAP_FIRQ_0.
+ * @param[in] id Event ID (0..#NEORV32_EVLOOP_NUM_IDS-1).
+ * @return 0 if success, -1 if invalid channel, invalid ID or the current core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_attach(int firq, int id) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  int hart = (int)neorv32_cpu_csr_read(CSR_MHARTID);
+
+  if ((loop == NULL) || (((uint32_t)firq) > 15) || (((uint32_t)id) >= NEORV32_EVLOOP_NUM_IDS)) {
+    return -1;
+  }
+
+  loop->firq[firq] = (uint8_t)(id + 1);
+  neorv32_rte_handler_install_fast_hart(hart, RTE_TRAP_FIRQ_0 + firq, __neorv32_evloop_firq_handler);
+  neorv32_rte_irq_priority_set(hart, RTE_TRAP_FIRQ_0 + firq, 255);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << (CSR_MIE_FIRQ0E + firq));
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Detach a fast interrupt request (FIRQ) channel from the current core's event loop.
+ * The channel is disabled in MIE, the RTE's debug handler is re-installed and the
+ * channel's priority is set to 0.
+ *
+ * @note Events of this channel that are already queued are still dispatched.
+ *
+ * @param[in] firq FIRQ channel (0..15).
+ * @return 0 if success, -1 if invalid channel or the current core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_detach(int firq) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  int hart = (int)neorv32_cpu_csr_read(CSR_MHARTID);
+
+  if ((loop == NULL) || (((uint32_t)firq) > 15)) {
+    return -1;
+  }
+
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << (CSR_MIE_FIRQ0E + firq));
+  loop->firq[firq] = 0;
+  neorv32_rte_handler_install_hart(hart, RTE_TRAP_FIRQ_0 + firq, neorv32_rte_debug_handler);
+  neorv32_rte_irq_priority_set(hart, RTE_TRAP_FIRQ_0 + firq, 0);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Dispatch all pending events of the current core's event loop (non-blocking).
+ * Events without a registered callback are discarded.
+ *
+ * @note Events that are posted by the callbacks are dispatched in the same call.
+ *
+ * @return Number of dispatched events; -1 if the current core cannot use the RTE.
+ **************************************************************************/
+int neorv32_evloop_poll(void) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  neorv32_evloop_callback_t callback;
+  uint32_t id, data;
+  int num = 0;
+
+  if (loop == NULL) {
+    return -1;
+  }
+
+  while (__neorv32_evloop_fetch(loop, &id, &data) == 0) {
+    callback = loop->callback[id & ~EVLOOP_FIRQ_FLAG];
+    if (callback != NULL) {
+      callback(data, loop->arg[id & ~EVLOOP_FIRQ_FLAG]);
+    }
+    // re-enable interrupt source if it is still attached
+    if ((id & EVLOOP_FIRQ_FLAG) && (loop->firq[data] != 0)) {
+      neorv32_cpu_csr_set(CSR_MIE, 1 << (CSR_MIE_FIRQ0E + data));
+    }
+    loop->events++;
+    num++;
+  }
+
+  // re-enable channels whose event has been dropped (the level-triggered request is still pending)
+  if (loop->lost) {
+    uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    uint32_t lost = loop->lost;
+    loop->lost = 0;
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+    for (id=0; id<16; id++) {
+      if ((lost & (1 << id)) && (loop->firq[id] != 0)) {
+        neorv32_cpu_csr_set(CSR_MIE, 1 << (CSR_MIE_FIRQ0E + id));
+      }
+    }
+  }
+  return num;
+}
+
+
+/**********************************************************************//**
+ * Run the current core's event loop: dispatch events and put the core to sleep
+ * while the event queue is empty. Returns after #neorv32_evloop_stop() has been called.
+ *
+ * @note Interrupts have to be enabled globally (mstatus.MIE). The queue is checked with
+ * interrupts disabled right before executing WFI so no wake-up is lost.
+ **************************************************************************/
+void neorv32_evloop_run(void) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  __neorv32_evloop_entry_t *entry;
+  uint32_t mstatus;
+  uint64_t t0;
+
+  if (loop == NULL) {
+    return;
+  }
+
+  loop->stop = 0;
+  while (loop->stop == 0) {
+    neorv32_evloop_poll();
+
+    mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    entry = &loop->queue[loop->head & (NEORV32_EVLOOP_QUEUE_SIZE - 1)];
+    if ((entry->seq != (loop->head + 1)) && (loop->stop == 0)) {
+      t0 = neorv32_cpu_get_cycle();
+      neorv32_cpu_sleep(); // wakes up on any pending & enabled interrupt even if mstatus.MIE is cleared
+      loop->idle += neorv32_cpu_get_cycle() - t0;
+    }
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  }
+}
+
+
+/**********************************************************************//**
+ * Make the current core's event loop (#neorv32_evloop_run()) return after the
+ * current callback. Can be called from callbacks and interrupt handlers.
+ **************************************************************************/
+void neorv32_evloop_stop(void) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+
+  if (loop != NULL) {
+    loop->stop = 1;
+  }
+}
+
+
+/**********************************************************************//**
+ * Get statistics of the current core's event loop.
+ *
+ * @note Cycle counts are based on the CPU cycle counter (Zicntr ISA extension).
+ * Idle / (idle + busy) is the fraction of time the core has been sleeping.
+ *
+ * @param[out] stats Statistics (#neorv32_evloop_stats_t).
+ * @param[in] reset Reset statistics after reading them when non-zero.
+ **************************************************************************/
+void neorv32_evloop_get_stats(neorv32_evloop_stats_t *stats, int reset) {
+
+  __neorv32_evloop_t *loop = __neorv32_evloop_self();
+  uint64_t now = neorv32_cpu_get_cycle();
+
+  if (loop == NULL) {
+    return;
+  }
+
+  stats->idle = loop->idle;
+  stats->busy = (now - loop->start) - loop->idle;
+  stats->events = loop->events;
+  stats->dropped = loop->dropped;
+
+  if (reset) {
+    loop->idle = 0;
+    loop->start = now;
+    loop->events = 0;
+    loop->dropped = 0;
+  }
+}
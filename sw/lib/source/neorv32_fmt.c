@@ -0,0 +1,453 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_fmt.c
+ * @brief Lightweight string formatting engine source file.
+ *
+ * @note The output is rendered in a single pass into a buffer. Integers are
+ * converted without any division/multiplication so this is also fast on
+ * CPUs without the M/Zmmul ISA extension.
+ */
+
+#include <neorv32.h>
+#include <stdarg.h>
+
+
+/**********************************************************************//**
+ * Formatting engine state.
+ **************************************************************************/
+typedef struct {
+  char *buf;               /**< render buffer */
+  int size;                /**< render buffer capacity */
+  int pos;                 /**< current position in render buffer */
+  int total;               /**< total number of generated characters */
+  neorv32_fmt_sink_t sink; /**< flushes the render buffer; NULL: truncate */
+  void *ctx;               /**< sink context */
+  int options;             /**< formatting options (NEORV32_FMT_*) */
+} neorv32_fmt_state_t;
+
+
+/**********************************************************************//**
+ * Powers of ten for division-free decimal conversion.
+ **************************************************************************/
+static const uint64_t __neorv32_fmt_pow10[20] = {
+  10000000000000000000ULL, 1000000000000000000ULL, 100000000000000000ULL, 10000000000000000ULL,
+  1000000000000000ULL, 100000000000000ULL, 10000000000000ULL, 1000000000000ULL, 100000000000ULL,
+  10000000000ULL, 1000000000ULL, 100000000ULL, 10000000ULL, 1000000ULL, 100000ULL, 10000ULL,
+  1000ULL, 100ULL, 10ULL, 1ULL
+};
+
+
+/**********************************************************************//**
+ * Private function to append a single character.
+ *
+ * @param[in,out] st Engine state.
+ * @param[in] c Character.
+ **************************************************************************/
+static void __neorv32_fmt_put(neorv32_fmt_state_t *st, char c) {
+
+  if (st->pos >= st->size) { // render buffer full
+    if (st->sink == NULL) {
+      st->total++; // truncate
+      return;
+    }
+    st->sink(st->ctx, st->buf, st->pos);
+    st->pos = 0;
+  }
+  st->buf[st->pos++] = c;
+  st->total++;
+}
+
+
+/**********************************************************************//**
+ * Private function to append a character with optional line break conversion.
+ *
+ * @param[in,out] st Engine state.
+ * @param[in] c Character.
+ **************************************************************************/
+static void __neorv32_fmt_putc(neorv32_fmt_state_t *st, char c) {
+
+  if ((c == '\n') && (st->options & NEORV32_FMT_CRLF)) {
+    __neorv32_fmt_put(st, '\r');
+  }
+  __neorv32_fmt_put(st, c);
+}
+
+
+/**********************************************************************//**
+ * Private function to append a character several times.
+ *
+ * @param[in,out] st Engine state.
+ * @param[in] c Character.
+ * @param[in] n Number of repetitions (may be negative).
+ **************************************************************************/
+static void __neorv32_fmt_fill(neorv32_fmt_state_t *st, char c, int n) {
+
+  while (n-- > 0) {
+    __neorv32_fmt_put(st, c);
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function to convert an unsigned number to decimal (no division).
+ *
+ * @param[in,out] buffer Digits (MSB first, not terminated) [20 chars].
+ * @param[in] num Number to convert.
+ * @return Number of digits.
+ **************************************************************************/
+static int __neorv32_fmt_utoa(char *buffer, uint64_t num) {
+
+  int i, n = 0;
+  char d;
+
+  // 32-bit numbers only need 32-bit operations
+  i = ((uint32_t)(num >> 32) == 0) ? 10 : 0;
+
+  if (i == 10) {
+    uint32_t num32 = (uint32_t)num, p;
+    for (; i<19; i++) {
+      p = (uint32_t)__neorv32_fmt_pow10[i];
+      if ((num32 >= p) || (n != 0)) {
+        d = '0';
+        while (num32 >= p) {
+          num32 -= p;
+          d++;
+        }
+        buffer[n++] = d;
+      }
+    }
+    buffer[n++] = '0' + (char)num32;
+  }
+  else {
+    uint64_t p;
+    for (; i<19; i++) {
+      p = __neorv32_fmt_pow10[i];
+      if ((num >= p) || (n != 0)) {
+        d = '0';
+        while (num >= p) {
+          num -= p;
+          d++;
+        }
+        buffer[n++] = d;
+      }
+    }
+    buffer[n++] = '0' + (char)num;
+  }
+
+  return n;
+}
+
+
+/**********************************************************************//**
+ * Private function to convert an unsigned number to hexadecimal.
+ *
+ * @param[in,out] buffer Digits (MSB first, not terminated) [16 chars].
+ * @param[in] num Number to convert.
+ * @return Number of digits.
+ **************************************************************************/
+static int __neorv32_fmt_xtoa(char *buffer, uint64_t num) {
+
+  const char digits[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+  int i, n;
+
+  // number of significant digits
+  n = 1;
+  while ((n < 16) && (num >> (4*n))) {
+    n++;
+  }
+
+  for (i=n-1; i>=0; i--) {
+    buffer[i] = digits[num & 0xf];
+    num >>= 4;
+  }
+
+  return n;
+}
+
+
+/**********************************************************************//**
+ * Private formatting core.
+ *
+ * @param[in,out] st Engine state.
+ * @param[in] format Pointer to format string.
+ * @param[in] args A value identifying a variable arguments list.
+ **************************************************************************/
+static void __neorv32_fmt_core(neorv32_fmt_state_t *st, const char *format, va_list args) {
+
+  char c, sign, pad, digits[20];
+  const char *str;
+  int left, width, prec, is64, n;
+  uint64_t num;
+
+  while ((c = *format++)) {
+
+    if (c != '%') {
+      __neorv32_fmt_putc(st, c);
+      continue;
+    }
+
+    // flags
+    left = 0;
+    pad = ' ';
+    while (1) {
+      c = *format;
+      if (c == '-') {
+        left = 1;
+      }
+      else if (c == '0') {
+        pad = '0';
+      }
+      else {
+        break;
+      }
+      format++;
+    }
+
+    // field width
+    width = -1;
+    if (*format == '*') {
+      width = va_arg(args, int);
+      if (width < 0) {
+        left = 1;
+        width = -width;
+      }
+      format++;
+    }
+    else {
+      while ((*format >= '0') && (*format <= '9')) {
+        width = (width < 0) ? 0 : width;
+        width = (width << 3) + (width << 1) + (*format++ - '0');
+      }
+    }
+
+    // precision (strings only)
+    prec = -1;
+    if (*format == '.') {
+      format++;
+      prec = 0;
+      if (*format == '*') {
+        prec = va_arg(args, int);
+        format++;
+      }
+      else {
+        while ((*format >= '0') && (*format <= '9')) {
+          prec = (prec << 3) + (prec << 1) + (*format++ - '0');
+        }
+      }
+    }
+
+    // length modifier; "l" is 32-bit
+    is64 = 0;
+    while ((*format == 'l') || (*format == 'L')) {
+      is64 = (format[0] == format[1]) ? 1 : is64;
+      format++;
+    }
+
+    c = *format++;
+    if (c == '\0') {
+      break;
+    }
+    if ((c >= 'A') && (c <= 'Z')) {
+      c += 'a' - 'A';
+    }
+
+    sign = 0;
+    switch (c) {
+
+      case 's': // string
+        str = va_arg(args, const char*);
+        if (str == NULL) {
+          str = "(null)";
+        }
+        n = 0;
+        while (str[n] && ((prec < 0) || (n < prec))) {
+          n++;
+        }
+        width -= n;
+        if (!left) {
+          __neorv32_fmt_fill(st, ' ', width);
+        }
+        while (n--) {
+          __neorv32_fmt_putc(st, *str++);
+        }
+        if (left) {
+          __neorv32_fmt_fill(st, ' ', width);
+        }
+        continue;
+
+      case 'c': // char
+        if (!left) {
+          __neorv32_fmt_fill(st, ' ', width - 1);
+        }
+        __neorv32_fmt_putc(st, (char)va_arg(args, int));
+        if (left) {
+          __neorv32_fmt_fill(st, ' ', width - 1);
+        }
+        continue;
+
+      case 'i': // signed
+      case 'd':
+        if (is64) {
+          int64_t s64 = va_arg(args, int64_t);
+          sign = (s64 < 0) ? '-' : 0;
+          num = (s64 < 0) ? (0 - (uint64_t)s64) : (uint64_t)s64;
+        }
+        else {
+          int32_t s32 = va_arg(args, int32_t);
+          sign = (s32 < 0) ? '-' : 0;
+          num = (s32 < 0) ? (0 - (uint32_t)s32) : (uint32_t)s32;
+        }
+        n = __neorv32_fmt_utoa(digits, num);
+        break;
+
+      case 'u': // unsigned
+        num = is64 ? va_arg(args, uint64_t) : va_arg(args, uint32_t);
+        n = __neorv32_fmt_utoa(digits, num);
+        break;
+
+      case 'x': // hexadecimal
+      case 'p':
+        if (c == 'p') {
+          num = (uint32_t)(uintptr_t)va_arg(args, void*);
+          is64 = 0;
+        }
+        else {
+          num = is64 ? va_arg(args, uint64_t) : va_arg(args, uint32_t);
+        }
+        n = __neorv32_fmt_xtoa(digits, num);
+        if (width < 0) { // no width: print all digits with leading zeros
+          width = is64 ? 16 : 8;
+          pad = '0';
+        }
+        break;
+
+      case '%': // escaped percent sign
+        __neorv32_fmt_put(st, c);
+        continue;
+
+      default: // unsupported formatting character
+        __neorv32_fmt_put(st, '%');
+        __neorv32_fmt_putc(st, c);
+        continue;
+    }
+
+    // output number
+    width -= n + (sign ? 1 : 0);
+    if ((!left) && (pad == ' ')) {
+      __neorv32_fmt_fill(st, ' ', width);
+    }
+    if (sign) {
+      __neorv32_fmt_put(st, sign);
+    }
+    if ((!left) && (pad == '0')) {
+      __neorv32_fmt_fill(st, '0', width);
+    }
+    str = digits;
+    while (n--) {
+      __neorv32_fmt_put(st, *str++);
+    }
+    if (left) {
+      __neorv32_fmt_fill(st, ' ', width);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Custom version of 'vprintf': render formatted string and pass it block-wise
+ * to an output sink.
+ *
+ * @note Supported conversions: %s, %c, %d/%i, %u, %x, %p and %%. Flags '-' (left-justify)
+ * and '0' (zero-padding), field width (also '*'), precision for %s and the "ll" length
+ * modifier for 64-bit integers are supported. Without field width %x and %p print
+ * all digits with leading zeros (8 digits; 16 digits for %llx).
+ *
+ * @param[in] sink Output function; called every #NEORV32_FMT_BUF_SIZE characters and at the end.
+ * @param[in,out] ctx Sink context (passed to sink).
+ * @param[in] options Formatting options (NEORV32_FMT_*, e.g. #NEORV32_FMT_CRLF).
+ * @param[in] format Pointer to format string.
+ * @param[in] args A value identifying a variable arguments list.
+ * @return Number of characters passed to the sink.
+ **************************************************************************/
+int neorv32_fmt_vprintf(neorv32_fmt_sink_t sink, void *ctx, int options, const char *format, va_list args) {
+
+  char buf[NEORV32_FMT_BUF_SIZE];
+  neorv32_fmt_state_t st;
+
+  st.buf     = buf;
+  st.size    = (int)sizeof(buf);
+  st.pos     = 0;
+  st.total   = 0;
+  st.sink    = sink;
+  st.ctx     = ctx;
+  st.options = options;
+
+  __neorv32_fmt_core(&st, format, args);
+
+  if (st.pos) {
+    sink(ctx, buf, st.pos);
+  }
+  return st.total;
+}
+
+
+/**********************************************************************//**
+ * Custom version of 'vsnprintf': render formatted string to memory.
+ *
+ * @note See #neorv32_fmt_vprintf() for the supported formatting features.
+ *
+ * @param[in,out] buffer Destination buffer; result is always zero-terminated (if size > 0).
+ * @param[in] size Size of destination buffer in bytes.
+ * @param[in] format Pointer to format string.
+ * @param[in] args A value identifying a variable arguments list.
+ * @return Number of characters (excluding zero-termination) that would have been written
+ * if the buffer was large enough.
+ **************************************************************************/
+int neorv32_fmt_vsnprintf(char *buffer, int size, const char *format, va_list args) {
+
+  neorv32_fmt_state_t st;
+
+  st.buf     = buffer;
+  st.size    = (size > 0) ? (size - 1) : 0;
+  st.pos     = 0;
+  st.total   = 0;
+  st.sink    = NULL;
+  st.ctx     = NULL;
+  st.options = 0;
+
+  __neorv32_fmt_core(&st, format, args);
+
+  if (size > 0) {
+    buffer[st.pos] = '\0';
+  }
+  return st.total;
+}
+
+
+/**********************************************************************//**
+ * Custom version of 'snprintf': render formatted string to memory.
+ *
+ * @note See #neorv32_fmt_vprintf() for the supported formatting features.
+ *
+ * @param[in,out] buffer Destination buffer; result is always zero-terminated (if size > 0).
+ * @param[in] size Size of destination buffer in bytes.
+ * @param[in] format Pointer to format string.
+ * @return Number of characters (excluding zero-termination) that would have been written
+ * if the buffer was large enough.
+ **************************************************************************/
+int neorv32_fmt_snprintf(char *buffer, int size, const char *format, ...) {
+
+  int rc;
+  va_list args;
+  va_start(args, format);
+  rc = neorv32_fmt_vsnprintf(buffer, size, format, args);
+  va_end(args);
+  return rc;
+}
@@ -0,0 +1,734 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_kernel.c
+ * @brief Lightweight preemptive multitasking kernel source file.
+ *
+ * @note All scheduling decisions are deferred to the machine software interrupt (like
+ * a "PendSV" exception): any code that makes a higher-priority task ready just sets the
+ * core's CLINT MSI. The MSI handler selects the next task and exchanges the interrupted
+ * context with the one of the selected task. The MSI must therefore have the lowest
+ * RTE interrupt priority (0, default) so it never preempts another interrupt handler.
+ */
+
+#include <neorv32.h>
+#include <string.h>
+
+#if (NEORV32_KERNEL_PRIOS < 1) || (NEORV32_KERNEL_PRIOS > 32)
+#error "NEORV32_KERNEL_PRIOS has to be 1..32"
+#endif
+
+
+/**********************************************************************//**
+ * Scheduler of one core.
+ **************************************************************************/
+typedef struct {
+  neorv32_kernel_task_t *current;                       /**< running task */
+  neorv32_kernel_task_t *head[NEORV32_KERNEL_PRIOS];    /**< run queue of each priority (first task) */
+  neorv32_kernel_task_t *tail[NEORV32_KERNEL_PRIOS];    /**< run queue of each priority (last task) */
+  uint32_t              ready;                          /**< non-empty run queues (bit mask) */
+  uint32_t              rotate;                         /**< move current task to the end of its run queue */
+  uint32_t              switches;                       /**< total number of context switches */
+  neorv32_kernel_task_t idle;                           /**< idle task (context that has started the kernel) */
+  neorv32_swtimer_t     slice;                          /**< time slice timer */
+} __neorv32_kernel_sched_t;
+
+
+/**********************************************************************//**
+ * Scheduler of each core.
+ **************************************************************************/
+static __neorv32_kernel_sched_t __neorv32_kernel_sched[NEORV32_RTE_MAX_HARTS];
+
+
+/**********************************************************************//**
+ * Private function: enter critical section (disable interrupts).
+ *
+ * @return Previous mstatus.
+ **************************************************************************/
+static inline uint32_t __neorv32_kernel_enter(void) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  return mstatus;
+}
+
+
+/**********************************************************************//**
+ * Private function: leave critical section.
+ *
+ * @param[in] mstatus Previous mstatus.
+ **************************************************************************/
+static inline void __neorv32_kernel_leave(uint32_t mstatus) {
+
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+}
+
+
+/**********************************************************************//**
+ * Private function: check if the calling task is allowed to block.
+ *
+ * @note Blocking is not possible in handler context: if interrupts are disabled or if
+ * the caller is a nested handler, which is executed with mstatus.MIE set (see
+ * #neorv32_rte_irq_nesting()).
+ *
+ * @param[in] mstatus Previous mstatus (returned by #__neorv32_kernel_enter()).
+ * @return 1 if blocking is possible, 0 if not.
+ **************************************************************************/
+static inline int __neorv32_kernel_may_block(uint32_t mstatus) {
+
+  return ((mstatus & (1 << CSR_MSTATUS_MIE)) != 0) && (neorv32_rte_irq_nesting() == 0);
+}
+
+
+/**********************************************************************//**
+ * Private function: get scheduler of the calling core.
+ *
+ * @return Scheduler.
+ **************************************************************************/
+static inline __neorv32_kernel_sched_t *__neorv32_kernel_get(void) {
+
+  return &__neorv32_kernel_sched[neorv32_cpu_csr_read(CSR_MHARTID)];
+}
+
+
+/**********************************************************************//**
+ * Private function: request rescheduling (set machine software interrupt of the calling core).
+ **************************************************************************/
+static inline void __neorv32_kernel_pend(void) {
+
+  neorv32_clint_msi_set((int)neorv32_cpu_csr_read(CSR_MHARTID));
+}
+
+
+/**********************************************************************//**
+ * Private function: effective priority of a task (idle task is below all others).
+ *
+ * @param[in] s Scheduler.
+ * @param[in] task Task.
+ * @return Priority.
+ **************************************************************************/
+static inline int __neorv32_kernel_prio(__neorv32_kernel_sched_t *s, neorv32_kernel_task_t *task) {
+
+  return (task == &s->idle) ? -1 : (int)task->prio;
+}
+
+
+/**********************************************************************//**
+ * Private function: add task to a run queue.
+ *
+ * @param[in,out] s Scheduler.
+ * @param[in,out] task Task.
+ * @param[in] front Add to the beginning (1) or to the end (0) of the queue.
+ **************************************************************************/
+static void __neorv32_kernel_enqueue(__neorv32_kernel_sched_t *s, neorv32_kernel_task_t *task, int front) {
+
+  uint32_t p = task->prio;
+
+  if (s->head[p] == NULL) {
+    task->next = NULL;
+    s->head[p] = task;
+    s->tail[p] = task;
+    s->ready |= 1u << p;
+  }
+  else if (front) {
+    task->next = s->head[p];
+    s->head[p] = task;
+  }
+  else {
+    task->next = NULL;
+    s->tail[p]->next = task;
+    s->tail[p] = task;
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: remove first task of a run queue.
+ *
+ * @param[in,out] s Scheduler.
+ * @param[in] p Priority (queue must not be empty).
+ * @return Task.
+ **************************************************************************/
+static neorv32_kernel_task_t *__neorv32_kernel_dequeue(__neorv32_kernel_sched_t *s, int p) {
+
+  neorv32_kernel_task_t *task = s->head[p];
+
+  s->head[p] = task->next;
+  if (s->head[p] == NULL) {
+    s->ready &= ~(1u << p);
+  }
+  task->next = NULL;
+  return task;
+}
+
+
+/**********************************************************************//**
+ * Private function: highest priority of all ready tasks.
+ *
+ * @param[in] s Scheduler.
+ * @return Priority or -1 if no task is ready.
+ **************************************************************************/
+static inline int __neorv32_kernel_highest(__neorv32_kernel_sched_t *s) {
+
+  return (s->ready == 0) ? -1 : (31 - __builtin_clz(s->ready));
+}
+
+
+/**********************************************************************//**
+ * Private function: make a blocked task ready. Has to be called with interrupts disabled.
+ *
+ * @param[in,out] task Task (already removed from its wait list).
+ * @param[in] result Result of the blocking operation.
+ **************************************************************************/
+static void __neorv32_kernel_wake(neorv32_kernel_task_t *task, int result) {
+
+  __neorv32_kernel_sched_t *s = &__neorv32_kernel_sched[task->hart];
+
+  neorv32_swtimer_stop(&task->timer);
+  task->wait   = NULL;
+  task->result = (int8_t)result;
+  task->state  = KERNEL_STATE_READY;
+
+  // the task might not have been switched out yet
+  if (task != s->current) {
+    __neorv32_kernel_enqueue(s, task, 0);
+    if ((int)task->prio > __neorv32_kernel_prio(s, s->current)) {
+      __neorv32_kernel_pend();
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: add task to a wait list (ordered by priority, FIFO for equal priorities).
+ *
+ * @param[in,out] list Wait list.
+ * @param[in,out] task Task.
+ **************************************************************************/
+static void __neorv32_kernel_wait_insert(neorv32_kernel_task_t **list, neorv32_kernel_task_t *task) {
+
+  while ((*list != NULL) && ((*list)->prio >= task->prio)) {
+    list = &(*list)->next;
+  }
+  task->next = *list;
+  *list = task;
+}
+
+
+/**********************************************************************//**
+ * Private function: remove first task of a wait list.
+ *
+ * @param[in,out] list Wait list (must not be empty).
+ * @return Task.
+ **************************************************************************/
+static neorv32_kernel_task_t *__neorv32_kernel_wait_pop(neorv32_kernel_task_t **list) {
+
+  neorv32_kernel_task_t *task = *list;
+  *list = task->next;
+  task->next = NULL;
+  return task;
+}
+
+
+/**********************************************************************//**
+ * Private function: timeout of a blocked task (software timer callback, interrupt context).
+ *
+ * @param[in,out] arg Task.
+ **************************************************************************/
+static void __neorv32_kernel_timeout(void *arg) {
+
+  neorv32_kernel_task_t *task = (neorv32_kernel_task_t*)arg;
+  neorv32_kernel_task_t **list = task->wait;
+
+  if (task->state != KERNEL_STATE_BLOCKED) {
+    return;
+  }
+  if (list != NULL) {
+    while (*list != task) {
+      list = &(*list)->next;
+    }
+    *list = task->next;
+  }
+  __neorv32_kernel_wake(task, -1);
+}
+
+
+/**********************************************************************//**
+ * Private function: block the calling task. Has to be called with interrupts disabled;
+ * returns after the task has been woken up.
+ *
+ * @param[in,out] list Wait list (NULL = sleep).
+ * @param[in] deadline Absolute timeout (MTIME) or #NEORV32_KERNEL_FOREVER.
+ * @param[in] mstatus mstatus to be restored (interrupts have to be enabled).
+ * @return 0 if woken up by the object, -1 if timeout.
+ **************************************************************************/
+static int __neorv32_kernel_block(neorv32_kernel_task_t **list, uint64_t deadline, uint32_t mstatus) {
+
+  neorv32_kernel_task_t *task = __neorv32_kernel_get()->current;
+
+  task->state  = KERNEL_STATE_BLOCKED;
+  task->result = 0;
+  task->wait   = list;
+  if (list != NULL) {
+    __neorv32_kernel_wait_insert(list, task);
+  }
+  if (deadline != NEORV32_KERNEL_FOREVER) {
+    neorv32_swtimer_start_at(&task->timer, deadline, 0);
+  }
+  __neorv32_kernel_pend();
+  __neorv32_kernel_leave(mstatus);
+
+  // wait until the MSI has been taken (and the task has been resumed)
+  while (*(volatile uint8_t*)&task->state == KERNEL_STATE_BLOCKED);
+
+  return task->result;
+}
+
+
+/**********************************************************************//**
+ * Private function: convert timeout into an absolute deadline.
+ *
+ * @param[in] timeout Timeout in MTIME ticks or #NEORV32_KERNEL_FOREVER.
+ * @return Deadline.
+ **************************************************************************/
+static uint64_t __neorv32_kernel_deadline(uint64_t timeout) {
+
+  if (timeout == NEORV32_KERNEL_FOREVER) {
+    return NEORV32_KERNEL_FOREVER;
+  }
+  return neorv32_clint_time_get() + timeout;
+}
+
+
+/**********************************************************************//**
+ * Private function: machine software interrupt handler - the actual scheduler.
+ **************************************************************************/
+static void __neorv32_kernel_switch(void) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_kernel_sched_t *s = &__neorv32_kernel_sched[hart];
+  neorv32_kernel_task_t *cur, *next = NULL;
+  uint32_t mstatus;
+  int p;
+
+  // interrupts might have been enabled by the RTE for higher-priority sources
+  mstatus = __neorv32_kernel_enter();
+  neorv32_clint_msi_clr((int)hart);
+
+  cur = s->current;
+  p = __neorv32_kernel_highest(s);
+  if (cur->state != KERNEL_STATE_READY) {
+    next = (p < 0) ? &s->idle : __neorv32_kernel_dequeue(s, p);
+  }
+  else if ((p > __neorv32_kernel_prio(s, cur)) || (s->rotate && (p >= 0) && (p == __neorv32_kernel_prio(s, cur)))) {
+    next = __neorv32_kernel_dequeue(s, p);
+    if (cur != &s->idle) {
+      __neorv32_kernel_enqueue(s, cur, s->rotate ? 0 : 1); // preempted: continue first
+    }
+  }
+  s->rotate = 0;
+
+  if (next == NULL) {
+    __neorv32_kernel_leave(mstatus);
+    return;
+  }
+
+  s->current = next;
+  next->switches++;
+  s->switches++;
+  __neorv32_kernel_leave(mstatus);
+
+  neorv32_rte_context_switch(cur->context, next->context);
+}
+
+
+/**********************************************************************//**
+ * Private function: time slice timer callback (interrupt context).
+ *
+ * @param[in] arg Scheduler.
+ **************************************************************************/
+static void __neorv32_kernel_tick(void *arg) {
+
+  __neorv32_kernel_sched_t *s = (__neorv32_kernel_sched_t*)arg;
+
+  if ((s->current != &s->idle) && (s->ready & (1u << s->current->prio))) {
+    s->rotate = 1;
+    __neorv32_kernel_pend();
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: return address of task functions.
+ **************************************************************************/
+static void __neorv32_kernel_task_exit(void) {
+
+  neorv32_kernel_task_t *task;
+  uint32_t mstatus = __neorv32_kernel_enter();
+
+  task = __neorv32_kernel_get()->current;
+  task->state = KERNEL_STATE_DONE;
+  __neorv32_kernel_pend();
+  __neorv32_kernel_leave(mstatus);
+
+  while (1); // never resumed
+}
+
+
+/**********************************************************************//**
+ * Setup the kernel for the calling core. This also sets up the software timer
+ * service (#neorv32_swtimer_setup()) of the calling core.
+ *
+ * @note Each core that runs tasks has to call this function once (after #neorv32_rte_setup()).
+ * The kernel uses the core's machine software interrupt and MTIMECMP.
+ *
+ * @param[in] slice Time slice for tasks of equal priority in MTIME ticks (0 = no time slicing).
+ * @return 0 if success, -1 if CLINT not available or invalid core.
+ **************************************************************************/
+int neorv32_kernel_setup(uint64_t slice) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_kernel_sched_t *s;
+  int i;
+
+  if ((hart >= NEORV32_RTE_MAX_HARTS) || neorv32_swtimer_setup()) {
+    return -1;
+  }
+
+  s = &__neorv32_kernel_sched[hart];
+  for (i=0; i<NEORV32_KERNEL_PRIOS; i++) {
+    s->head[i] = NULL;
+    s->tail[i] = NULL;
+  }
+  s->ready    = 0;
+  s->rotate   = 0;
+  s->switches = 0;
+
+  // the calling context becomes the idle task
+  memset(&s->idle, 0, sizeof(neorv32_kernel_task_t));
+  s->idle.name  = "idle";
+  s->idle.hart  = (uint8_t)hart;
+  s->idle.state = KERNEL_STATE_READY;
+  s->current    = &s->idle;
+
+  neorv32_swtimer_init(&s->slice, __neorv32_kernel_tick, s);
+  if (slice != 0) {
+    neorv32_swtimer_start(&s->slice, slice, slice);
+  }
+
+  neorv32_clint_msi_clr((int)hart);
+  neorv32_rte_handler_install_hart((int)hart, RTE_TRAP_MSI, __neorv32_kernel_switch);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MSIE);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Create a task on the calling core. Can also be called by a running task.
+ *
+ * @param[in,out] task Task control block.
+ * @param[in] entry Task function; returning from it terminates the task.
+ * @param[in] arg Argument for the task function.
+ * @param[in,out] stack Stack memory. If no ISR stack is used, this also has to provide space
+ * for the RTE trap frames (at least 128 bytes plus nested interrupts).
+ * @param[in] stack_size Size of the stack memory in bytes.
+ * @param[in] prio Priority (0..#NEORV32_KERNEL_PRIOS-1, higher value = higher priority).
+ * @param[in] name Task name (can be NULL).
+ * @return 0 if success, -1 if invalid arguments or kernel not set up on this core.
+ **************************************************************************/
+int neorv32_kernel_task_create(neorv32_kernel_task_t *task, void (*entry)(void *arg), void *arg,
+                               void *stack, uint32_t stack_size, int prio, const char *name) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_kernel_sched_t *s;
+  uint32_t gp, mstatus;
+
+  if ((hart >= NEORV32_RTE_MAX_HARTS) || (__neorv32_kernel_sched[hart].current == NULL) ||
+      (prio < 0) || (prio >= NEORV32_KERNEL_PRIOS) || (stack == NULL) || (stack_size < 256)) {
+    return -1;
+  }
+  s = &__neorv32_kernel_sched[hart];
+
+  // initial context: start at entry with a0 = arg, returning to the exit function
+  asm volatile ("mv %[dst], gp" : [dst] "=r" (gp));
+  memset(task, 0, sizeof(neorv32_kernel_task_t));
+  task->context[0]  = (uint32_t)entry;
+  task->context[1]  = (uint32_t)&__neorv32_kernel_task_exit;
+  task->context[2]  = ((uint32_t)stack + stack_size) & ~15u; // 16-byte aligned stack pointer
+  task->context[3]  = gp;
+  task->context[10] = (uint32_t)arg;
+
+  task->name  = name;
+  task->prio  = (uint8_t)prio;
+  task->hart  = (uint8_t)hart;
+  task->state = KERNEL_STATE_READY;
+  neorv32_swtimer_init(&task->timer, __neorv32_kernel_timeout, task);
+
+  mstatus = __neorv32_kernel_enter();
+  __neorv32_kernel_enqueue(s, task, 0);
+  if (prio > __neorv32_kernel_prio(s, s->current)) {
+    __neorv32_kernel_pend();
+  }
+  __neorv32_kernel_leave(mstatus);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Start multitasking on the calling core. The calling context becomes the idle task,
+ * which puts the CPU to sleep mode whenever no other task is ready.
+ *
+ * @note Enables interrupts globally. This function does not return.
+ **************************************************************************/
+void neorv32_kernel_start(void) {
+
+  __neorv32_kernel_pend();
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  while (1) {
+    neorv32_cpu_sleep();
+  }
+}
+
+
+/**********************************************************************//**
+ * Get the running task of the calling core.
+ *
+ * @return Task control block (the idle task's one if no other task is running).
+ **************************************************************************/
+neorv32_kernel_task_t *neorv32_kernel_self(void) {
+
+  return __neorv32_kernel_get()->current;
+}
+
+
+/**********************************************************************//**
+ * Get number of context switches of the calling core.
+ *
+ * @return Number of context switches since #neorv32_kernel_setup().
+ **************************************************************************/
+uint32_t neorv32_kernel_get_switches(void) {
+
+  return __neorv32_kernel_get()->switches;
+}
+
+
+/**********************************************************************//**
+ * Pass the CPU to the next ready task of the same (or higher) priority.
+ **************************************************************************/
+void neorv32_kernel_yield(void) {
+
+  uint32_t mstatus = __neorv32_kernel_enter();
+  __neorv32_kernel_get()->rotate = 1;
+  __neorv32_kernel_pend();
+  __neorv32_kernel_leave(mstatus);
+}
+
+
+/**********************************************************************//**
+ * Suspend the calling task for a specific time.
+ *
+ * @param[in] ticks Time in MTIME ticks.
+ **************************************************************************/
+void neorv32_kernel_sleep(uint64_t ticks) {
+
+  neorv32_kernel_sleep_until(neorv32_clint_time_get() + ticks);
+}
+
+
+/**********************************************************************//**
+ * Suspend the calling task until a specific time (drift-free periodic tasks).
+ *
+ * @note Returns immediately if called from an interrupt handler (including nested
+ * handlers) or with interrupts disabled.
+ *
+ * @param[in] time Wake-up time (MTIME).
+ **************************************************************************/
+void neorv32_kernel_sleep_until(uint64_t time) {
+
+  uint32_t mstatus = __neorv32_kernel_enter();
+  if (__neorv32_kernel_may_block(mstatus)) {
+    __neorv32_kernel_block(NULL, time, mstatus);
+  }
+  else {
+    __neorv32_kernel_leave(mstatus);
+  }
+}
+
+
+/**********************************************************************//**
+ * Initialize a counting semaphore.
+ *
+ * @param[in,out] sem Semaphore.
+ * @param[in] count Initial count.
+ **************************************************************************/
+void neorv32_kernel_sem_init(neorv32_kernel_sem_t *sem, uint32_t count) {
+
+  sem->count = count;
+  sem->wait  = NULL;
+}
+
+
+/**********************************************************************//**
+ * Decrement semaphore; wait if it is zero.
+ *
+ * @note Never blocks if called from an interrupt handler (including nested handlers) or
+ * with interrupts disabled.
+ *
+ * @param[in,out] sem Semaphore.
+ * @param[in] timeout Maximum waiting time in MTIME ticks (0 = do not wait, #NEORV32_KERNEL_FOREVER).
+ * @return 0 if success, -1 if timeout.
+ **************************************************************************/
+int neorv32_kernel_sem_wait(neorv32_kernel_sem_t *sem, uint64_t timeout) {
+
+  uint32_t mstatus = __neorv32_kernel_enter();
+
+  if (sem->count != 0) {
+    sem->count--;
+    __neorv32_kernel_leave(mstatus);
+    return 0;
+  }
+  if ((timeout == 0) || (__neorv32_kernel_may_block(mstatus) == 0)) {
+    __neorv32_kernel_leave(mstatus);
+    return -1;
+  }
+
+  // a post hands the count over to the highest-priority waiting task
+  return __neorv32_kernel_block(&sem->wait, __neorv32_kernel_deadline(timeout), mstatus);
+}
+
+
+/**********************************************************************//**
+ * Increment semaphore or wake up the highest-priority waiting task.
+ * Can be used from interrupt handlers.
+ *
+ * @param[in,out] sem Semaphore.
+ **************************************************************************/
+void neorv32_kernel_sem_post(neorv32_kernel_sem_t *sem) {
+
+  uint32_t mstatus = __neorv32_kernel_enter();
+
+  if (sem->wait != NULL) {
+    __neorv32_kernel_wake(__neorv32_kernel_wait_pop(&sem->wait), 0);
+  }
+  else {
+    sem->count++;
+  }
+  __neorv32_kernel_leave(mstatus);
+}
+
+
+/**********************************************************************//**
+ * Initialize a message queue.
+ *
+ * @param[in,out] queue Queue.
+ * @param[in,out] buf Item storage (at least size * num bytes).
+ * @param[in] size Item size in bytes.
+ * @param[in] num Capacity (number of items).
+ * @return 0 if success, -1 if invalid arguments.
+ **************************************************************************/
+int neorv32_kernel_queue_init(neorv32_kernel_queue_t *queue, void *buf, uint32_t size, uint32_t num) {
+
+  if ((buf == NULL) || (size == 0) || (num == 0)) {
+    return -1;
+  }
+
+  queue->buf       = (uint8_t*)buf;
+  queue->size      = size;
+  queue->num       = num;
+  queue->head      = 0;
+  queue->count     = 0;
+  queue->wait_send = NULL;
+  queue->wait_recv = NULL;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Copy an item to the end of a message queue; wait if the queue is full.
+ *
+ * @note Never blocks if called from an interrupt handler (including nested handlers) or
+ * with interrupts disabled.
+ *
+ * @param[in,out] queue Queue.
+ * @param[in] item Item (queue->size bytes).
+ * @param[in] timeout Maximum waiting time in MTIME ticks (0 = do not wait, #NEORV32_KERNEL_FOREVER).
+ * @return 0 if success, -1 if timeout.
+ **************************************************************************/
+int neorv32_kernel_queue_send(neorv32_kernel_queue_t *queue, const void *item, uint64_t timeout) {
+
+  uint64_t deadline = __neorv32_kernel_deadline(timeout);
+  uint32_t mstatus, idx;
+
+  while (1) {
+    mstatus = __neorv32_kernel_enter();
+    if (queue->count < queue->num) {
+      idx = queue->head + queue->count;
+      if (idx >= queue->num) {
+        idx -= queue->num;
+      }
+      memcpy(queue->buf + idx * queue->size, item, queue->size);
+      queue->count++;
+      if (queue->wait_recv != NULL) {
+        __neorv32_kernel_wake(__neorv32_kernel_wait_pop(&queue->wait_recv), 0);
+      }
+      __neorv32_kernel_leave(mstatus);
+      return 0;
+    }
+    if ((timeout == 0) || (__neorv32_kernel_may_block(mstatus) == 0)) {
+      __neorv32_kernel_leave(mstatus);
+      return -1;
+    }
+    if (__neorv32_kernel_block(&queue->wait_send, deadline, mstatus)) {
+      return -1;
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Copy the first item out of a message queue; wait if the queue is empty.
+ *
+ * @note Never blocks if called from an interrupt handler (including nested handlers) or
+ * with interrupts disabled.
+ *
+ * @param[in,out] queue Queue.
+ * @param[out] item Item buffer (queue->size bytes).
+ * @param[in] timeout Maximum waiting time in MTIME ticks (0 = do not wait, #NEORV32_KERNEL_FOREVER).
+ * @return 0 if success, -1 if timeout.
+ **************************************************************************/
+int neorv32_kernel_queue_recv(neorv32_kernel_queue_t *queue, void *item, uint64_t timeout) {
+
+  uint64_t deadline = __neorv32_kernel_deadline(timeout);
+  uint32_t mstatus;
+
+  while (1) {
+    mstatus = __neorv32_kernel_enter();
+    if (queue->count != 0) {
+      memcpy(item, queue->buf + queue->head * queue->size, queue->size);
+      queue->head++;
+      if (queue->head >= queue->num) {
+        queue->head = 0;
+      }
+      queue->count--;
+      if (queue->wait_send != NULL) {
+        __neorv32_kernel_wake(__neorv32_kernel_wait_pop(&queue->wait_send), 0);
+      }
+      __neorv32_kernel_leave(mstatus);
+      return 0;
+    }
+    if ((timeout == 0) || (__neorv32_kernel_may_block(mstatus) == 0)) {
+      __neorv32_kernel_leave(mstatus);
+      return -1;
+    }
+    if (__neorv32_kernel_block(&queue->wait_recv, deadline, mstatus)) {
+      return -1;
+    }
+  }
+}
@@ -0,0 +1,191 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_log.c
+ * @brief Deferred binary logging source file.
+ *
+ * @note Records are stored in a RAM ring buffer and sent in the background by the
+ * UART TX interrupt (little-endian words): header word (#NEORV32_LOG_SYNC,
+ * number of arguments, format string ID), mcycle time stamp, arguments.
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * Log ring buffer.
+ **************************************************************************/
+static struct {
+  neorv32_uart_t *uart;   /**< output UART */
+  uint32_t *buf;          /**< ring buffer (words) */
+  uint32_t mask;          /**< ring buffer size in bytes - 1 */
+  volatile uint32_t head; /**< write index (bytes, free-running), written by neorv32_log_write */
+  volatile uint32_t tail; /**< read index (bytes, free-running), written by TX interrupt handler */
+  uint32_t dropped;       /**< number of discarded records */
+  uint32_t firq;          /**< UART TX interrupt MIE bit */
+  int cycle;              /**< mcycle available */
+} __neorv32_log;
+
+
+/**********************************************************************//**
+ * Private function to move data from the ring buffer to the TX FIFO.
+ **************************************************************************/
+static void __neorv32_log_tx_service(void) {
+
+  neorv32_uart_t *UARTx = __neorv32_log.uart;
+  const uint8_t *buf = (const uint8_t*)__neorv32_log.buf;
+  uint32_t tail = __neorv32_log.tail;
+  uint32_t head = __neorv32_log.head;
+
+  while ((tail != head) && ((UARTx->CTRL & (1 << UART_CTRL_TX_FULL)) == 0)) {
+    UARTx->DATA = (uint32_t)buf[tail & __neorv32_log.mask] << UART_DATA_RTX_LSB;
+    tail++;
+  }
+  __neorv32_log.tail = tail;
+
+  // no more data: stop TX interrupt (re-enabled by neorv32_log_write)
+  if (tail == head) {
+    UARTx->CTRL &= ~((uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF));
+  }
+}
+
+
+/**********************************************************************//**
+ * Setup deferred logging.
+ *
+ * @note The UART has to be configured via #neorv32_uart_setup() before. Its TX interrupt
+ * is used exclusively by the logging system (a fast RTE handler is installed and the
+ * interrupt is enabled in MIE of the calling core). Interrupts have to be enabled globally
+ * by the application.
+ *
+ * @warning The logging system is not thread-safe across cores; log from a single core only.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] buffer Memory for the ring buffer (word-aligned).
+ * @param[in] size Size of buffer in bytes; has to be a power of two and at least 64.
+ * @return 0 if success, -1 if UART not available or invalid buffer size.
+ **************************************************************************/
+int neorv32_log_setup(neorv32_uart_t *UARTx, uint32_t *buffer, int size) {
+
+  if ((neorv32_uart_available(UARTx) == 0) || (buffer == NULL) || (size < 64) || (size & (size - 1))) {
+    return -1;
+  }
+
+  int rte_id;
+  if (((uint32_t)UARTx) == NEORV32_UART1_BASE) {
+    rte_id = UART1_TX_RTE_ID;
+    __neorv32_log.firq = 1 << UART1_TX_FIRQ_ENABLE;
+  }
+  else {
+    rte_id = UART0_TX_RTE_ID;
+    __neorv32_log.firq = 1 << UART0_TX_FIRQ_ENABLE;
+  }
+
+  neorv32_cpu_csr_clr(CSR_MIE, __neorv32_log.firq);
+  UARTx->CTRL &= ~((uint32_t)((1 << UART_CTRL_IRQ_TX_EMPTY) | (1 << UART_CTRL_IRQ_TX_NHALF)));
+
+  __neorv32_log.uart    = UARTx;
+  __neorv32_log.buf     = buffer;
+  __neorv32_log.mask    = (uint32_t)(size - 1);
+  __neorv32_log.head    = 0;
+  __neorv32_log.tail    = 0;
+  __neorv32_log.dropped = 0;
+  __neorv32_log.cycle   = (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) ? 1 : 0;
+
+  neorv32_rte_handler_install_fast(rte_id, __neorv32_log_tx_service);
+  neorv32_cpu_csr_set(CSR_MIE, __neorv32_log.firq);
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Store a log record. Use the #NEORV32_LOG() macro instead of calling this directly.
+ *
+ * @note The record is discarded if there is not enough space left in the ring buffer.
+ *
+ * @param[in] id Format string ID (address in ".neorv32_log" section).
+ * @param[in] args Arguments.
+ * @param[in] num Number of arguments (0..#NEORV32_LOG_MAX_ARGS).
+ **************************************************************************/
+void neorv32_log_write(uint32_t id, const uint32_t *args, int num) {
+
+  uint32_t *buf = __neorv32_log.buf;
+  uint32_t mask = __neorv32_log.mask >> 2; // word index mask
+  uint32_t time = 0, head, idx;
+
+  if (buf == NULL) { // not initialized
+    return;
+  }
+  if (__neorv32_log.cycle) {
+    time = neorv32_cpu_csr_read(CSR_MCYCLE);
+  }
+  num = (num > NEORV32_LOG_MAX_ARGS) ? NEORV32_LOG_MAX_ARGS : num;
+
+  // enter critical section
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  head = __neorv32_log.head;
+  if ((head - __neorv32_log.tail) + (uint32_t)((num + 2) * 4) > (__neorv32_log.mask + 1)) {
+    __neorv32_log.dropped++;
+  }
+  else {
+    idx = head >> 2;
+    buf[idx++ & mask] = (id << NEORV32_LOG_ID_LSB) | ((uint32_t)num << NEORV32_LOG_NUM_LSB) | NEORV32_LOG_SYNC;
+    buf[idx++ & mask] = time;
+    while (num--) {
+      buf[idx++ & mask] = *args++;
+    }
+    __neorv32_log.head = idx << 2;
+
+    // ring buffer was empty: (re-)start transmission
+    if (head == __neorv32_log.tail) {
+      __neorv32_log.uart->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF);
+    }
+  }
+
+  // leave critical section
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+}
+
+
+/**********************************************************************//**
+ * Wait until all log records have been sent.
+ *
+ * @note This function is blocking. It does not depend on interrupts being enabled.
+ **************************************************************************/
+void neorv32_log_flush(void) {
+
+  uint32_t enabled;
+
+  if (__neorv32_log.buf == NULL) { // not initialized
+    return;
+  }
+
+  while (__neorv32_log.tail != __neorv32_log.head) {
+    enabled = neorv32_cpu_csr_read(CSR_MIE) & __neorv32_log.firq; // touch only our own MIE bit
+    neorv32_cpu_csr_clr(CSR_MIE, __neorv32_log.firq);
+    __neorv32_log_tx_service();
+    neorv32_cpu_csr_set(CSR_MIE, enabled);
+  }
+
+  while (neorv32_uart_tx_busy(__neorv32_log.uart));
+}
+
+
+/**********************************************************************//**
+ * Get number of discarded log records (ring buffer full).
+ *
+ * @return Number of discarded records since setup.
+ **************************************************************************/
+uint32_t neorv32_log_get_dropped(void) {
+
+  return __neorv32_log.dropped;
+}
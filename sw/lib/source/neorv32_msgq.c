@@ -0,0 +1,274 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_msgq.c
+ * @brief Zero-copy shared-memory message queue (SMP) source file.
+ *
+ * @note Bounded queue with a sequence number per slot: a slot is free for position p if its
+ * sequence number is p and filled if it is p + 1. Producers reserve a contiguous range of
+ * positions via compare-and-swap (LR/SC), write their payload back to main memory with a
+ * single fence and then fill and commit the slots. The consumer takes all consecutive
+ * committed slots, invalidates its data cache with a single fence and releases the slots for
+ * the next lap. All queue words are accessed by atomic memory operations, which bypass the
+ * data caches, so only the payload requires cache synchronization.
+ */
+
+#include <neorv32.h>
+
+
+#if defined __riscv_atomic
+/**********************************************************************//**
+ * Private function: load word from shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @return Data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_msgq_load(volatile uint32_t *addr) {
+
+  return __atomic_fetch_or(addr, 0, __ATOMIC_SEQ_CST); // -> amoor.w
+}
+
+
+/**********************************************************************//**
+ * Private function: store word to shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @param[in] data Data word.
+ **************************************************************************/
+static inline void __neorv32_msgq_store(volatile uint32_t *addr, uint32_t data) {
+
+  __atomic_exchange_n(addr, data, __ATOMIC_SEQ_CST); // -> amoswap.w
+}
+#endif
+
+
+/**********************************************************************//**
+ * Initialize message queue.
+ *
+ * @note Must not be called while the queue is in use. Has to be called before the other core
+ * accesses the queue for the first time (or the other core has to execute a fence afterwards).
+ *
+ * @param[in,out] q Queue (#neorv32_msgq_t, see #NEORV32_MSGQ_DEFINE).
+ * @param[in,out] slot Slot array (aligned to #NEORV32_MSGQ_CACHE_BLOCK).
+ * @param[in] num Number of slots (power of two, entire cache blocks).
+ * @param[in] consumer Hart ID of the core that receives the messages.
+ * @return 0 if success, -1 if invalid configuration or the A ISA extension is not available.
+ **************************************************************************/
+int neorv32_msgq_init(neorv32_msgq_t *q, neorv32_msgq_slot_t *slot, uint32_t num, int consumer) {
+
+#if defined __riscv_atomic
+  uint32_t i;
+
+  if ((num < 2) || ((num & (num - 1)) != 0) || (((uint32_t)consumer) >= NEORV32_RTE_MAX_HARTS) ||
+      (((uint32_t)slot & (NEORV32_MSGQ_CACHE_BLOCK - 1)) != 0) ||
+      (((num * sizeof(neorv32_msgq_slot_t)) & (NEORV32_MSGQ_CACHE_BLOCK - 1)) != 0)) {
+    return -1;
+  }
+
+  for (i=0; i<num; i++) {
+    __neorv32_msgq_store(&slot[i].seq, i);
+    __neorv32_msgq_store(&slot[i].buf, 0);
+    __neorv32_msgq_store(&slot[i].len, 0);
+    __neorv32_msgq_store(&slot[i].reserved, 0);
+  }
+  q->slot = slot;
+  q->num = num;
+  q->consumer = (uint32_t)consumer;
+  asm volatile ("fence"); // write back configuration; these words are read-only from now on
+  __neorv32_msgq_store(&q->reserve, 0);
+  __neorv32_msgq_store(&q->head, 0);
+  __neorv32_msgq_store(&q->sleeping, 0);
+  return 0;
+#else
+  (void)q;
+  (void)slot;
+  (void)num;
+  (void)consumer;
+  return -1;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Send a batch of messages (all or nothing). The payload buffers are written back to main
+ * memory (fence) once for the entire batch. Can be called by any core and from interrupt
+ * handlers.
+ *
+ * @note The buffers belong to the consumer until it hands them back (e.g. via another queue).
+ *
+ * @param[in,out] q Queue.
+ * @param[in] msg Array of message descriptors.
+ * @param[in] n Number of messages (1..number of slots).
+ * @return 0 if success, -1 if not enough free slots, invalid n or the A ISA extension is not available.
+ **************************************************************************/
+int neorv32_msgq_send_batch(neorv32_msgq_t *q, const neorv32_msgq_msg_t *msg, uint32_t n) {
+
+#if defined __riscv_atomic
+  neorv32_msgq_slot_t *s;
+  uint32_t pos, last, seq, i;
+  const uint32_t mask = q->num - 1;
+
+  if ((n == 0) || (n > q->num)) {
+    return -1;
+  }
+
+  // reserve n consecutive positions (slots are released in order, so checking the last one is sufficient)
+  while (1) {
+    pos = __neorv32_msgq_load(&q->reserve);
+    last = pos + n - 1;
+    seq = __neorv32_msgq_load(&q->slot[last & mask].seq);
+    if (seq != last) {
+      if ((int32_t)(seq - last) < 0) {
+        return -1; // not enough free slots
+      }
+      continue; // another producer has reserved these positions; retry
+    }
+    if (__sync_bool_compare_and_swap(&q->reserve, pos, pos + n)) { // -> lr/sc
+      break;
+    }
+  }
+
+  asm volatile ("fence"); // write back all payload buffers of this batch
+
+  // fill and commit slots
+  for (i=0; i<n; i++) {
+    s = &q->slot[(pos + i) & mask];
+    __neorv32_msgq_store(&s->buf, (uint32_t)msg[i].buf);
+    __neorv32_msgq_store(&s->len, msg[i].len);
+    __neorv32_msgq_store(&s->seq, pos + i + 1);
+  }
+
+  // wake up consumer
+  if (__neorv32_msgq_load(&q->sleeping)) {
+    neorv32_clint_msi_set((int)q->consumer);
+  }
+  return 0;
+#else
+  (void)q;
+  (void)msg;
+  (void)n;
+  return -1;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Send a single message. See #neorv32_msgq_send_batch().
+ *
+ * @param[in,out] q Queue.
+ * @param[in] buf Payload buffer.
+ * @param[in] len Payload length in bytes.
+ * @return 0 if success, -1 if the queue is full or the A ISA extension is not available.
+ **************************************************************************/
+int neorv32_msgq_send(neorv32_msgq_t *q, void *buf, uint32_t len) {
+
+  neorv32_msgq_msg_t msg = {buf, len};
+  return neorv32_msgq_send_batch(q, &msg, 1);
+}
+
+
+/**********************************************************************//**
+ * Receive all available messages (up to max, non-blocking). The data cache is invalidated
+ * (fence) once for the entire batch. Must be called by the consumer core only.
+ *
+ * @param[in,out] q Queue.
+ * @param[out] msg Array for the received message descriptors.
+ * @param[in] max Maximum number of messages.
+ * @return Number of received messages, -1 if the A ISA extension is not available.
+ **************************************************************************/
+int neorv32_msgq_recv(neorv32_msgq_t *q, neorv32_msgq_msg_t *msg, uint32_t max) {
+
+#if defined __riscv_atomic
+  neorv32_msgq_slot_t *s;
+  uint32_t pos = __neorv32_msgq_load(&q->head);
+  uint32_t n = 0, i;
+  const uint32_t mask = q->num - 1;
+
+  // number of consecutive committed slots
+  while ((n < max) && (__neorv32_msgq_load(&q->slot[(pos + n) & mask].seq) == (pos + n + 1))) {
+    n++;
+  }
+  if (n == 0) {
+    return 0;
+  }
+
+  asm volatile ("fence"); // reload payload buffers of this batch from main memory
+
+  // fetch descriptors and release slots for the next lap
+  for (i=0; i<n; i++) {
+    s = &q->slot[(pos + i) & mask];
+    msg[i].buf = (void*)__neorv32_msgq_load(&s->buf);
+    msg[i].len = __neorv32_msgq_load(&s->len);
+    __neorv32_msgq_store(&s->seq, pos + i + q->num);
+  }
+  __neorv32_msgq_store(&q->head, pos + n);
+  return (int)n;
+#else
+  (void)q;
+  (void)msg;
+  (void)max;
+  return -1;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Receive messages (up to max); sleep until at least one message is available.
+ * The producers wake up the consumer via its machine software interrupt (CLINT MSI).
+ *
+ * @note The MSI is enabled during sleep only and is cleared before interrupts are
+ * re-enabled, so no MSI handler is executed. Do not use this function on a core whose
+ * MSI is used otherwise (e.g. by the multitasking kernel).
+ *
+ * @param[in,out] q Queue.
+ * @param[out] msg Array for the received message descriptors.
+ * @param[in] max Maximum number of messages (at least 1).
+ * @return Number of received messages, -1 if the A ISA extension is not available or max is 0.
+ **************************************************************************/
+int neorv32_msgq_recv_wait(neorv32_msgq_t *q, neorv32_msgq_msg_t *msg, uint32_t max) {
+
+#if defined __riscv_atomic
+  uint32_t mstatus, mie, pos;
+  int n, hart = (int)neorv32_cpu_csr_read(CSR_MHARTID);
+
+  if (max == 0) {
+    return -1;
+  }
+
+  while (1) {
+    n = neorv32_msgq_recv(q, msg, max);
+    if (n != 0) {
+      return n;
+    }
+
+    mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    mie = neorv32_cpu_csr_read(CSR_MIE);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MSIE);
+    neorv32_clint_msi_clr(hart);
+    __neorv32_msgq_store(&q->sleeping, 1);
+
+    // a producer that commits after this check sees the sleeping flag
+    pos = __neorv32_msgq_load(&q->head);
+    if (__neorv32_msgq_load(&q->slot[pos & (q->num - 1)].seq) != (pos + 1)) {
+      neorv32_cpu_sleep();
+    }
+
+    __neorv32_msgq_store(&q->sleeping, 0);
+    neorv32_clint_msi_clr(hart);
+    neorv32_cpu_csr_write(CSR_MIE, mie);
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  }
+#else
+  (void)q;
+  (void)msg;
+  (void)max;
+  return -1;
+#endif
+}
@@ -0,0 +1,278 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_mutex.c
+ * @brief Sleeping inter-core mutex based on the HWSPINLOCK (SMP) source file.
+ *
+ * @note A waiting core sets its waiting flag, checks the HWSPINLOCK once more (so a release
+ * in between cannot be missed) and sleeps with its MSI as the only wake-up source.
+ * In contrast to #neorv32_hwspinlock_acquire_blocking() the waiting core does not access the
+ * bus while sleeping, so the owner's critical section is not slowed down. The statistics
+ * are written by the current owner only.
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * Private function: load word from shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @return Data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_mutex_load(volatile uint32_t *addr) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_or(addr, 0, __ATOMIC_SEQ_CST); // -> amoor.w
+#else
+  asm volatile ("fence"); // invalidate cached copy
+  return *addr;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: store word to shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @param[in] data Data word.
+ **************************************************************************/
+static inline void __neorv32_mutex_store(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  __atomic_exchange_n(addr, data, __ATOMIC_SEQ_CST); // -> amoswap.w
+#else
+  *addr = data;
+  asm volatile ("fence"); // write back to main memory
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: acquire mutex; sleep until it is released if it is locked.
+ *
+ * @note The waiting flag is cleared before each attempt to claim the HWSPINLOCK, so a
+ * releaser does not wake a core that already owns the mutex. An MSI that has been pending
+ * before (e.g. raised by another subsystem) is raised again when the mutex is acquired.
+ *
+ * @param[in,out] mutex Mutex.
+ * @return 0 if the mutex has been acquired right away, 1 if the core had to wait.
+ **************************************************************************/
+static uint32_t __neorv32_mutex_acquire(neorv32_mutex_t *mutex) {
+
+  uint32_t hart, mstatus, mie, pending;
+
+  if (neorv32_hwspinlock_acquire((int)mutex->lock) == 0) {
+    asm volatile ("fence"); // reload protected data and statistics
+    return 0;
+  }
+
+  hart = neorv32_cpu_csr_read(CSR_MHARTID);
+
+  // the MSI is used as wake-up source only; interrupts remain globally disabled
+  mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  mie = neorv32_cpu_csr_read(CSR_MIE);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MSIE);
+  pending = neorv32_clint_msi_get((int)hart);
+
+  while (1) {
+    neorv32_clint_msi_clr((int)hart);
+    __neorv32_mutex_store(&mutex->waiter[hart].waiting, 1);
+    if (neorv32_hwspinlock_probe((int)mutex->lock)) { // check again after registering
+      neorv32_cpu_sleep(); // wait for the owner's wake-up
+    }
+    __neorv32_mutex_store(&mutex->waiter[hart].waiting, 0);
+    if (neorv32_hwspinlock_acquire((int)mutex->lock) == 0) {
+      break;
+    }
+  }
+
+  // restore MSI state (wake-ups of the owner are discarded)
+  if (pending) {
+    neorv32_clint_msi_set((int)hart);
+  }
+  else {
+    neorv32_clint_msi_clr((int)hart);
+  }
+  neorv32_cpu_csr_write(CSR_MIE, mie);
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+
+  asm volatile ("fence"); // reload protected data and statistics
+  return 1;
+}
+
+
+/**********************************************************************//**
+ * Private function: release mutex and wake up all waiting cores.
+ *
+ * @param[in,out] mutex Mutex.
+ **************************************************************************/
+static void __neorv32_mutex_release(neorv32_mutex_t *mutex) {
+
+  uint32_t i, hart = neorv32_cpu_csr_read(CSR_MHARTID);
+
+  asm volatile ("fence"); // write back protected data and statistics
+  neorv32_hwspinlock_release((int)mutex->lock);
+
+  for (i=0; i<NEORV32_RTE_MAX_HARTS; i++) {
+    if ((i != hart) && __neorv32_mutex_load(&mutex->waiter[i].waiting)) {
+      neorv32_clint_msi_set((int)i);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Initialize mutex (unlocked, statistics cleared).
+ *
+ * @note Must not be called while the mutex is in use. Each mutex needs its own HWSPINLOCK lock.
+ *
+ * @param[in,out] mutex Mutex.
+ * @param[in] lock HWSPINLOCK lock (0..31) that is used by this mutex.
+ * @return 0 if success, -1 if invalid lock or HWSPINLOCK not available.
+ **************************************************************************/
+int neorv32_mutex_init(neorv32_mutex_t *mutex, int lock) {
+
+  uint32_t i;
+
+  if ((lock < 0) || (lock > 31) || (neorv32_hwspinlock_available() == 0)) {
+    return -1;
+  }
+
+  mutex->lock       = (uint32_t)lock;
+  mutex->acquires   = 0;
+  mutex->contended  = 0;
+  mutex->wait_lo    = 0;
+  mutex->wait_hi    = 0;
+  mutex->hold_max   = 0;
+  mutex->hold_start = 0;
+  for (i=0; i<NEORV32_RTE_MAX_HARTS; i++) {
+    mutex->waiter[i].waiting = 0;
+  }
+  asm volatile ("fence"); // write back initialization
+
+  neorv32_hwspinlock_release(lock);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Acquire mutex (blocking). The calling core sleeps while the mutex is held by the other core.
+ *
+ * @warning The mutex is meant for mutual exclusion between cores: it is not recursive and must
+ * not be acquired in interrupt handlers or by tasks of the multitasking kernel that share a
+ * core with the owner. The waiting core's MSI is used as wake-up source.
+ *
+ * @param[in,out] mutex Mutex.
+ **************************************************************************/
+void neorv32_mutex_lock(neorv32_mutex_t *mutex) {
+
+  uint64_t t0 = neorv32_cpu_get_cycle();
+  uint32_t contended = __neorv32_mutex_acquire(mutex);
+  uint64_t t1 = neorv32_cpu_get_cycle();
+
+  // update statistics (owner only)
+  uint64_t wait = (((uint64_t)mutex->wait_hi) << 32) | (uint64_t)mutex->wait_lo;
+  wait += t1 - t0;
+  mutex->wait_lo = (uint32_t)wait;
+  mutex->wait_hi = (uint32_t)(wait >> 32);
+  mutex->acquires++;
+  mutex->contended += contended;
+  mutex->hold_start = (uint32_t)t1;
+}
+
+
+/**********************************************************************//**
+ * Try to acquire mutex (non-blocking).
+ *
+ * @param[in,out] mutex Mutex.
+ * @return 0 if the mutex has been acquired, -1 if it is locked.
+ **************************************************************************/
+int neorv32_mutex_trylock(neorv32_mutex_t *mutex) {
+
+  if (neorv32_hwspinlock_acquire((int)mutex->lock) != 0) {
+    return -1;
+  }
+  asm volatile ("fence"); // reload protected data and statistics
+
+  mutex->acquires++;
+  mutex->hold_start = (uint32_t)neorv32_cpu_get_cycle();
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Release mutex and wake up waiting cores.
+ *
+ * @param[in,out] mutex Mutex (has to be held by the calling core).
+ **************************************************************************/
+void neorv32_mutex_unlock(neorv32_mutex_t *mutex) {
+
+  uint32_t hold = (uint32_t)neorv32_cpu_get_cycle() - mutex->hold_start;
+
+  if (hold > mutex->hold_max) {
+    mutex->hold_max = hold;
+  }
+  __neorv32_mutex_release(mutex);
+}
+
+
+/**********************************************************************//**
+ * Get contention statistics of a mutex. The mutex is acquired for a consistent snapshot
+ * (this acquisition is not counted).
+ *
+ * @warning Must not be called by the owner of the mutex.
+ *
+ * @param[in,out] mutex Mutex.
+ * @param[out] stats Statistics (#neorv32_mutex_stats_t).
+ * @param[in] reset Clear statistics after reading them when non-zero.
+ **************************************************************************/
+void neorv32_mutex_get_stats(neorv32_mutex_t *mutex, neorv32_mutex_stats_t *stats, int reset) {
+
+  __neorv32_mutex_acquire(mutex);
+
+  stats->acquires  = mutex->acquires;
+  stats->contended = mutex->contended;
+  stats->wait      = (((uint64_t)mutex->wait_hi) << 32) | (uint64_t)mutex->wait_lo;
+  stats->hold_max  = mutex->hold_max;
+
+  if (reset) {
+    mutex->acquires  = 0;
+    mutex->contended = 0;
+    mutex->wait_lo   = 0;
+    mutex->wait_hi   = 0;
+    mutex->hold_max  = 0;
+  }
+
+  __neorv32_mutex_release(mutex);
+}
+
+
+/**********************************************************************//**
+ * Print contention statistics of a mutex via UART0.
+ *
+ * @warning Must not be called by the owner of the mutex.
+ *
+ * @param[in,out] mutex Mutex.
+ * @param[in] name Name of the mutex.
+ **************************************************************************/
+void neorv32_mutex_print_stats(neorv32_mutex_t *mutex, const char *name) {
+
+  neorv32_mutex_stats_t stats;
+
+  if (neorv32_uart0_available() == 0) {
+    return; // cannot output anything if UART0 is not implemented
+  }
+
+  neorv32_mutex_get_stats(mutex, &stats, 0);
+  neorv32_uart0_printf("[mutex %s] acquires: %u, contended: %u, wait: %llu cycles (avg %u), max hold: %u cycles\n",
+                       name, stats.acquires, stats.contended, stats.wait,
+                       stats.acquires ? (uint32_t)(stats.wait / stats.acquires) : 0, stats.hold_max);
+}
@@ -20,6 +20,7 @@
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/reent.h>
 
 // global error variable
 #include <errno.h>
@@ -107,6 +108,258 @@ int _lseek(int file, int ptr, int dir) {
 }
 
 
+ /**********************************************************************//**
+ * @name Stream devices (UART0: STDIN/STDOUT/STDERR, UART1: all other streams)
+ **************************************************************************/
+/**@{*/
+#define NEWLIB_DEV_INIT   (1 << 0) /**< device information is valid */
+#define NEWLIB_DEV_UART0  (1 << 1) /**< UART0 available */
+#define NEWLIB_DEV_UART1  (1 << 2) /**< UART1 available */
+#define NEWLIB_DEV_UART0T (1 << 3) /**< UART0 uses buffered/interrupt-driven TX */
+#define NEWLIB_DEV_UART0R (1 << 4) /**< UART0 uses buffered/interrupt-driven RX */
+#define NEWLIB_DEV_UART1T (1 << 5) /**< UART1 uses buffered/interrupt-driven TX */
+#define NEWLIB_DEV_UART1R (1 << 6) /**< UART1 uses buffered/interrupt-driven RX */
+#define NEWLIB_DEV_SMP    (1 << 7) /**< more than one core: locks are required */
+#define NEWLIB_DEV_HWSPIN (1 << 8) /**< HWSPINLOCK available */
+#define NEWLIB_DEV_UART0O (1 << 9) /**< buffered UART0 is owned by core 1 (otherwise core 0) */
+#define NEWLIB_DEV_UART1O (1 << 10) /**< buffered UART1 is owned by core 1 (otherwise core 0) */
+static uint32_t __neorv32_newlib_dev = 0;
+/**@}*/
+
+
+ /**********************************************************************//**
+ * Private function to get the available stream devices. The hardware is probed only once.
+ *
+ * @return Device flags (NEWLIB_DEV_*).
+ **************************************************************************/
+static uint32_t __neorv32_newlib_get_dev(void) {
+
+  uint32_t dev = __neorv32_newlib_dev;
+
+  if ((dev & NEWLIB_DEV_INIT) == 0) {
+    dev = NEWLIB_DEV_INIT;
+    if (neorv32_uart_available(NEORV32_UART0)) {
+      dev |= NEWLIB_DEV_UART0;
+    }
+    if (neorv32_uart_available(NEORV32_UART1)) {
+      dev |= NEWLIB_DEV_UART1;
+    }
+    if (neorv32_sysinfo_get_numcores() > 1) {
+      dev |= NEWLIB_DEV_SMP;
+    }
+    if (neorv32_hwspinlock_available()) {
+      dev |= NEWLIB_DEV_HWSPIN;
+    }
+    __neorv32_newlib_dev = dev;
+  }
+  return dev;
+}
+
+
+ /**********************************************************************//**
+ * Recursive SMP lock. This is also the lock type of newlib's retargetable locking interface.
+ **************************************************************************/
+struct __lock {
+  volatile uint32_t owner; /**< 0 = free, otherwise ID of owning hart + 1 */
+  uint32_t count;          /**< recursion depth */
+};
+
+
+ /**********************************************************************//**
+ * @name Locks
+ **************************************************************************/
+/**@{*/
+/** Static locks of newlib's retargetable locking interface */
+struct __lock __lock___sinit_recursive_mutex, __lock___sfp_recursive_mutex, __lock___atexit_recursive_mutex,
+              __lock___at_quick_exit_mutex, __lock___malloc_recursive_mutex, __lock___env_recursive_mutex,
+              __lock___tz_mutex, __lock___dd_hash_mutex, __lock___arc4random_mutex;
+/** Locks for dynamically created newlib locks (the last one is shared if all others are in use) */
+static struct __lock __neorv32_newlib_lock_pool[NEORV32_NEWLIB_LOCKS];
+static uint32_t __neorv32_newlib_lock_next = 0;
+/** Internal locks: lock pool allocation, stream devices */
+static struct __lock __neorv32_newlib_lock_init, __neorv32_newlib_lock_write, __neorv32_newlib_lock_read;
+/**@}*/
+
+
+#if !defined __riscv_atomic
+ /**********************************************************************//**
+ * Private function: SMP locks are not available. Print an error message via UART0 (if
+ * available) and halt the calling core.
+ **************************************************************************/
+static void __neorv32_newlib_smp_error(void) {
+
+  if (neorv32_uart0_available()) {
+    neorv32_uart0_puts("<NEORV32-NEWLIB> [ERROR] SMP locks require the A/Zalrsc ISA extension "
+                       "or the HWSPINLOCK! Halting CPU\n");
+  }
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  while (1) {
+    asm volatile ("wfi");
+  }
+}
+#endif
+
+
+ /**********************************************************************//**
+ * Private function to try to acquire a lock.
+ *
+ * @note Mutual exclusion across cores is based on LR/SC if the A/Zalrsc ISA extension is
+ * enabled. Otherwise the HWSPINLOCK (#NEORV32_NEWLIB_HWSPINLOCK) is used as guard. If
+ * neither is available in a multi-core configuration the calling core is halted.
+ *
+ * @param[in,out] lock Lock.
+ * @return 0 if lock acquired, -1 if lock is owned by another hart.
+ **************************************************************************/
+static int __neorv32_newlib_trylock(struct __lock *lock) {
+
+  uint32_t self = neorv32_cpu_csr_read(CSR_MHARTID) + 1;
+  uint32_t dev;
+
+  // already owned by this hart
+  if (lock->owner == self) {
+    lock->count++;
+    return 0;
+  }
+
+  dev = __neorv32_newlib_get_dev();
+  if (dev & NEWLIB_DEV_SMP) {
+#if defined __riscv_atomic
+    if ((neorv32_cpu_amolr((uint32_t)&lock->owner) != 0) ||
+        (neorv32_cpu_amosc((uint32_t)&lock->owner, self) != 0)) {
+      return -1;
+    }
+#else
+    if (dev & NEWLIB_DEV_HWSPIN) {
+      neorv32_hwspinlock_acquire_blocking(NEORV32_NEWLIB_HWSPINLOCK);
+      asm volatile ("fence");
+      if (lock->owner != 0) {
+        neorv32_hwspinlock_release(NEORV32_NEWLIB_HWSPINLOCK);
+        return -1;
+      }
+      lock->owner = self;
+      asm volatile ("fence");
+      neorv32_hwspinlock_release(NEORV32_NEWLIB_HWSPINLOCK);
+    }
+    else { // no way to provide mutual exclusion across cores
+      __neorv32_newlib_smp_error();
+    }
+#endif
+    asm volatile ("fence"); // make modifications of the other hart visible
+  }
+  else {
+    lock->owner = self;
+  }
+
+  lock->count = 1;
+  return 0;
+}
+
+
+ /**********************************************************************//**
+ * Private function to acquire a lock (blocking).
+ *
+ * @param[in,out] lock Lock.
+ **************************************************************************/
+static void __neorv32_newlib_lock(struct __lock *lock) {
+
+  while (__neorv32_newlib_trylock(lock));
+}
+
+
+ /**********************************************************************//**
+ * Private function to release a lock.
+ *
+ * @param[in,out] lock Lock (owned by the calling hart).
+ **************************************************************************/
+static void __neorv32_newlib_unlock(struct __lock *lock) {
+
+  if (--lock->count == 0) {
+    asm volatile ("fence"); // make modifications visible to the other hart
+    lock->owner = 0;
+    asm volatile ("fence");
+  }
+}
+
+
+ /**********************************************************************//**
+ * @name Newlib retargetable locking interface (used if newlib was built with
+ * "--enable-newlib-retargetable-locking"). All locks are recursive.
+ **************************************************************************/
+/**@{*/
+void __retarget_lock_init(struct __lock **lock) {
+  __neorv32_newlib_lock(&__neorv32_newlib_lock_init);
+  *lock = &__neorv32_newlib_lock_pool[__neorv32_newlib_lock_next];
+  if (__neorv32_newlib_lock_next < (NEORV32_NEWLIB_LOCKS - 1)) {
+    __neorv32_newlib_lock_next++;
+  }
+  __neorv32_newlib_unlock(&__neorv32_newlib_lock_init);
+}
+void __retarget_lock_init_recursive(struct __lock **lock) { __retarget_lock_init(lock); }
+void __retarget_lock_close(struct __lock *lock) { (void)lock; } // pool locks are not recycled
+void __retarget_lock_close_recursive(struct __lock *lock) { (void)lock; }
+void __retarget_lock_acquire(struct __lock *lock) { __neorv32_newlib_lock(lock); }
+void __retarget_lock_acquire_recursive(struct __lock *lock) { __neorv32_newlib_lock(lock); }
+int  __retarget_lock_try_acquire(struct __lock *lock) { return __neorv32_newlib_trylock(lock); }
+int  __retarget_lock_try_acquire_recursive(struct __lock *lock) { return __neorv32_newlib_trylock(lock); }
+void __retarget_lock_release(struct __lock *lock) { __neorv32_newlib_unlock(lock); }
+void __retarget_lock_release_recursive(struct __lock *lock) { __neorv32_newlib_unlock(lock); }
+/**@}*/
+
+
+ /**********************************************************************//**
+ * @name Memory allocator and environment locks (always used by newlib).
+ **************************************************************************/
+/**@{*/
+void __malloc_lock(struct _reent *r) { (void)r; __neorv32_newlib_lock(&__lock___malloc_recursive_mutex); }
+void __malloc_unlock(struct _reent *r) { (void)r; __neorv32_newlib_unlock(&__lock___malloc_recursive_mutex); }
+void __env_lock(struct _reent *r) { (void)r; __neorv32_newlib_lock(&__lock___env_recursive_mutex); }
+void __env_unlock(struct _reent *r) { (void)r; __neorv32_newlib_unlock(&__lock___env_recursive_mutex); }
+/**@}*/
+
+
+ /**********************************************************************//**
+ * Use buffered, interrupt-driven operation for the stream device(s) of a UART:
+ * _write() copies to a TX ring buffer that is drained by the UART TX interrupt
+ * and _read() is served from an RX ring buffer that is filled by the UART RX interrupt.
+ *
+ * @note See #neorv32_uart_irq_setup() for the requirements. Interrupts have to be enabled
+ * globally by the application. _write() waits for the TX ring buffer to drain if it is full.
+ *
+ * @note The buffered streams are owned by the calling core, which executes the UART interrupt
+ * handlers. On any other core _write() waits until the owner's TX ring buffer is empty and then
+ * writes directly to the UART; _read() is not supported there if buffered RX is used. In the SMP
+ * configuration this function has to be called before the other core is started.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] tx_buf Memory for the TX ring buffer.
+ * @param[in] tx_size Size of tx_buf in bytes; has to be a power of two.
+ * @param[in,out] rx_buf Memory for the RX ring buffer (NULL: blocking reads).
+ * @param[in] rx_size Size of rx_buf in bytes; has to be a power of two (0: blocking reads).
+ * @return 0 if success, -1 if UART not available or invalid buffer size.
+ **************************************************************************/
+int neorv32_newlib_stdio_setup(neorv32_uart_t *UARTx, char *tx_buf, int tx_size, char *rx_buf, int rx_size) {
+
+  uint32_t flag;
+
+  if ((tx_buf == NULL) || (tx_size == 0) ||
+      (neorv32_uart_irq_setup(UARTx, tx_buf, tx_size, rx_buf, rx_size) != 0)) {
+    return -1;
+  }
+
+  uint32_t owner = neorv32_cpu_csr_read(CSR_MHARTID) & 1;
+  if (((uint32_t)UARTx) == NEORV32_UART1_BASE) {
+    flag = NEWLIB_DEV_UART1T | ((rx_size != 0) ? NEWLIB_DEV_UART1R : 0) | (owner ? NEWLIB_DEV_UART1O : 0);
+  }
+  else {
+    flag = NEWLIB_DEV_UART0T | ((rx_size != 0) ? NEWLIB_DEV_UART0R : 0) | (owner ? NEWLIB_DEV_UART0O : 0);
+  }
+  __neorv32_newlib_dev = __neorv32_newlib_get_dev() | flag;
+  asm volatile ("fence"); // flush device flags to main memory
+  return 0;
+}
+
+
  /**********************************************************************//**
  * Read from a file. STDIN will read from UART0, all other input streams
  * will read from UART1.
@@ -115,35 +368,54 @@ int _read(int file, char *ptr, int len) {
 
   char c = 0;
   int read_cnt = 0;
+  uint32_t dev = __neorv32_newlib_get_dev();
+  uint32_t owner;
+  neorv32_uart_t *uart;
 
   // read STDIN stream from NEORV32.UART0 (if available)
-  if ((file == STDIN_FILENO) && (neorv32_uart_available(NEORV32_UART0))) {
-    while (len--) {
-      c = (char)neorv32_uart_getc(NEORV32_UART0);
-      *ptr++ = c;
-      read_cnt++;
-      if ((c == '\n') || (c == '\r')) { // also terminate on [press enter]
-        return read_cnt;
-      }
-    }
-    return read_cnt;
+  if ((file == STDIN_FILENO) && (dev & NEWLIB_DEV_UART0)) {
+    uart = NEORV32_UART0;
+    owner = (dev & NEWLIB_DEV_UART0O) ? 1 : 0;
+    dev &= NEWLIB_DEV_UART0R;
   }
   // read all other input streams from NEORV32.UART1 (if available)
-  else if (neorv32_uart_available(NEORV32_UART1)) {
+  else if (dev & NEWLIB_DEV_UART1) {
+    uart = NEORV32_UART1;
+    owner = (dev & NEWLIB_DEV_UART1O) ? 1 : 0;
+    dev &= NEWLIB_DEV_UART1R;
+  }
+  else {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  // RX data is fetched by the interrupt handler of the owning core only
+  if (dev && (neorv32_cpu_csr_read(CSR_MHARTID) != owner)) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  __neorv32_newlib_lock(&__neorv32_newlib_lock_read);
+
+  // buffered mode: return all available data (but at least one char)
+  if (dev) {
+    do {
+      read_cnt = neorv32_uart_irq_read(uart, ptr, len);
+    } while ((read_cnt == 0) && (len > 0));
+  }
+  else {
     while (len--) {
-      c = (char)neorv32_uart_getc(NEORV32_UART1);
+      c = (char)neorv32_uart_getc(uart);
       *ptr++ = c;
       read_cnt++;
       if ((c == '\n') || (c == '\r')) { // also terminate on [press enter]
-        return read_cnt;
+        break;
       }
     }
-    return read_cnt;
-  }
-  else {
-    errno = ENOSYS;
-    return -1;
   }
+
+  __neorv32_newlib_unlock(&__neorv32_newlib_lock_read);
+  return read_cnt;
 }
 
 
@@ -153,51 +425,70 @@ int _read(int file, char *ptr, int len) {
  **************************************************************************/
 int _write(int file, char *ptr, int len) {
 
-  int write_cnt = 0;
+  int cnt, write_cnt = 0;
+  uint32_t dev = __neorv32_newlib_get_dev();
+  uint32_t owner;
+  neorv32_uart_t *uart;
 
   // write STDOUT and STDERR streams to NEORV32.UART0 (if available)
   if ((file == STDOUT_FILENO) || (file == STDERR_FILENO)) {
-    if (neorv32_uart_available(NEORV32_UART0)) {
-      while (len--) {
-        neorv32_uart_putc(NEORV32_UART0, *ptr++);
-        write_cnt++;
-      }
-      return write_cnt;
-    }
-    else {
+    if ((dev & NEWLIB_DEV_UART0) == 0) {
       errno = ENOSYS;
       return -1;
     }
+    uart = NEORV32_UART0;
+    owner = (dev & NEWLIB_DEV_UART0O) ? 1 : 0;
+    dev &= NEWLIB_DEV_UART0T;
   }
-
   // write all other output streams to NEORV32.UART1 (if available)
-  if (neorv32_uart_available(NEORV32_UART1)) {
-    while (len--) {
-      neorv32_uart_putc(NEORV32_UART1, *ptr++);
-      write_cnt++;
-    }
-    return write_cnt;
+  else if (dev & NEWLIB_DEV_UART1) {
+    uart = NEORV32_UART1;
+    owner = (dev & NEWLIB_DEV_UART1O) ? 1 : 0;
+    dev &= NEWLIB_DEV_UART1T;
   }
   else {
     errno = ENOSYS;
     return -1;
   }
+
+  __neorv32_newlib_lock(&__neorv32_newlib_lock_write);
+
+  // buffered mode (owning core only): copy to TX ring buffer; drain it if full
+  // (same core as the TX interrupt handler, so there is only one consumer)
+  if (dev && (neorv32_cpu_csr_read(CSR_MHARTID) == owner)) {
+    while (write_cnt < len) {
+      cnt = neorv32_uart_irq_write(uart, ptr + write_cnt, len - write_cnt);
+      if (cnt == 0) {
+        neorv32_uart_irq_flush(uart);
+      }
+      write_cnt += cnt;
+    }
+  }
+  else {
+    // buffered mode on another core: wait until the owner's TX interrupt handler
+    // has drained the ring buffer (it clears IRQ_TX_NHALF when there is no more data)
+    if (dev) {
+      while (uart->CTRL & (1 << UART_CTRL_IRQ_TX_NHALF));
+    }
+    neorv32_uart_write(uart, ptr, len);
+    write_cnt = len;
+  }
+
+  __neorv32_newlib_unlock(&__neorv32_newlib_lock_write);
+  return write_cnt;
 }
 
 
  /**********************************************************************//**
  * Dynamic memory management. Used by "malloc" and "free", among others.
+ *
+ * @note The heap is shared by all cores (protected by the malloc lock).
  **************************************************************************/
 void *_sbrk(int incr) {
 
   static unsigned char *curr_heap_ptr = NULL; // current heap pointer
   unsigned char *prev_heap_ptr; // previous heap pointer
 
-  // initialize
-  if (curr_heap_ptr == NULL) {
-    curr_heap_ptr = (unsigned char *)NEORV32_HEAP_BEGIN;
-  }
-
   // do we have a heap at all?
   if ((NEORV32_HEAP_BEGIN == NEORV32_HEAP_END) || (NEORV32_HEAP_SIZE == 0)) {
     write(STDERR_FILENO, "[neorv32-newlib] no heap available\r\n", 36);
@@ -205,17 +496,27 @@ void *_sbrk(int incr) {
     return (void*)-1; // error - no more memory
   }
 
+  __neorv32_newlib_lock(&__lock___malloc_recursive_mutex);
+
+  // initialize
+  if (curr_heap_ptr == NULL) {
+    curr_heap_ptr = (unsigned char *)NEORV32_HEAP_BEGIN;
+  }
+
   // sufficient space left?
   if ((((uint32_t)curr_heap_ptr) + ((uint32_t)incr)) >= NEORV32_HEAP_END) {
+    __neorv32_newlib_unlock(&__lock___malloc_recursive_mutex);
     write(STDERR_FILENO, "[neorv32-newlib] heap exhausted\r\n", 33);
     errno = ENOMEM;
     return (void*)-1; // error - no more memory
   }
 
-  // runtime stack collision?
+  // runtime stack collision? only core 0's stack is located above the heap
   register uint32_t stack_pntr asm("sp");
   asm volatile ("" : "=r" (stack_pntr));
-  if ((((uint32_t)curr_heap_ptr) + ((uint32_t)incr)) >= stack_pntr) {
+  if ((neorv32_cpu_csr_read(CSR_MHARTID) == 0) &&
+      ((((uint32_t)curr_heap_ptr) + ((uint32_t)incr)) >= stack_pntr)) {
+    __neorv32_newlib_unlock(&__lock___malloc_recursive_mutex);
     write(STDERR_FILENO, "[neorv32-newlib] heap/stack collision\r\n", 39);
     errno = ENOMEM;
     _exit(-911); // fast exit, no need for the C-Lib "fini" stuff
@@ -225,10 +526,32 @@ void *_sbrk(int incr) {
   prev_heap_ptr = curr_heap_ptr;
   curr_heap_ptr += incr;
 
+  __neorv32_newlib_unlock(&__lock___malloc_recursive_mutex);
   return (void*)prev_heap_ptr;
 }
 
 
+ /**********************************************************************//**
+ * Re-entrancy structure of core 1 (core 0 uses newlib's default structure).
+ **************************************************************************/
+static struct _reent __neorv32_newlib_reent1 = _REENT_INIT(__neorv32_newlib_reent1);
+
+
+ /**********************************************************************//**
+ * Get the re-entrancy structure (errno, stdio streams, ...) of the calling hart.
+ * Used by newlib if it was built with "__DYNAMIC_REENT__".
+ *
+ * @return Pointer to the re-entrancy structure of the executing core.
+ **************************************************************************/
+struct _reent *__getreent(void) {
+
+  if (neorv32_cpu_csr_read(CSR_MHARTID) == 0) {
+    return _impure_ptr;
+  }
+  return &__neorv32_newlib_reent1;
+}
+
+
  /**********************************************************************//**
  * Get Unix time. Used by "time", among others.
  **************************************************************************/
@@ -236,8 +559,9 @@ int _gettimeofday(struct timeval *tv) {
 
   // use MTIME as system time (if available)
   if (neorv32_clint_available()) {
-    tv->tv_sec  = (time_t)neorv32_clint_unixtime_get();
-    tv->tv_usec = (suseconds_t)(tv->tv_sec * 1000000);
+    uint32_t nsec;
+    tv->tv_sec  = (time_t)neorv32_clint_ns2sec(neorv32_clint_time_get_ns(), &nsec);
+    tv->tv_usec = (suseconds_t)(nsec / 1000);
     return 0;
   }
   else {
@@ -245,3 +569,93 @@ int _gettimeofday(struct timeval *tv) {
     return -1;
   }
 }
+
+
+/**********************************************************************//**
+ * POSIX clock IDs (newlib only defines them for targets with POSIX timers).
+ **************************************************************************/
+#ifndef CLOCK_REALTIME
+#define CLOCK_REALTIME ((clockid_t)1)
+#endif
+#ifndef CLOCK_MONOTONIC
+#define CLOCK_MONOTONIC ((clockid_t)4)
+#endif
+
+
+ /**********************************************************************//**
+ * Get time of a clock with nanosecond resolution. Both, CLOCK_REALTIME and
+ * CLOCK_MONOTONIC, are based on MTIME.
+ **************************************************************************/
+int clock_gettime(clockid_t clock_id, struct timespec *tp) {
+
+  uint32_t nsec;
+
+  if ((clock_id != CLOCK_REALTIME) && (clock_id != CLOCK_MONOTONIC)) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  tp->tv_sec  = (time_t)neorv32_clint_ns2sec(neorv32_clint_time_get_ns(), &nsec);
+  tp->tv_nsec = (long)nsec;
+  return 0;
+}
+
+
+ /**********************************************************************//**
+ * Get resolution of a clock.
+ **************************************************************************/
+int clock_getres(clockid_t clock_id, struct timespec *res) {
+
+  if ((clock_id != CLOCK_REALTIME) && (clock_id != CLOCK_MONOTONIC)) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  if (res != NULL) {
+    res->tv_sec  = 0;
+    res->tv_nsec = (long)neorv32_clint_ticks2ns(1) + 1; // round up
+  }
+  return 0;
+}
+
+
+ /**********************************************************************//**
+ * Suspend execution for a time interval. The CPU sleeps (wfi) until the
+ * interval has elapsed. The interval is never shortened by interrupts.
+ **************************************************************************/
+int nanosleep(const struct timespec *rqtp, struct timespec *rmtp) {
+
+  if ((rqtp->tv_sec < 0) || (rqtp->tv_nsec < 0) || (rqtp->tv_nsec >= 1000000000L)) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (neorv32_clint_available() == 0) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  uint64_t ns = ((uint64_t)rqtp->tv_sec * 1000000000ULL) + (uint64_t)rqtp->tv_nsec;
+  neorv32_clint_sleep_until(neorv32_clint_time_get() + neorv32_clint_ns2ticks(ns));
+
+  if (rmtp != NULL) {
+    rmtp->tv_sec  = 0;
+    rmtp->tv_nsec = 0;
+  }
+  return 0;
+}
+
+
+ /**********************************************************************//**
+ * Suspend execution for a number of microseconds (CPU sleeps).
+ **************************************************************************/
+int usleep(useconds_t usec) {
+
+  struct timespec t;
+  t.tv_sec  = (time_t)(usec / 1000000);
+  t.tv_nsec = (long)(usec % 1000000) * 1000;
+  return nanosleep(&t, NULL);
+}
@@ -0,0 +1,277 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_pool.c
+ * @brief Fixed-size block pool allocator source file.
+ *
+ * @note Blocks are taken from the list of released blocks first. If it is empty, the
+ * next block that has never been allocated is used, so a pool does not need to be
+ * initialized block by block.
+ */
+
+#include <neorv32.h>
+
+
+#if defined __riscv_atomic
+/**********************************************************************//**
+ * Private function: remove first block from free list (lock-free).
+ *
+ * @note There must be no store between LR and SC (a store clears the reservation).
+ * The fence synchronizes the data cache so the link word of the head block is up to date.
+ *
+ * @param[in,out] pool Pool.
+ * @return Block or NULL if free list is empty.
+ **************************************************************************/
+static void *__neorv32_pool_pop(neorv32_pool_t *pool) {
+
+  void *blk;
+  uint32_t nxt, fail;
+
+  asm volatile (
+    "1: fence                   \n"
+    "   lr.w  %[b], (%[h])      \n"
+    "   beqz  %[b], 2f          \n"
+    "   lw    %[n], 0(%[b])     \n"
+    "   sc.w  %[f], %[n], (%[h])\n"
+    "   bnez  %[f], 1b          \n"
+    "2:                         \n"
+    : [b] "=&r" (blk), [n] "=&r" (nxt), [f] "=&r" (fail)
+    : [h] "r" (&pool->free)
+    : "memory"
+  );
+  return blk;
+}
+
+
+/**********************************************************************//**
+ * Private function: add block to free list (lock-free).
+ *
+ * @param[in,out] pool Pool.
+ * @param[in,out] blk Block.
+ **************************************************************************/
+static void __neorv32_pool_push(neorv32_pool_t *pool, void *blk) {
+
+  uint32_t head, tmp, fail;
+
+  asm volatile (
+    "1: lw    %[o], 0(%[h])     \n" // expected head
+    "   sw    %[o], 0(%[b])     \n" // link block to it
+    "   fence                   \n" // make link visible
+    "   lr.w  %[t], (%[h])      \n"
+    "   bne   %[t], %[o], 1b    \n" // head has changed
+    "   sc.w  %[f], %[b], (%[h])\n"
+    "   bnez  %[f], 1b          \n"
+    : [o] "=&r" (head), [t] "=&r" (tmp), [f] "=&r" (fail)
+    : [h] "r" (&pool->free), [b] "r" (blk)
+    : "memory"
+  );
+}
+#else
+/**********************************************************************//**
+ * HWSPINLOCK usage (0 = not probed yet, 1 = not used, 2 = used, 3 = required but not available).
+ **************************************************************************/
+static uint32_t __neorv32_pool_hwlock = 0;
+
+
+/**********************************************************************//**
+ * Private function: probe HWSPINLOCK usage (only once).
+ *
+ * @return 0 if mutual exclusion is available, -1 if not (multi-core without HWSPINLOCK).
+ **************************************************************************/
+static int __neorv32_pool_probe(void) {
+
+  if (__neorv32_pool_hwlock == 0) {
+    if (neorv32_sysinfo_get_numcores() > 1) {
+      __neorv32_pool_hwlock = neorv32_hwspinlock_available() ? 2 : 3;
+    }
+    else {
+      __neorv32_pool_hwlock = 1;
+    }
+  }
+  return (__neorv32_pool_hwlock == 3) ? -1 : 0;
+}
+
+
+/**********************************************************************//**
+ * Private function: enter critical section (disable interrupts, acquire HWSPINLOCK).
+ *
+ * @note Halts the calling core if there is no mutual exclusion across cores (pools that
+ * have been defined statically and not checked by #neorv32_pool_init()).
+ *
+ * @return Previous mstatus.
+ **************************************************************************/
+static uint32_t __neorv32_pool_enter(void) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  if (__neorv32_pool_probe()) {
+    if (neorv32_uart0_available()) {
+      neorv32_uart0_puts("<NEORV32-POOL> [ERROR] SMP pools require the A ISA extension "
+                         "or the HWSPINLOCK! Halting CPU\n");
+    }
+    neorv32_cpu_csr_write(CSR_MIE, 0);
+    while (1) {
+      asm volatile ("wfi");
+    }
+  }
+  if (__neorv32_pool_hwlock == 2) {
+    neorv32_hwspinlock_acquire_blocking(NEORV32_POOL_HWSPINLOCK);
+    asm volatile ("fence");
+  }
+  return mstatus;
+}
+
+
+/**********************************************************************//**
+ * Private function: leave critical section.
+ *
+ * @param[in] mstatus Previous mstatus.
+ **************************************************************************/
+static void __neorv32_pool_leave(uint32_t mstatus) {
+
+  if (__neorv32_pool_hwlock == 2) {
+    asm volatile ("fence");
+    neorv32_hwspinlock_release(NEORV32_POOL_HWSPINLOCK);
+  }
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+}
+#endif
+
+
+/**********************************************************************//**
+ * Initialize a block pool at runtime (alternative to #NEORV32_POOL_DEFINE).
+ *
+ * @param[in,out] pool Pool control structure.
+ * @param[in,out] mem Block memory (word-aligned); at least num * #NEORV32_POOL_BLOCK_SIZE(block_size) bytes.
+ * @param[in] block_size Size of each block in bytes.
+ * @param[in] num Number of blocks.
+ * @return 0 if success, -1 if invalid configuration or no inter-core synchronization
+ * available (multi-core without A ISA extension and HWSPINLOCK).
+ **************************************************************************/
+int neorv32_pool_init(neorv32_pool_t *pool, void *mem, uint32_t block_size, uint32_t num) {
+
+  if ((mem == NULL) || (((uint32_t)mem & 3) != 0) || (num == 0)) {
+    return -1;
+  }
+#if !defined __riscv_atomic
+  if (__neorv32_pool_probe()) { // interrupt masking does not exclude the other core
+    return -1;
+  }
+#endif
+
+  pool->free       = NULL;
+  pool->next       = 0;
+  pool->used       = 0;
+  pool->peak       = 0;
+  pool->mem        = (uint8_t*)mem;
+  pool->block_size = NEORV32_POOL_BLOCK_SIZE(block_size);
+  pool->num        = num;
+  asm volatile ("fence");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Allocate a block. Can be used from interrupt handlers.
+ *
+ * @param[in,out] pool Pool.
+ * @return Pointer to block (word-aligned) or NULL if all blocks are in use.
+ **************************************************************************/
+void *neorv32_pool_alloc(neorv32_pool_t *pool) {
+
+  void *blk;
+  uint32_t idx, used, peak;
+
+#if defined __riscv_atomic
+  blk = __neorv32_pool_pop(pool);
+  if (blk == NULL) { // take a block that has never been used
+    do {
+      idx = pool->next;
+      if (idx >= pool->num) {
+        return NULL;
+      }
+    } while (!__sync_bool_compare_and_swap(&pool->next, idx, idx + 1));
+    blk = (void*)(pool->mem + idx * pool->block_size);
+  }
+  used = __atomic_add_fetch(&pool->used, 1, __ATOMIC_RELAXED);
+  do {
+    peak = pool->peak;
+  } while ((used > peak) && !__sync_bool_compare_and_swap(&pool->peak, peak, used));
+#else
+  uint32_t mstatus = __neorv32_pool_enter();
+  blk = pool->free;
+  if (blk != NULL) {
+    pool->free = *(void**)blk;
+  }
+  else if (pool->next < pool->num) {
+    idx = pool->next++;
+    blk = (void*)(pool->mem + idx * pool->block_size);
+  }
+  if (blk != NULL) {
+    used = ++pool->used;
+    peak = pool->peak;
+    if (used > peak) {
+      pool->peak = used;
+    }
+  }
+  __neorv32_pool_leave(mstatus);
+#endif
+
+  return blk;
+}
+
+
+/**********************************************************************//**
+ * Release a block. Can be used from interrupt handlers.
+ *
+ * @param[in,out] pool Pool.
+ * @param[in,out] block Block allocated by #neorv32_pool_alloc() of this pool (NULL is ignored).
+ **************************************************************************/
+void neorv32_pool_free(neorv32_pool_t *pool, void *block) {
+
+  if (block == NULL) {
+    return;
+  }
+
+#if defined __riscv_atomic
+  __neorv32_pool_push(pool, block);
+  __atomic_sub_fetch(&pool->used, 1, __ATOMIC_RELAXED);
+#else
+  uint32_t mstatus = __neorv32_pool_enter();
+  *(void**)block = pool->free;
+  pool->free = block;
+  pool->used--;
+  __neorv32_pool_leave(mstatus);
+#endif
+}
+
+
+/**********************************************************************//**
+ * Get number of allocated blocks.
+ *
+ * @param[in] pool Pool.
+ * @return Number of blocks in use.
+ **************************************************************************/
+uint32_t neorv32_pool_get_used(neorv32_pool_t *pool) {
+
+  return pool->used;
+}
+
+
+/**********************************************************************//**
+ * Get high-water mark.
+ *
+ * @param[in] pool Pool.
+ * @return Maximum number of blocks that were in use at the same time.
+ **************************************************************************/
+uint32_t neorv32_pool_get_peak(neorv32_pool_t *pool) {
+
+  return pool->peak;
+}
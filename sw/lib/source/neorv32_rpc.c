@@ -0,0 +1,271 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_rpc.c
+ * @brief Asynchronous inter-core remote procedure calls (SMP) source file.
+ *
+ * @note Core 0 fills a future, pushes its address into the ICC link and triggers core 1's MSI.
+ * Core 1's MSI handler executes all queued requests, stores the results in the futures and
+ * triggers core 0's MSI, which is used as wake-up source for a waiting caller. Futures are
+ * accessed by atomic memory operations, which bypass the data caches (or via fence if the A
+ * ISA extension is not available).
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * Server status (occupies an entire cache block as it is written by core 1 and read by core 0).
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_RPC_CACHE_BLOCK))) {
+  volatile uint32_t online; /**< core 1 accepts requests */
+} __neorv32_rpc_server_t;
+
+static __neorv32_rpc_server_t __neorv32_rpc_server;
+
+
+/**********************************************************************//**
+ * Private function: load word from shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @return Data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_rpc_load(volatile uint32_t *addr) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_or(addr, 0, __ATOMIC_SEQ_CST); // -> amoor.w
+#else
+  asm volatile ("fence"); // invalidate cached copy
+  return *addr;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: store word to shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @param[in] data Data word.
+ **************************************************************************/
+static inline void __neorv32_rpc_store(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  __atomic_exchange_n(addr, data, __ATOMIC_SEQ_CST); // -> amoswap.w
+#else
+  *addr = data;
+  asm volatile ("fence"); // write back to main memory
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: RPC server (core 1 MSI handler). Executes all requests that are
+ * queued in the ICC link.
+ **************************************************************************/
+static void __neorv32_rpc_server_isr(void) {
+
+  neorv32_rpc_future_t *fut;
+  neorv32_rpc_fn_t fn;
+  uint32_t result;
+
+  neorv32_clint_msi_clr(1); // requests that are sent from now on trigger a new MSI
+
+  while (neorv32_smp_icc_avail()) {
+    fut = (neorv32_rpc_future_t*)neorv32_smp_icc_get();
+    asm volatile ("fence"); // reload request data from main memory
+    fn = (neorv32_rpc_fn_t)__neorv32_rpc_load(&fut->fn);
+    result = fn((void*)__neorv32_rpc_load(&fut->arg));
+    asm volatile ("fence"); // make data written by the remote procedure visible to core 0
+    __neorv32_rpc_store(&fut->result, result);
+    __neorv32_rpc_store(&fut->state, RPC_DONE);
+    neorv32_clint_msi_set(0); // wake up waiting caller
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: main function of core 1 (see #neorv32_rpc_server_start()).
+ *
+ * @return Does not return.
+ **************************************************************************/
+static int __neorv32_rpc_server_main(void) {
+
+  neorv32_rte_setup();
+  neorv32_rpc_server_setup();
+
+  while (1) {
+    neorv32_cpu_sleep(); // requests are executed in the MSI handler
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Setup RPC server on core 1: requests are executed by core 1's machine software
+ * interrupt (MSI) handler. Use this function if core 1 runs an application-specific
+ * main function; see #neorv32_rpc_server_start() otherwise.
+ *
+ * @warning This function can be executed on core 1 only (after #neorv32_rte_setup()).
+ * It enables machine-level interrupts. Core 1's MSI and the ICC link from core 0 to
+ * core 1 are dedicated to the RPC server afterwards.
+ *
+ * @return 0 if success, -1 if not executed on core 1.
+ **************************************************************************/
+int neorv32_rpc_server_setup(void) {
+
+  if (neorv32_cpu_csr_read(CSR_MHARTID) != 1) {
+    return -1;
+  }
+
+  neorv32_rte_handler_install_hart(1, RTE_TRAP_MSI, __neorv32_rpc_server_isr);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MSIE);
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  __neorv32_rpc_store(&__neorv32_rpc_server.online, 1);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Launch core 1 as dedicated RPC server: core 1 sleeps and executes requests only.
+ *
+ * @warning This function can be executed on core 0 only.
+ *
+ * @param[in] stack_memory Pointer to beginning of core1's stack memory array.
+ * Should be at least 512 bytes (plus the stack usage of the remote procedures).
+ *
+ * @param[in] stack_size_bytes Core1's stack size in bytes.
+ *
+ * @return 0 if launching succeeded, -1 if invalid hart ID or CLINT not available,
+ * -2 if core1 is not responding.
+ **************************************************************************/
+int neorv32_rpc_server_start(uint8_t* stack_memory, size_t stack_size_bytes) {
+
+  int rc = neorv32_smp_launch(__neorv32_rpc_server_main, stack_memory, stack_size_bytes);
+
+  if (rc == 0) {
+    while (__neorv32_rpc_load(&__neorv32_rpc_server.online) == 0); // wait until server is ready
+  }
+  return rc;
+}
+
+
+/**********************************************************************//**
+ * Call function on core 1 (non-blocking). Blocks only if the ICC link is full.
+ *
+ * @note Data the remote procedure reads via arg has to be complete before this call;
+ * data it writes must not be accessed by the caller before the request has completed.
+ *
+ * @warning This function can be executed on core 0 only (not from interrupt handlers).
+ *
+ * @param[in,out] fut Future of this request (zero-initialized before its first use; has to
+ * remain valid until completion).
+ * @param[in] fn Remote procedure.
+ * @param[in] arg Argument for the remote procedure.
+ * @return 0 if success, -1 if not executed on core 0, RPC server not online, fn is
+ * NULL or fut is still pending.
+ **************************************************************************/
+int neorv32_rpc_call_async(neorv32_rpc_future_t *fut, neorv32_rpc_fn_t fn, void *arg) {
+
+  if ((neorv32_cpu_csr_read(CSR_MHARTID) != 0) || (fn == NULL) ||
+      (__neorv32_rpc_load(&__neorv32_rpc_server.online) == 0)) {
+    return -1;
+  }
+
+  // make request data visible to core 1; this also writes back the future's cache block
+  // (e.g. initialization) so it can no longer overwrite the atomic accesses below
+  asm volatile ("fence");
+
+  if (__neorv32_rpc_load(&fut->state) == RPC_PENDING) {
+    return -1;
+  }
+  __neorv32_rpc_store(&fut->fn, (uint32_t)fn);
+  __neorv32_rpc_store(&fut->arg, (uint32_t)arg);
+  __neorv32_rpc_store(&fut->result, 0);
+  __neorv32_rpc_store(&fut->state, RPC_PENDING);
+
+  neorv32_smp_icc_push((uint32_t)fut);
+  neorv32_clint_msi_set(1);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Check if a request has been completed (non-blocking).
+ * Use #neorv32_rpc_wait() to fetch the result.
+ *
+ * @param[in] fut Future.
+ * @return 1 if completed, 0 if still pending or no request.
+ **************************************************************************/
+int neorv32_rpc_poll(neorv32_rpc_future_t *fut) {
+
+  return (__neorv32_rpc_load(&fut->state) == RPC_DONE) ? 1 : 0;
+}
+
+
+/**********************************************************************//**
+ * Wait for completion of a request and fetch its result. The caller sleeps until core 1
+ * triggers core 0's machine software interrupt (MSI).
+ *
+ * @note The MSI is enabled during sleep only and is cleared before interrupts are
+ * re-enabled, so no MSI handler is executed. Core 0's MSI must not be used otherwise
+ * (e.g. by the multitasking kernel) while waiting.
+ *
+ * @param[in,out] fut Future (idle afterwards).
+ * @return Return value of the remote procedure; 0 if there was no request.
+ **************************************************************************/
+uint32_t neorv32_rpc_wait(neorv32_rpc_future_t *fut) {
+
+  uint32_t state, mstatus, mie, result;
+
+  state = __neorv32_rpc_load(&fut->state);
+  if (state == RPC_IDLE) {
+    return 0;
+  }
+
+  if (state != RPC_DONE) {
+    mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    mie = neorv32_cpu_csr_read(CSR_MIE);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MSIE);
+    while (1) {
+      neorv32_clint_msi_clr(0);
+      if (__neorv32_rpc_load(&fut->state) == RPC_DONE) { // core 1 sets the MSI after completion
+        break;
+      }
+      neorv32_cpu_sleep();
+    }
+    neorv32_clint_msi_clr(0);
+    neorv32_cpu_csr_write(CSR_MIE, mie);
+    neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  }
+
+  asm volatile ("fence"); // reload data written by the remote procedure
+  result = __neorv32_rpc_load(&fut->result);
+  __neorv32_rpc_store(&fut->state, RPC_IDLE);
+  return result;
+}
+
+
+/**********************************************************************//**
+ * Call function on core 1 and wait for its result (blocking). The function is
+ * executed locally if the RPC server is not online or if called on core 1.
+ *
+ * @param[in] fn Remote procedure.
+ * @param[in] arg Argument for the remote procedure.
+ * @return Return value of the remote procedure.
+ **************************************************************************/
+uint32_t neorv32_rpc_call(neorv32_rpc_fn_t fn, void *arg) {
+
+  neorv32_rpc_future_t fut = {0};
+
+  if (neorv32_rpc_call_async(&fut, fn, arg)) {
+    return fn(arg);
+  }
+  return neorv32_rpc_wait(&fut);
+}
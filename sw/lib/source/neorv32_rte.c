@@ -17,11 +17,35 @@
 // RTE private variables and functions
 // ------------------------------------------------------------------------------------------------
 
-// private trap vector look-up table (for all cores!)
-static volatile uint32_t __neorv32_rte_vector_lut[NEORV32_RTE_NUM_TRAPS];
+// private trap vector look-up tables (one table per core); each table is padded
+// to 32 entries so the first-level handlers can select it via (mhartid << 7)
+static volatile uint32_t __neorv32_rte_vector_lut[NEORV32_RTE_MAX_HARTS][32];
+
+// private pointers to the current full context stack frame (one per core)
+static volatile uint32_t __neorv32_rte_context[NEORV32_RTE_MAX_HARTS];
+
+// private interrupt priorities and the according MIE masks of all interrupt sources that are
+// allowed to preempt a handler (one set per core); the mask tables use the same layout as the
+// handler tables
+static uint8_t __neorv32_rte_irq_prio[NEORV32_RTE_MAX_HARTS][32];
+static volatile uint32_t __neorv32_rte_irq_mask[NEORV32_RTE_MAX_HARTS][32];
+
+// private MIE bits that are currently disabled by handler nesting and that are re-enabled when
+// the according handler returns (one mask per core)
+static volatile uint32_t __neorv32_rte_irq_held[NEORV32_RTE_MAX_HARTS];
+
+// private number of handlers that are currently executed with interrupts enabled (one per core)
+static volatile uint32_t __neorv32_rte_irq_nest[NEORV32_RTE_MAX_HARTS];
 
 // private helper functions
 static void __neorv32_rte_print_hex(uint32_t num, int digits);
+static int  __neorv32_rte_num_harts(void);
+static int  __neorv32_rte_install(int hart, int id, uint32_t entry);
+static uint32_t __neorv32_rte_irq_mie_bit(int id);
+static void __neorv32_rte_irq_mie_clr(uint32_t mask);
+
+// private first-level interrupt handler (shared by direct and vectored mode)
+void __neorv32_rte_irq_core(void);
 
 
 // ------------------------------------------------------------------------------------------------
@@ -33,40 +57,114 @@ static void __neorv32_rte_print_hex(uint32_t num, int digits);
  * Setup RTE.
  *
  * @note This function must be called on all cores that wish to use the RTE.
+ * Each core has its own trap handler table. Cores with a hart ID >= #NEORV32_RTE_MAX_HARTS
+ * cannot use the RTE: an error message is printed via UART0 (if available) and the
+ * calling core is halted.
+ *
+ * @note When executed on core 0 this function installs a debug handler for ALL trap
+ * sources of ALL cores, which gives detailed information about the trap via UART0
+ * (if available), and resets all interrupt priorities. The other cores do not modify
+ * any handler table, so handlers that core 0 has already installed for them (e.g. via
+ * #neorv32_rte_handler_install()) are kept. Actual handlers can be installed afterwards
+ * via #neorv32_rte_handler_install() or #neorv32_rte_handler_install_hart().
  *
- * @note This function installs a debug handler for ALL trap sources, which
- * gives detailed information about the trap via UART0 (if available). Actual
- * handlers can be installed afterwards via #neorv32_rte_handler_install().
+ * @note If an ISR stack is reserved for this core by the linker script
+ * (see #NEORV32_ISR_STACK_SIZE) all traps are executed on this stack. The
+ * MSCRATCH CSR is reserved for the RTE and must not be altered by the application.
  **************************************************************************/
 void neorv32_rte_setup(void) {
 
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  if (hart >= NEORV32_RTE_MAX_HARTS) { // no RTE instance available for this core
+    if (neorv32_uart0_available()) {
+      neorv32_uart0_puts("<NEORV32-RTE> [ERROR] No trap handler table for this core, "
+                         "increase NEORV32_RTE_MAX_HARTS! Halting CPU </NEORV32-RTE>\n");
+    }
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    neorv32_cpu_csr_write(CSR_MIE, 0);
+    while (1) {
+      asm volatile ("wfi");
+    }
+  }
+
   // clear mstatus, set previous privilege level to machine-mode
   neorv32_cpu_csr_write(CSR_MSTATUS, (1<<CSR_MSTATUS_MPP_H) | (1<<CSR_MSTATUS_MPP_L));
 
   // configure trap handler base address
   neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)(&neorv32_rte_core));
 
+  // configure interrupt stack: mscratch = top of this core's ISR stack (0 = use the current stack)
+  uint32_t isr_stack = 0;
+  if (NEORV32_ISR_STACK_SIZE != 0) {
+    isr_stack = NEORV32_ISR_STACK_BEGIN + ((hart + 1) * NEORV32_ISR_STACK_SIZE);
+    if (isr_stack > NEORV32_ISR_STACK_END) {
+      isr_stack = 0; // no ISR stack reserved for this core
+    }
+  }
+  neorv32_cpu_csr_write(CSR_MSCRATCH, isr_stack & 0xfffffff0u); // keep 16-byte alignment
+
   // disable all IRQ channels
   neorv32_cpu_csr_write(CSR_MIE, 0);
 
-  // install debug handler for all trap sources (executed only on core 0)
-  if (neorv32_cpu_csr_read(CSR_MHARTID) == 0) {
-    int index;
-    for (index = 0; index < ((int)NEORV32_RTE_NUM_TRAPS); index++) {
-      __neorv32_rte_vector_lut[index] = (uint32_t)(&neorv32_rte_debug_handler);
+  __neorv32_rte_irq_held[hart] = 0;
+  __neorv32_rte_irq_nest[hart] = 0;
+
+  // install debug handler for all trap sources of all cores (executed only on core 0)
+  if (hart == 0) {
+    int h, index;
+    for (h = 0; h < ((int)NEORV32_RTE_MAX_HARTS); h++) {
+      for (index = 0; index < ((int)NEORV32_RTE_NUM_TRAPS); index++) {
+        __neorv32_rte_vector_lut[h][index] = (uint32_t)(&neorv32_rte_debug_handler);
+        __neorv32_rte_irq_prio[h][index] = 0; // same priority for all: no nesting
+        __neorv32_rte_irq_mask[h][index] = 0;
+      }
     }
     asm volatile ("fence"); // flush handler table to main memory
   }
+}
+
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Enable vectored trap dispatching.
+ *
+ * @note This function operates on the RTE instance of the
+ * core on which this function is executed.
+ *
+ * @note In vectored mode each interrupt source enters the RTE through
+ * its own entry of #neorv32_rte_vector_table, which directly dispatches
+ * the according second-level handler without decoding MCAUSE. All
+ * synchronous exceptions are still processed by #neorv32_rte_core.
+ **************************************************************************/
+void neorv32_rte_vectored_enable(void) {
+
+  // mtvec.mode = 01 (vectored); the vector table is 128-byte-aligned
+  neorv32_cpu_csr_write(CSR_MTVEC, ((uint32_t)(&neorv32_rte_vector_table)) | 1);
 }
 
 
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
- * Install trap handler function (second-level trap handler).
+ * Disable vectored trap dispatching (back to direct mode, default).
  *
- * @note Trap handler installation applies to both cores. Hence, both
- * cores will execute the same handler for the same trap.
+ * @note This function operates on the RTE instance of the
+ * core on which this function is executed.
+ **************************************************************************/
+void neorv32_rte_vectored_disable(void) {
+
+  // mtvec.mode = 00 (direct); all traps enter the RTE core
+  neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)(&neorv32_rte_core));
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Install trap handler function (second-level trap handler) for all cores.
+ *
+ * @note Trap handler installation applies to all cores that are available
+ * (see #neorv32_sysinfo_get_numcores). Hence, all cores will execute the same
+ * handler for the same trap. Use #neorv32_rte_handler_install_hart() to install
+ * core-specific handlers.
  *
  * @param[in] id Identifier (type) of the targeted trap
  * See #NEORV32_RTE_TRAP_enum.
@@ -78,41 +176,284 @@ void neorv32_rte_setup(void) {
  **************************************************************************/
 int neorv32_rte_handler_install(int id, void (*handler)(void)) {
 
-  // check if invalid trap ID
-  uint32_t index = (uint32_t)id;
-  if (index >= NEORV32_RTE_NUM_TRAPS) {
+  int hart;
+  for (hart = 0; hart < __neorv32_rte_num_harts(); hart++) {
+    if (neorv32_rte_handler_install_hart(hart, id, handler)) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Install trap handler function (second-level trap handler) for a specific core.
+ *
+ * @note The handler is executed only if the specified core encounters the
+ * according trap. This can be executed on any core (e.g. core 0 can install
+ * handlers for core 1 before launching core 1). Handlers are reset only when
+ * core 0 executes #neorv32_rte_setup().
+ *
+ * @param[in] hart Hart ID of the targeted core (0..#NEORV32_RTE_MAX_HARTS-1).
+ *
+ * @param[in] id Identifier (type) of the targeted trap
+ * See #NEORV32_RTE_TRAP_enum.
+ *
+ * @param[in] handler The actual handler function for the specified trap
+ * (function MUST be of type "void function(void);").
+ *
+ * @return 0 if success, -1 if invalid trap ID or invalid hart ID.
+ **************************************************************************/
+int neorv32_rte_handler_install_hart(int hart, int id, void (*handler)(void)) {
+
+  return __neorv32_rte_install(hart, id, (uint32_t)handler);
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Install fast interrupt handler function (second-level trap handler) for all cores.
+ *
+ * @note Before calling a fast handler the RTE saves only the registers that
+ * are not preserved by a C function according to the calling convention (ra,
+ * t0-t6, a0-a7). Hence, the interrupted context cannot be accessed by a fast
+ * handler via #neorv32_rte_context_get() / #neorv32_rte_context_put().
+ *
+ * @param[in] id Identifier (type) of the targeted interrupt
+ * See #NEORV32_RTE_TRAP_enum. Only interrupts (#RTE_TRAP_MSI and above) are allowed.
+ *
+ * @param[in] handler The actual handler function for the specified interrupt
+ * (function MUST be of type "void function(void);").
+ *
+ * @return 0 if success, -1 if invalid trap ID or not an interrupt.
+ **************************************************************************/
+int neorv32_rte_handler_install_fast(int id, void (*handler)(void)) {
+
+  int hart;
+  for (hart = 0; hart < __neorv32_rte_num_harts(); hart++) {
+    if (neorv32_rte_handler_install_fast_hart(hart, id, handler)) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Install fast interrupt handler function (second-level trap handler) for a specific core.
+ *
+ * @note See #neorv32_rte_handler_install_fast().
+ *
+ * @param[in] hart Hart ID of the targeted core (0..#NEORV32_RTE_MAX_HARTS-1).
+ *
+ * @param[in] id Identifier (type) of the targeted interrupt
+ * See #NEORV32_RTE_TRAP_enum. Only interrupts (#RTE_TRAP_MSI and above) are allowed.
+ *
+ * @param[in] handler The actual handler function for the specified interrupt
+ * (function MUST be of type "void function(void);").
+ *
+ * @return 0 if success, -1 if invalid trap ID, not an interrupt or invalid hart ID.
+ **************************************************************************/
+int neorv32_rte_handler_install_fast_hart(int hart, int id, void (*handler)(void)) {
+
+  // exceptions always require the complete context
+  if (id < RTE_TRAP_MSI) {
     return -1;
   }
 
-  // install handler
-  __neorv32_rte_vector_lut[index] = (uint32_t)handler;
-  asm volatile ("fence"); // flush updated handler table to main memory
+  // bit 0 of the table entry marks a fast handler (ignored by jalr)
+  uint32_t entry = (uint32_t)handler;
+  if (entry != 0) {
+    entry |= 1;
+  }
+  return __neorv32_rte_install(hart, id, entry);
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Install trap handler function (second-level trap handler) with a specific
+ * interrupt priority for all cores.
+ *
+ * @note See #neorv32_rte_handler_install() and #neorv32_rte_irq_priority_set().
+ *
+ * @param[in] id Identifier (type) of the targeted interrupt
+ * See #NEORV32_RTE_TRAP_enum. Only interrupts (#RTE_TRAP_MSI and above) are allowed.
+ *
+ * @param[in] handler The actual handler function for the specified interrupt
+ * (function MUST be of type "void function(void);").
+ *
+ * @param[in] prio Interrupt priority (0..255, higher value = higher priority).
+ *
+ * @return 0 if success, -1 if invalid trap ID, not an interrupt or invalid priority.
+ **************************************************************************/
+int neorv32_rte_handler_install_prio(int id, void (*handler)(void), int prio) {
+
+  int hart;
+  for (hart = 0; hart < __neorv32_rte_num_harts(); hart++) {
+    if (neorv32_rte_irq_priority_set(hart, id, prio) ||
+        neorv32_rte_handler_install_hart(hart, id, handler)) {
+      return -1;
+    }
+  }
 
   return 0;
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Set software priority of an interrupt source for a specific core.
+ *
+ * @note By default all interrupts have priority 0 and all handlers are executed
+ * with interrupts globally disabled. The handler of an interrupt is executed with
+ * interrupts globally enabled if there are other interrupt sources with a higher
+ * priority. During execution of the handler only these higher-priority sources are
+ * enabled in MIE (if they were enabled before). MEPC, MSTATUS and MCAUSE are saved for each
+ * nesting level and restored when the handler returns; the MIE bits of the other sources are
+ * re-enabled. Other changes of MIE made by the handler are kept. A source that is temporarily
+ * disabled by nesting (e.g. the handler's own source) has to be disabled via
+ * #neorv32_rte_irq_disable() to remain disabled.
+ *
+ * @note Applies to regular and fast handlers.
+ *
+ * @param[in] hart Hart ID of the targeted core (0..#NEORV32_RTE_MAX_HARTS-1).
+ *
+ * @param[in] id Identifier (type) of the targeted interrupt
+ * See #NEORV32_RTE_TRAP_enum. Only interrupts (#RTE_TRAP_MSI and above) are allowed.
+ *
+ * @param[in] prio Interrupt priority (0..255, higher value = higher priority).
+ *
+ * @return 0 if success, -1 if invalid trap ID, not an interrupt, invalid hart ID or invalid priority.
+ **************************************************************************/
+int neorv32_rte_irq_priority_set(int hart, int id, int prio) {
+
+  if ((id < RTE_TRAP_MSI) || (id >= ((int)NEORV32_RTE_NUM_TRAPS)) ||
+      (((uint32_t)hart) >= NEORV32_RTE_MAX_HARTS) || (((uint32_t)prio) > 255)) {
+    return -1;
+  }
+
+  __neorv32_rte_irq_prio[hart][id] = (uint8_t)prio;
+
+  // update preemption masks of all interrupt sources of this core
+  int i, j;
+  uint32_t mask;
+  for (i = RTE_TRAP_MSI; i < ((int)NEORV32_RTE_NUM_TRAPS); i++) {
+    mask = 0;
+    for (j = RTE_TRAP_MSI; j < ((int)NEORV32_RTE_NUM_TRAPS); j++) {
+      if (__neorv32_rte_irq_prio[hart][j] > __neorv32_rte_irq_prio[hart][i]) {
+        mask |= __neorv32_rte_irq_mie_bit(j);
+      }
+    }
+    __neorv32_rte_irq_mask[hart][i] = mask;
+  }
+  asm volatile ("fence"); // flush updated mask table to main memory
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Disable an interrupt source in MIE. In contrast to clearing the MIE bit directly, the
+ * source also remains disabled if the bit is currently cleared by handler nesting (see
+ * #neorv32_rte_irq_priority_set()) and would be re-enabled when the handler returns.
+ *
+ * @note This function operates on the RTE instance of the
+ * core on which this function is executed. It can be used inside and outside of handlers.
+ *
+ * @param[in] id Identifier (type) of the targeted interrupt
+ * See #NEORV32_RTE_TRAP_enum. Only interrupts (#RTE_TRAP_MSI and above) are allowed.
+ *
+ * @return 0 if success, -1 if invalid trap ID or not an interrupt.
+ **************************************************************************/
+int neorv32_rte_irq_disable(int id) {
+
+  if ((id < RTE_TRAP_MSI) || (id >= ((int)NEORV32_RTE_NUM_TRAPS))) {
+    return -1;
+  }
+
+  __neorv32_rte_irq_mie_clr(__neorv32_rte_irq_mie_bit(id));
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Get the number of interrupt handlers that are currently executed with interrupts
+ * enabled because higher-priority sources may preempt them (handler nesting, see
+ * #neorv32_rte_irq_priority_set()).
+ *
+ * @note This function operates on the RTE instance of the
+ * core on which this function is executed.
+ *
+ * @note All other handlers are executed with mstatus.MIE cleared. Hence, code is executed
+ * in handler context if this function returns non-zero or if mstatus.MIE is cleared.
+ *
+ * @return Current nesting depth (0 = not inside an interruptible handler).
+ **************************************************************************/
+int neorv32_rte_irq_nesting(void) {
+
+  return (int)__neorv32_rte_irq_nest[neorv32_cpu_csr_read(CSR_MHARTID)];
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * This is the core of the NEORV32 RTE (first-level trap handler,
  * executed in machine mode).
+ *
+ * @note Interrupts are forwarded to the shared interrupt core
+ * (#__neorv32_rte_irq_core) right after entry.
  **************************************************************************/
 void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
 
   // save context
   asm volatile (
-    "csrw mscratch, sp  \n" // backup original stack pointer
+    // switch to ISR stack if available (mscratch != 0)
+    "csrrw sp, mscratch, sp \n"
+    "bnez  sp, 3f           \n"
+    "csrrw sp, mscratch, sp \n" // no ISR stack: keep current stack, mscratch = 0
+    "3:                     \n"
 
 #ifndef __riscv_32e
     "addi sp, sp, -32*4 \n"
 #else
     "addi sp, sp, -16*4 \n"
 #endif
+    "sw   x10, 10*4(sp) \n"
 
-    "sw x0, 0*4(sp) \n" // is always zero, but backup to have a "complete" indexable register frame
-    "sw x1, 1*4(sp) \n"
+    // interrupts are dispatched by the shared interrupt core:
+    // convert MCAUSE into the according handler table offset
+    "csrr x10, mcause   \n"
+    "bgez x10, 1f       \n" // synchronous exception
+    "andi x10, x10, 31  \n"
+    "addi x10, x10, -16 \n"
+    "bgez x10, 2f       \n" // FIRQ: ID = 13 + (cause - 16)
+    "addi x10, x10, 16  \n"
+    "srli x10, x10, 2   \n" // MSI/MTI/MEI: ID = 10 + (cause >> 2)
+    "addi x10, x10, -3  \n"
+    "2:                 \n"
+    "addi x10, x10, 13  \n"
+    "slli x10, x10, 2   \n"
+    "j    __neorv32_rte_irq_core \n"
 
-    "csrrw x1, mscratch, sp \n" // mscratch = base address of original context
+    // synchronous exceptions: save complete context
+    "1:                     \n"
+    "sw    x1, 1*4(sp)      \n"
+    "csrrw x1, mscratch, x0 \n" // x1 = original stack pointer if ISR stack is used; mscratch = 0 while in RTE
+    "sw    x1, 0*4(sp)      \n" // x0 is always zero; this slot marks the ISR stack switch instead
+    "bnez  x1, 4f           \n"
+#ifndef __riscv_32e
+    "addi  x1, sp, 32*4     \n"
+#else
+    "addi  x1, sp, 16*4     \n"
+#endif
+    "4:                     \n"
     "sw    x1, 2*4(sp)      \n" // store original stack pointer
 
     "sw x3,   3*4(sp) \n"
@@ -122,7 +463,7 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
     "sw x7,   7*4(sp) \n"
     "sw x8,   8*4(sp) \n"
     "sw x9,   9*4(sp) \n"
-    "sw x10, 10*4(sp) \n"
+//  x10 has already been saved
     "sw x11, 11*4(sp) \n"
     "sw x12, 12*4(sp) \n"
     "sw x13, 13*4(sp) \n"
@@ -152,39 +493,30 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
   // reload trap table from main memory
   asm volatile ("fence");
 
-  // find according trap handler base address
+  // publish base address of the original context; the trap might have interrupted
+  // another second-level handler, so the previous context is restored afterwards
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  uint32_t context_prev = __neorv32_rte_context[hart];
+  uint32_t context;
+  asm volatile ("mv %[dst], sp" : [dst] "=r" (context));
+  __neorv32_rte_context[hart] = context;
+
+  // find according trap handler base address (in this core's table);
+  // only synchronous exceptions arrive here
+  const volatile uint32_t *lut = __neorv32_rte_vector_lut[hart];
   uint32_t handler_base = 0;
   switch (neorv32_cpu_csr_read(CSR_MCAUSE)) {
-    case TRAP_CODE_I_ACCESS:     handler_base = __neorv32_rte_vector_lut[RTE_TRAP_I_ACCESS];     break;
-    case TRAP_CODE_I_ILLEGAL:    handler_base = __neorv32_rte_vector_lut[RTE_TRAP_I_ILLEGAL];    break;
-    case TRAP_CODE_I_MISALIGNED: handler_base = __neorv32_rte_vector_lut[RTE_TRAP_I_MISALIGNED]; break;
-    case TRAP_CODE_BREAKPOINT:   handler_base = __neorv32_rte_vector_lut[RTE_TRAP_BREAKPOINT];   break;
-    case TRAP_CODE_L_MISALIGNED: handler_base = __neorv32_rte_vector_lut[RTE_TRAP_L_MISALIGNED]; break;
-    case TRAP_CODE_L_ACCESS:     handler_base = __neorv32_rte_vector_lut[RTE_TRAP_L_ACCESS];     break;
-    case TRAP_CODE_S_MISALIGNED: handler_base = __neorv32_rte_vector_lut[RTE_TRAP_S_MISALIGNED]; break;
-    case TRAP_CODE_S_ACCESS:     handler_base = __neorv32_rte_vector_lut[RTE_TRAP_S_ACCESS];     break;
-    case TRAP_CODE_UENV_CALL:    handler_base = __neorv32_rte_vector_lut[RTE_TRAP_UENV_CALL];    break;
-    case TRAP_CODE_MENV_CALL:    handler_base = __neorv32_rte_vector_lut[RTE_TRAP_MENV_CALL];    break;
-    case TRAP_CODE_MSI:          handler_base = __neorv32_rte_vector_lut[RTE_TRAP_MSI];          break;
-    case TRAP_CODE_MTI:          handler_base = __neorv32_rte_vector_lut[RTE_TRAP_MTI];          break;
-    case TRAP_CODE_MEI:          handler_base = __neorv32_rte_vector_lut[RTE_TRAP_MEI];          break;
-    case TRAP_CODE_FIRQ_0:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_0];       break;
-    case TRAP_CODE_FIRQ_1:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_1];       break;
-    case TRAP_CODE_FIRQ_2:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_2];       break;
-    case TRAP_CODE_FIRQ_3:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_3];       break;
-    case TRAP_CODE_FIRQ_4:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_4];       break;
-    case TRAP_CODE_FIRQ_5:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_5];       break;
-    case TRAP_CODE_FIRQ_6:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_6];       break;
-    case TRAP_CODE_FIRQ_7:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_7];       break;
-    case TRAP_CODE_FIRQ_8:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_8];       break;
-    case TRAP_CODE_FIRQ_9:       handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_9];       break;
-    case TRAP_CODE_FIRQ_10:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_10];      break;
-    case TRAP_CODE_FIRQ_11:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_11];      break;
-    case TRAP_CODE_FIRQ_12:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_12];      break;
-    case TRAP_CODE_FIRQ_13:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_13];      break;
-    case TRAP_CODE_FIRQ_14:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_14];      break;
-    case TRAP_CODE_FIRQ_15:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_15];      break;
-    default:                     handler_base = (uint32_t)(&neorv32_rte_debug_handler);          break;
+    case TRAP_CODE_I_ACCESS:     handler_base = lut[RTE_TRAP_I_ACCESS];     break;
+    case TRAP_CODE_I_ILLEGAL:    handler_base = lut[RTE_TRAP_I_ILLEGAL];    break;
+    case TRAP_CODE_I_MISALIGNED: handler_base = lut[RTE_TRAP_I_MISALIGNED]; break;
+    case TRAP_CODE_BREAKPOINT:   handler_base = lut[RTE_TRAP_BREAKPOINT];   break;
+    case TRAP_CODE_L_MISALIGNED: handler_base = lut[RTE_TRAP_L_MISALIGNED]; break;
+    case TRAP_CODE_L_ACCESS:     handler_base = lut[RTE_TRAP_L_ACCESS];     break;
+    case TRAP_CODE_S_MISALIGNED: handler_base = lut[RTE_TRAP_S_MISALIGNED]; break;
+    case TRAP_CODE_S_ACCESS:     handler_base = lut[RTE_TRAP_S_ACCESS];     break;
+    case TRAP_CODE_UENV_CALL:    handler_base = lut[RTE_TRAP_UENV_CALL];    break;
+    case TRAP_CODE_MENV_CALL:    handler_base = lut[RTE_TRAP_MENV_CALL];    break;
+    default:                     handler_base = (uint32_t)(&neorv32_rte_debug_handler); break;
   }
 
   // call handler
@@ -193,11 +525,11 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
     handler_t* handler = (handler_t*)handler_base;
     handler();
   }
+  __neorv32_rte_context[hart] = context_prev;
 
-  // compute return address (for exceptions only)
+  // compute return address
   // do not alter return address if instruction access exception (fatal?)
-  uint32_t cause = neorv32_cpu_csr_read(CSR_MCAUSE);
-  if (((cause >> 31) == 0) && (cause != TRAP_CODE_I_ACCESS)) {
+  if (neorv32_cpu_csr_read(CSR_MCAUSE) != TRAP_CODE_I_ACCESS) {
 
     uint32_t rte_mepc = neorv32_cpu_csr_read(CSR_MEPC);
     rte_mepc += 4; // default: faulting instruction is uncompressed
@@ -215,7 +547,17 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
 
   // restore context
   asm volatile (
-//  "lw x0,   0*4(sp) \n" // hardwired to zero
+    // re-arm ISR stack if it was used by this trap (mscratch = ISR stack top)
+    "lw   x1, 0*4(sp) \n"
+    "beqz x1, 1f      \n"
+#ifndef __riscv_32e
+    "addi x1, sp, 32*4 \n"
+#else
+    "addi x1, sp, 16*4 \n"
+#endif
+    "csrw mscratch, x1 \n"
+    "1:               \n"
+
     "lw x1,   1*4(sp) \n"
 //  restore 2x at the very end
     "lw x3,   3*4(sp) \n"
@@ -255,6 +597,380 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Trap vector table for the vectored mode (mtvec.mode = 01).
+ *
+ * @note All exceptions (and all causes that cannot be raised by the
+ * hardware) enter at offset 0 and are handled by #neorv32_rte_core.
+ * Each interrupt cause has its own entry stub, which stores the according
+ * handler table offset to a0 and jumps to the shared interrupt core.
+ **************************************************************************/
+void __attribute__((__naked__,aligned(128))) neorv32_rte_vector_table(void) {
+
+  asm volatile (
+    ".option push \n"
+    ".option norvc \n" // each table entry has to be exactly 32-bit wide
+    ".option norelax \n"
+
+    // vector table: base + 4 * mcause[4:0]
+    "j neorv32_rte_core      \n" //  0: all synchronous exceptions
+    "j neorv32_rte_core      \n" //  1: reserved
+    "j neorv32_rte_core      \n" //  2: reserved
+    "j __neorv32_rte_vec_msi \n" //  3: machine software interrupt
+    "j neorv32_rte_core      \n" //  4: reserved
+    "j neorv32_rte_core      \n" //  5: reserved
+    "j neorv32_rte_core      \n" //  6: reserved
+    "j __neorv32_rte_vec_mti \n" //  7: machine timer interrupt
+    "j neorv32_rte_core      \n" //  8: reserved
+    "j neorv32_rte_core      \n" //  9: reserved
+    "j neorv32_rte_core      \n" // 10: reserved
+    "j __neorv32_rte_vec_mei \n" // 11: machine external interrupt
+    "j neorv32_rte_core      \n" // 12: reserved
+    "j neorv32_rte_core      \n" // 13: reserved
+    "j neorv32_rte_core      \n" // 14: reserved
+    "j neorv32_rte_core      \n" // 15: reserved
+    "j __neorv32_rte_vec_f0  \n" // 16: fast interrupt channel 0
+    "j __neorv32_rte_vec_f1  \n" // 17: fast interrupt channel 1
+    "j __neorv32_rte_vec_f2  \n" // 18: fast interrupt channel 2
+    "j __neorv32_rte_vec_f3  \n" // 19: fast interrupt channel 3
+    "j __neorv32_rte_vec_f4  \n" // 20: fast interrupt channel 4
+    "j __neorv32_rte_vec_f5  \n" // 21: fast interrupt channel 5
+    "j __neorv32_rte_vec_f6  \n" // 22: fast interrupt channel 6
+    "j __neorv32_rte_vec_f7  \n" // 23: fast interrupt channel 7
+    "j __neorv32_rte_vec_f8  \n" // 24: fast interrupt channel 8
+    "j __neorv32_rte_vec_f9  \n" // 25: fast interrupt channel 9
+    "j __neorv32_rte_vec_f10 \n" // 26: fast interrupt channel 10
+    "j __neorv32_rte_vec_f11 \n" // 27: fast interrupt channel 11
+    "j __neorv32_rte_vec_f12 \n" // 28: fast interrupt channel 12
+    "j __neorv32_rte_vec_f13 \n" // 29: fast interrupt channel 13
+    "j __neorv32_rte_vec_f14 \n" // 30: fast interrupt channel 14
+    "j __neorv32_rte_vec_f15 \n" // 31: fast interrupt channel 15
+
+    // entry stubs: switch to ISR stack (if available), allocate stack frame,
+    // free a0 and load handler table offset
+#ifndef __riscv_32e
+#define RTE_VEC_STUB(name, id) \
+    #name ": \n" \
+    "csrrw sp, mscratch, sp \n" \
+    "bnez  sp, 1f \n" \
+    "csrrw sp, mscratch, sp \n" \
+    "1: \n" \
+    "addi sp, sp, -32*4 \n" \
+    "sw   x10, 10*4(sp) \n" \
+    "li   x10, " #id "*4 \n" \
+    "j    __neorv32_rte_irq_core \n"
+#else
+#define RTE_VEC_STUB(name, id) \
+    #name ": \n" \
+    "csrrw sp, mscratch, sp \n" \
+    "bnez  sp, 1f \n" \
+    "csrrw sp, mscratch, sp \n" \
+    "1: \n" \
+    "addi sp, sp, -16*4 \n" \
+    "sw   x10, 10*4(sp) \n" \
+    "li   x10, " #id "*4 \n" \
+    "j    __neorv32_rte_irq_core \n"
+#endif
+    RTE_VEC_STUB(__neorv32_rte_vec_msi, 10)
+    RTE_VEC_STUB(__neorv32_rte_vec_mti, 11)
+    RTE_VEC_STUB(__neorv32_rte_vec_mei, 12)
+    RTE_VEC_STUB(__neorv32_rte_vec_f0,  13)
+    RTE_VEC_STUB(__neorv32_rte_vec_f1,  14)
+    RTE_VEC_STUB(__neorv32_rte_vec_f2,  15)
+    RTE_VEC_STUB(__neorv32_rte_vec_f3,  16)
+    RTE_VEC_STUB(__neorv32_rte_vec_f4,  17)
+    RTE_VEC_STUB(__neorv32_rte_vec_f5,  18)
+    RTE_VEC_STUB(__neorv32_rte_vec_f6,  19)
+    RTE_VEC_STUB(__neorv32_rte_vec_f7,  20)
+    RTE_VEC_STUB(__neorv32_rte_vec_f8,  21)
+    RTE_VEC_STUB(__neorv32_rte_vec_f9,  22)
+    RTE_VEC_STUB(__neorv32_rte_vec_f10, 23)
+    RTE_VEC_STUB(__neorv32_rte_vec_f11, 24)
+    RTE_VEC_STUB(__neorv32_rte_vec_f12, 25)
+    RTE_VEC_STUB(__neorv32_rte_vec_f13, 26)
+    RTE_VEC_STUB(__neorv32_rte_vec_f14, 27)
+    RTE_VEC_STUB(__neorv32_rte_vec_f15, 28)
+#undef RTE_VEC_STUB
+
+    ".option pop \n"
+  );
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Shared first-level interrupt handler (direct and vectored mode).
+ *
+ * @note Entered with the stack frame already allocated, a0 saved to the
+ * frame and a0 = 4 * (RTE trap ID). Only the caller-saved registers are
+ * backed up before the handler is fetched; the remaining registers are
+ * saved only if the handler is not a fast handler (bit 0 of the table
+ * entry cleared). Interrupts do not require any return address adjustment.
+ *
+ * @note After the second-level handler has returned, any further pending and
+ * enabled interrupt (MIP & MIE) is dispatched right away (tail-chaining) -
+ * according to the hardware priority - before the context is restored.
+ *
+ * @note Handlers of interrupts that have a lower priority than other sources
+ * (see #neorv32_rte_irq_priority_set()) are executed with interrupts enabled;
+ * only the higher-priority sources are enabled in MIE during execution.
+ **************************************************************************/
+// call second-level handler (x5; bit 0 is ignored by jalr); if there are sources with a higher
+// priority (MIE mask at table offset x10 != 0) the current MEPC/MSTATUS/MCAUSE and the MIE bits of
+// all other sources are saved on the stack and interrupts are globally enabled with only the
+// higher-priority sources being enabled in MIE; after the handler only the saved MIE bits that are
+// still held (not disabled via neorv32_rte_irq_disable()) are re-enabled, all other changes of MIE
+// made by the handler are kept; the per-core nesting counter is incremented while such a handler
+// is executed (see neorv32_rte_irq_nesting())
+#define RTE_CALL_HANDLER \
+    "la    x6, %[mask]  \n" \
+    "add   x6, x6, x10  \n" \
+    "lw    x6, 0(x6)    \n" \
+    "bnez  x6, 10f      \n" \
+    "jalr  x1, 0(x5)    \n" \
+    "j     11f          \n" \
+    "10:                \n" \
+    "addi  sp, sp, -16  \n" \
+    "csrr  x7, mepc     \n" \
+    "sw    x7, 0(sp)    \n" \
+    "csrr  x7, mstatus  \n" \
+    "sw    x7, 4(sp)    \n" \
+    "csrr  x7, mcause   \n" \
+    "sw    x7, 12(sp)   \n" \
+    "csrr  x7, mie      \n" \
+    "and   x6, x6, x7   \n" \
+    "csrw  mie, x6      \n" \
+    "xor   x7, x7, x6   \n" /* MIE bits held by this nesting level */ \
+    "sw    x7, 8(sp)    \n" \
+    "csrr  x6, mhartid  \n" \
+    "slli  x6, x6, 2    \n" \
+    "la    x11, %[held] \n" \
+    "add   x11, x11, x6 \n" \
+    "lw    x6, 0(x11)   \n" \
+    "or    x6, x6, x7   \n" \
+    "sw    x6, 0(x11)   \n" \
+    "csrr  x7, mhartid  \n" \
+    "slli  x7, x7, 2    \n" \
+    "la    x6, %[nest]  \n" \
+    "add   x6, x6, x7   \n" \
+    "lw    x7, 0(x6)    \n" \
+    "addi  x7, x7, 1    \n" /* one more interruptible handler */ \
+    "sw    x7, 0(x6)    \n" \
+    "csrsi mstatus, 1<<3 \n" \
+    "jalr  x1, 0(x5)    \n" \
+    "csrci mstatus, 1<<3 \n" \
+    "csrr  x7, mhartid  \n" \
+    "slli  x7, x7, 2    \n" \
+    "la    x6, %[nest]  \n" \
+    "add   x6, x6, x7   \n" \
+    "lw    x7, 0(x6)    \n" \
+    "addi  x7, x7, -1   \n" \
+    "sw    x7, 0(x6)    \n" \
+    "lw    x7, 12(sp)   \n" \
+    "csrw  mcause, x7   \n" \
+    "csrr  x6, mhartid  \n" \
+    "slli  x6, x6, 2    \n" \
+    "la    x11, %[held] \n" \
+    "add   x11, x11, x6 \n" \
+    "lw    x6, 0(x11)   \n" \
+    "lw    x7, 8(sp)    \n" \
+    "and   x7, x7, x6   \n" /* bits of this level that are still held */ \
+    "csrs  mie, x7      \n" \
+    "xor   x6, x6, x7   \n" \
+    "sw    x6, 0(x11)   \n" \
+    "lw    x7, 4(sp)    \n" \
+    "csrw  mstatus, x7  \n" \
+    "lw    x7, 0(sp)    \n" \
+    "csrw  mepc, x7     \n" \
+    "addi  sp, sp, 16   \n" \
+    "11:                \n"
+
+void __attribute__((__naked__,aligned(4))) __neorv32_rte_irq_core(void) {
+
+  asm volatile (
+    // save caller-saved registers (ra, t0-t6, a0-a7)
+    "sw    x1, 1*4(sp)      \n"
+    "csrrw x1, mscratch, x0 \n" // x1 = original stack pointer if ISR stack is used; mscratch = 0 while in RTE
+    "sw    x1, 0*4(sp)      \n" // x0 is always zero; this slot marks the ISR stack switch instead
+    "bnez  x1, 3f           \n"
+#ifndef __riscv_32e
+    "addi  x1, sp, 32*4     \n"
+#else
+    "addi  x1, sp, 16*4     \n"
+#endif
+    "3:                     \n"
+    "sw    x1, 2*4(sp)      \n" // store original stack pointer
+    "sw x5,  5*4(sp) \n"
+    "sw x6,  6*4(sp) \n"
+    "sw x7,  7*4(sp) \n"
+//  x10 has already been saved by the entry code
+    "sw x11, 11*4(sp) \n"
+    "sw x12, 12*4(sp) \n"
+    "sw x13, 13*4(sp) \n"
+    "sw x14, 14*4(sp) \n"
+    "sw x15, 15*4(sp) \n"
+#ifndef __riscv_32e
+    "sw x16, 16*4(sp) \n"
+    "sw x17, 17*4(sp) \n"
+    "sw x28, 28*4(sp) \n"
+    "sw x29, 29*4(sp) \n"
+    "sw x30, 30*4(sp) \n"
+    "sw x31, 31*4(sp) \n"
+#endif
+
+    // flush context (stack frame) to main memory
+    // reload trap table from main memory
+    "fence \n"
+
+    // get handler from this core's table
+    "5:                \n"
+    "csrr x5, mhartid  \n"
+    "slli x5, x5, 7    \n" // 32 entries per core
+    "add  x10, x10, x5 \n"
+    "la   x5, %[lut]   \n"
+    "add  x5, x5, x10  \n"
+    "lw   x5, 0(x5)    \n"
+    "beqz x5, 2f       \n" // no handler installed
+    "andi x6, x5, 1    \n"
+    "bnez x6, 1f       \n" // fast handler
+
+    // regular handler: save remaining registers to provide a complete frame
+    "sw x3,  3*4(sp) \n"
+    "sw x4,  4*4(sp) \n"
+    "sw x8,  8*4(sp) \n"
+    "sw x9,  9*4(sp) \n"
+#ifndef __riscv_32e
+    "sw x18, 18*4(sp) \n"
+    "sw x19, 19*4(sp) \n"
+    "sw x20, 20*4(sp) \n"
+    "sw x21, 21*4(sp) \n"
+    "sw x22, 22*4(sp) \n"
+    "sw x23, 23*4(sp) \n"
+    "sw x24, 24*4(sp) \n"
+    "sw x25, 25*4(sp) \n"
+    "sw x26, 26*4(sp) \n"
+    "sw x27, 27*4(sp) \n"
+#endif
+    "csrr x6, mhartid  \n" // publish base address of the original context
+    "slli x6, x6, 2    \n"
+    "la   x9, %[ctx]   \n"
+    "add  x9, x9, x6   \n"
+    "lw   x8, 0(x9)    \n" // keep previous context (nesting); x8/x9 are callee-saved
+    "sw   sp, 0(x9)    \n"
+    RTE_CALL_HANDLER
+    "sw   x8, 0(x9)    \n"
+    "lw x3,  3*4(sp) \n"
+    "lw x4,  4*4(sp) \n"
+    "lw x8,  8*4(sp) \n"
+    "lw x9,  9*4(sp) \n"
+#ifndef __riscv_32e
+    "lw x18, 18*4(sp) \n"
+    "lw x19, 19*4(sp) \n"
+    "lw x20, 20*4(sp) \n"
+    "lw x21, 21*4(sp) \n"
+    "lw x22, 22*4(sp) \n"
+    "lw x23, 23*4(sp) \n"
+    "lw x24, 24*4(sp) \n"
+    "lw x25, 25*4(sp) \n"
+    "lw x26, 26*4(sp) \n"
+    "lw x27, 27*4(sp) \n"
+#endif
+    "j    2f           \n"
+
+    // fast handler: callee-saved registers are preserved by the handler itself
+    "1:                \n"
+    RTE_CALL_HANDLER
+
+    // tail-chaining: directly dispatch the next pending & enabled interrupt
+    // without restoring and saving the context again
+    "2:                \n"
+    "csrr x5, mip      \n"
+    "csrr x6, mie      \n"
+    "and  x5, x5, x6   \n"
+    "bnez x5, 6f       \n"
+
+    // re-arm ISR stack if it was used by this trap (mscratch = ISR stack top)
+    "lw   x1, 0*4(sp)  \n"
+    "beqz x1, 4f       \n"
+#ifndef __riscv_32e
+    "addi x1, sp, 32*4 \n"
+#else
+    "addi x1, sp, 16*4 \n"
+#endif
+    "csrw mscratch, x1 \n"
+    "4:                \n"
+
+    // restore caller-saved registers
+    "lw x1,  1*4(sp) \n"
+    "lw x5,  5*4(sp) \n"
+    "lw x6,  6*4(sp) \n"
+    "lw x7,  7*4(sp) \n"
+    "lw x10, 10*4(sp) \n"
+    "lw x11, 11*4(sp) \n"
+    "lw x12, 12*4(sp) \n"
+    "lw x13, 13*4(sp) \n"
+    "lw x14, 14*4(sp) \n"
+    "lw x15, 15*4(sp) \n"
+#ifndef __riscv_32e
+    "lw x16, 16*4(sp) \n"
+    "lw x17, 17*4(sp) \n"
+    "lw x28, 28*4(sp) \n"
+    "lw x29, 29*4(sp) \n"
+    "lw x30, 30*4(sp) \n"
+    "lw x31, 31*4(sp) \n"
+#endif
+    "lw x2,   2*4(sp) \n" // restore original stack pointer
+    "mret             \n"
+
+    // select pending interrupt according to the hardware priority:
+    // FIRQ0 (highest) ... FIRQ15, MEI, MSI, MTI (lowest);
+    // x7 = trap cause, x10 = 4 * (RTE trap ID)
+    "6:                \n"
+    "srli x6, x5, 16   \n" // pending fast interrupts
+    "beqz x6, 8f       \n"
+#if defined(__riscv_zbb)
+    "ctz  x6, x6       \n"
+    "addi x7, x6, 16   \n"
+    "addi x10, x6, 13  \n"
+    "slli x10, x10, 2  \n"
+#else
+    "li   x7, 16       \n"
+    "li   x10, 13*4    \n"
+    "7:                \n"
+    "andi x5, x6, 1    \n"
+    "bnez x5, 9f       \n"
+    "srli x6, x6, 1    \n"
+    "addi x7, x7, 1    \n"
+    "addi x10, x10, 4  \n"
+    "j    7b           \n"
+#endif
+    "j    9f           \n"
+    "8:                \n"
+    "li   x7, 11       \n" // machine external interrupt
+    "li   x10, 12*4    \n"
+    "srli x6, x5, 11   \n"
+    "andi x6, x6, 1    \n"
+    "bnez x6, 9f       \n"
+    "li   x7, 3        \n" // machine software interrupt
+    "li   x10, 10*4    \n"
+    "andi x6, x5, 1<<3 \n"
+    "bnez x6, 9f       \n"
+    "li   x7, 7        \n" // machine timer interrupt
+    "li   x10, 11*4    \n"
+    "9:                \n"
+    "lui  x6, 0x80000  \n" // interrupt flag
+    "or   x7, x7, x6   \n"
+    "csrw mcause, x7   \n" // second-level handlers might evaluate the trap cause
+    "j    5b           \n"
+    : : [lut] "i" (&__neorv32_rte_vector_lut[0][0]), [ctx] "i" (&__neorv32_rte_context[0]),
+        [mask] "i" (&__neorv32_rte_irq_mask[0][0]), [held] "i" (&__neorv32_rte_irq_held[0]),
+        [nest] "i" (&__neorv32_rte_irq_nest[0])
+  );
+}
+#undef RTE_CALL_HANDLER
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Read register from application context (on stack).
@@ -268,13 +984,20 @@ void __attribute__((__naked__,aligned(4))) neorv32_rte_core(void) {
  **************************************************************************/
 uint32_t neorv32_rte_context_get(int x) {
 
-  // MSCRATCH CSR contains the stack pointer of the interrupted program
-  uint32_t tmp = neorv32_cpu_csr_read(CSR_MSCRATCH);
 #ifdef __riscv_32e
-  tmp += (x & 15) << 2;
+  x &= 15;
 #else
-  tmp += (x & 31) << 2;
+  x &= 31;
 #endif
+
+  // x0 is hardwired to zero; its frame slot is used internally by the RTE
+  if (x == 0) {
+    return 0;
+  }
+
+  // base address of the interrupted program's context (stack frame)
+  uint32_t tmp = __neorv32_rte_context[neorv32_cpu_csr_read(CSR_MHARTID)];
+  tmp += x << 2;
   return neorv32_cpu_load_unsigned_word(tmp);
 }
 
@@ -292,17 +1015,78 @@ uint32_t neorv32_rte_context_get(int x) {
  **************************************************************************/
 void neorv32_rte_context_put(int x, uint32_t data) {
 
-  // MSCRATCH CSR contains the stack pointer of the interrupted program
-  uint32_t tmp = neorv32_cpu_csr_read(CSR_MSCRATCH);
 #ifdef __riscv_32e
-  tmp += (x & 15) << 2;
+  x &= 15;
 #else
-  tmp += (x & 31) << 2;
+  x &= 31;
 #endif
+
+  // x0 is hardwired to zero; its frame slot is used internally by the RTE
+  if (x == 0) {
+    return;
+  }
+
+  // base address of the interrupted program's context (stack frame)
+  uint32_t tmp = __neorv32_rte_context[neorv32_cpu_csr_read(CSR_MHARTID)];
+  tmp += x << 2;
   neorv32_cpu_store_unsigned_word(tmp, data);
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Exchange the interrupted program's context with another one (context switch).
+ * The interrupted program's return address and registers are saved and the
+ * interrupt handler returns to the restored context instead.
+ *
+ * @note This function operates on the RTE instance of the
+ * core on which this function is executed.
+ *
+ * @note Can only be used by regular (not fast) interrupt handlers. The handler must
+ * not change mstatus.MIE before calling this function: if the RTE has enabled interrupts
+ * for higher-priority sources (see #neorv32_rte_irq_priority_set()) the return address
+ * is taken from (and written to) the RTE's nesting backup instead of MEPC.
+ *
+ * @param[out] save Buffer for the current context (#NEORV32_RTE_CONTEXT_WORDS words):
+ * word 0 = return address (MEPC), words 1..n = registers x1..xn.
+ *
+ * @param[in] restore Context to be restored (same layout).
+ *
+ * @return 0 if success, -1 if not called from an interrupt handler.
+ **************************************************************************/
+int neorv32_rte_context_switch(uint32_t *save, const uint32_t *restore) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  if (((mstatus & (1 << CSR_MSTATUS_MIE)) == 0) && ((int32_t)neorv32_cpu_csr_read(CSR_MCAUSE) >= 0)) {
+    return -1; // exceptions adjust MEPC after the handler
+  }
+
+  // base address of the interrupted program's context (stack frame); the x0 slot is used by the RTE
+  volatile uint32_t *frame = (volatile uint32_t*)__neorv32_rte_context[neorv32_cpu_csr_read(CSR_MHARTID)];
+  int i;
+  for (i = 1; i < NEORV32_RTE_CONTEXT_WORDS; i++) {
+    save[i] = frame[i];
+    frame[i] = restore[i];
+  }
+
+  // return address: nesting backup (MEPC/MSTATUS/held MIE bits/MCAUSE) right below the frame if interrupts
+  // have been enabled by the RTE, MEPC otherwise
+  if (mstatus & (1 << CSR_MSTATUS_MIE)) {
+    save[0] = frame[-4];
+    frame[-4] = restore[0];
+  }
+  else {
+    save[0] = neorv32_cpu_csr_read(CSR_MEPC);
+    neorv32_cpu_csr_write(CSR_MEPC, restore[0]);
+  }
+
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  return 0;
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Debug trap handler, printing information via UART0.
@@ -385,7 +1169,7 @@ void neorv32_rte_debug_handler(void) {
   // unhandled IRQ - disable interrupt channel
   if (((int32_t)trap_cause) < 0) { // is interrupt
     neorv32_uart0_puts(" Disabling IRQ source");
-    neorv32_cpu_csr_clr(CSR_MIE, 1 << (trap_cause & 0x1f));
+    __neorv32_rte_irq_mie_clr(1 << (trap_cause & 0x1f));
   }
 
   // halt if fatal exception
@@ -406,6 +1190,92 @@ void neorv32_rte_debug_handler(void) {
 // Private helper functions
 // ------------------------------------------------------------------------------------------------
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private function to write a trap handler table entry.
+ *
+ * @param[in] hart Hart ID of the targeted core (0..#NEORV32_RTE_MAX_HARTS-1).
+ * @param[in] id Identifier (type) of the targeted trap. See #NEORV32_RTE_TRAP_enum.
+ * @param[in] entry Handler address; bit 0 set = fast handler.
+ *
+ * @return 0 if success, -1 if invalid trap ID or invalid hart ID.
+ **************************************************************************/
+static int __neorv32_rte_install(int hart, int id, uint32_t entry) {
+
+  // check if invalid trap ID or hart ID
+  uint32_t index = (uint32_t)id;
+  if ((index >= NEORV32_RTE_NUM_TRAPS) || (((uint32_t)hart) >= NEORV32_RTE_MAX_HARTS)) {
+    return -1;
+  }
+
+  // install handler
+  __neorv32_rte_vector_lut[hart][index] = entry;
+  asm volatile ("fence"); // flush updated handler table to main memory
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private function to get the MIE/MIP bit of an interrupt.
+ *
+ * @param[in] id Identifier (type) of the interrupt (#RTE_TRAP_MSI and above).
+ *
+ * @return MIE/MIP bit mask.
+ **************************************************************************/
+static uint32_t __neorv32_rte_irq_mie_bit(int id) {
+
+  switch (id) {
+    case RTE_TRAP_MSI: return 1 << CSR_MIE_MSIE;
+    case RTE_TRAP_MTI: return 1 << CSR_MIE_MTIE;
+    case RTE_TRAP_MEI: return 1 << CSR_MIE_MEIE;
+    default:           return 1U << (CSR_MIE_FIRQ0E + (id - RTE_TRAP_FIRQ_0));
+  }
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private function to disable interrupt sources in MIE (including sources that
+ * are currently held by handler nesting).
+ *
+ * @param[in] mask MIE bit mask of the sources to be disabled.
+ **************************************************************************/
+static void __neorv32_rte_irq_mie_clr(uint32_t mask) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  neorv32_cpu_csr_clr(CSR_MIE, mask);
+  if (hart < NEORV32_RTE_MAX_HARTS) {
+    __neorv32_rte_irq_held[hart] &= ~mask;
+  }
+
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private function to get the number of cores that are handled by the RTE.
+ *
+ * @return Number of available cores (1..#NEORV32_RTE_MAX_HARTS).
+ **************************************************************************/
+static int __neorv32_rte_num_harts(void) {
+
+  int num_harts = (int)neorv32_sysinfo_get_numcores();
+  if (num_harts < 1) {
+    num_harts = 1;
+  }
+  if (num_harts > NEORV32_RTE_MAX_HARTS) {
+    num_harts = NEORV32_RTE_MAX_HARTS;
+  }
+  return num_harts;
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Private function to print the lowest 0 to 8 hex characters of a
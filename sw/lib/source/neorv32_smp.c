@@ -99,3 +99,282 @@ uint32_t neorv32_smp_icc_pop(void) {
   while (neorv32_smp_icc_avail() == 0); // wait until FIFO data is available
   return neorv32_smp_icc_get();
 }
+
+
+// ------------------------------------------------------------------------------------------------
+// Persistent worker and parallel loops
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Parallel loop work descriptor (shared by both cores).
+ **************************************************************************/
+typedef struct {
+  neorv32_smp_for_t     fn_for;    /**< loop body (parallel_for) */
+  neorv32_smp_reduce_t  fn_reduce; /**< loop body (parallel_reduce) */
+  neorv32_smp_combine_t combine;   /**< combine partial results (parallel_reduce) */
+  void     *ctx;                   /**< user context */
+  uint32_t begin;                  /**< first iteration */
+  uint32_t end;                    /**< last iteration + 1 */
+  uint32_t grain;                  /**< iterations per chunk */
+  uint32_t chunks;                 /**< number of chunks */
+  uint32_t identity;               /**< neutral element of combine */
+  uint32_t next;                   /**< next chunk to be claimed (atomic access or HWSPINLOCK) */
+  uint32_t lock;                   /**< chunks are claimed using the HWSPINLOCK */
+} __neorv32_smp_job_t;
+
+
+/**********************************************************************//**
+ * Work descriptor and worker / parallel region status.
+ **************************************************************************/
+static __neorv32_smp_job_t __neorv32_smp_job;
+static volatile uint32_t __neorv32_smp_worker_running = 0;
+static volatile uint32_t __neorv32_smp_parallel_active = 0;
+
+
+/**********************************************************************//**
+ * Private function: claim the next chunk of a parallel loop.
+ *
+ * @note Chunks are handed out dynamically (first come, first served) so unbalanced
+ * loops are distributed automatically. Without the A ISA extension and without the
+ * HWSPINLOCK module chunks are interleaved statically (core 0 gets the even chunks,
+ * core 1 the odd ones).
+ *
+ * @param[in,out] job Work descriptor.
+ * @param[in] core Core ID (0 or 1).
+ * @param[in] n Number of chunks this core has already claimed.
+ * @return Chunk index (>= job->chunks if there is no work left).
+ **************************************************************************/
+static uint32_t __neorv32_smp_claim(__neorv32_smp_job_t *job, uint32_t core, uint32_t n) {
+
+#if defined __riscv_atomic
+  (void)core;
+  (void)n;
+  return __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED); // -> amoadd.w (bypasses the caches)
+#else
+  uint32_t k;
+  if (job->lock) {
+    neorv32_hwspinlock_acquire_blocking(NEORV32_SMP_HWSPINLOCK);
+    asm volatile ("fence");
+    k = job->next++;
+    asm volatile ("fence");
+    neorv32_hwspinlock_release(NEORV32_SMP_HWSPINLOCK);
+    return k;
+  }
+  return 2*n + core;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: process chunks of a parallel loop until there is no work left.
+ *
+ * @param[in,out] job Work descriptor.
+ * @param[in] core Core ID (0 or 1).
+ * @return Partial result of this core (parallel_reduce only).
+ **************************************************************************/
+static uint32_t __neorv32_smp_run(__neorv32_smp_job_t *job, uint32_t core) {
+
+  uint32_t k, n = 0, begin, end, acc = job->identity;
+
+  while (1) {
+    k = __neorv32_smp_claim(job, core, n++);
+    if (k >= job->chunks) {
+      break;
+    }
+    begin = job->begin + k * job->grain;
+    end = ((job->end - begin) > job->grain) ? (begin + job->grain) : job->end;
+    if (job->fn_reduce != NULL) {
+      acc = job->combine(acc, job->fn_reduce(begin, end, job->ctx));
+    }
+    else {
+      job->fn_for(begin, end, job->ctx);
+    }
+  }
+  return acc;
+}
+
+
+/**********************************************************************//**
+ * Private function: persistent worker (main function of core 1). Sleeps until
+ * core 0 sends the address of a work descriptor via the ICC link and an MSI,
+ * processes chunks and sends its partial result back via the ICC link.
+ *
+ * @return Does not return.
+ **************************************************************************/
+static int __neorv32_smp_worker(void) {
+
+  __neorv32_smp_job_t *job;
+  uint32_t result;
+
+  neorv32_rte_setup();
+
+  // the MSI is used as wake-up source only; interrupts remain globally disabled
+  neorv32_cpu_csr_write(CSR_MIE, 1 << CSR_MIE_MSIE);
+
+  while (1) {
+    neorv32_clint_msi_clr(1);
+    if (neorv32_smp_icc_avail() == 0) {
+      neorv32_cpu_sleep(); // wakes up on pending MSI
+      continue;
+    }
+    job = (__neorv32_smp_job_t*)neorv32_smp_icc_get();
+    asm volatile ("fence"); // reload work descriptor from main memory
+    result = __neorv32_smp_run(job, 1);
+    asm volatile ("fence"); // make loop results visible to core 0
+    neorv32_smp_icc_push(result);
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Private function: execute parallel loop on both cores.
+ *
+ * @param[in] begin First iteration.
+ * @param[in] end Last iteration + 1.
+ * @param[in] grain Iterations per chunk; 0 = automatic (1/16 of the iterations).
+ * @param[in] fn_for Loop body (parallel_for) or NULL.
+ * @param[in] fn_reduce Loop body (parallel_reduce) or NULL.
+ * @param[in] combine Combine function (parallel_reduce) or NULL.
+ * @param[in] identity Neutral element of combine.
+ * @param[in] ctx User context.
+ * @return Result (parallel_reduce only).
+ **************************************************************************/
+static uint32_t __neorv32_smp_parallel(uint32_t begin, uint32_t end, uint32_t grain,
+                                       neorv32_smp_for_t fn_for, neorv32_smp_reduce_t fn_reduce,
+                                       neorv32_smp_combine_t combine, uint32_t identity, void *ctx) {
+
+  __neorv32_smp_job_t *job = &__neorv32_smp_job;
+  uint32_t acc;
+
+  if (begin >= end) {
+    return identity;
+  }
+  if (grain == 0) {
+    grain = ((end - begin) + 15) / 16;
+  }
+
+  // serial execution: no worker, called on core 1, nested call or just a single chunk
+  if ((__neorv32_smp_worker_running == 0) || (neorv32_cpu_csr_read(CSR_MHARTID) != 0) ||
+      (__neorv32_smp_parallel_active != 0) || ((end - begin) <= grain)) {
+    if (fn_reduce != NULL) {
+      return combine(identity, fn_reduce(begin, end, ctx));
+    }
+    fn_for(begin, end, ctx);
+    return identity;
+  }
+  __neorv32_smp_parallel_active = 1;
+
+  // setup work descriptor
+  job->fn_for    = fn_for;
+  job->fn_reduce = fn_reduce;
+  job->combine   = combine;
+  job->ctx       = ctx;
+  job->begin     = begin;
+  job->end       = end;
+  job->grain     = grain;
+  job->chunks    = ((end - begin) - 1) / grain + 1;
+  job->identity  = identity;
+  job->next      = 0;
+#if defined __riscv_atomic
+  job->lock      = 0;
+#else
+  job->lock      = (uint32_t)neorv32_hwspinlock_available();
+#endif
+  asm volatile ("fence"); // make work descriptor (and loop input data) visible to core 1
+
+  // wake up worker
+  neorv32_smp_icc_push((uint32_t)job);
+  neorv32_clint_msi_set(1);
+
+  // join processing
+  acc = __neorv32_smp_run(job, 0);
+
+  // wait for worker's partial result
+  uint32_t result = neorv32_smp_icc_pop();
+  asm volatile ("fence"); // reload loop results of core 1
+  if (fn_reduce != NULL) {
+    acc = combine(acc, result);
+  }
+
+  __neorv32_smp_parallel_active = 0;
+  return acc;
+}
+
+
+/**********************************************************************//**
+ * Launch the persistent parallel loop worker on core 1. The worker sleeps until
+ * #neorv32_smp_parallel_for() or #neorv32_smp_parallel_reduce() hand out work.
+ *
+ * @warning This function can be executed on core 0 only. Core 1 and its ICC link
+ * are dedicated to the worker afterwards.
+ *
+ * @param[in] stack_memory Pointer to beginning of core1's stack memory array.
+ * Should be at least 512 bytes (plus the stack usage of the loop bodies).
+ *
+ * @param[in] stack_size_bytes Core1's stack size in bytes.
+ *
+ * @return 0 if launching succeeded, -1 if invalid hart ID or CLINT not available,
+ * -2 if core1 is not responding.
+ **************************************************************************/
+int neorv32_smp_worker_start(uint8_t* stack_memory, size_t stack_size_bytes) {
+
+  int rc = neorv32_smp_launch(__neorv32_smp_worker, stack_memory, stack_size_bytes);
+
+  if (rc == 0) {
+    __neorv32_smp_worker_running = 1;
+  }
+  return rc;
+}
+
+
+/**********************************************************************//**
+ * Execute loop in parallel on both cores: fn(b, e, ctx) is called for disjoint chunks
+ * [b, e) of [begin, end) of up to grain iterations. Chunks are assigned dynamically
+ * so loops with unbalanced iterations are distributed automatically.
+ *
+ * @note The loop is executed serially on the calling core if the worker has not been
+ * started (#neorv32_smp_worker_start()), if called on core 1 or from within a parallel loop.
+ *
+ * @param[in] begin First iteration.
+ * @param[in] end Last iteration + 1.
+ * @param[in] grain Iterations per chunk; 0 = automatic (1/16 of the iterations). Smaller
+ * chunks balance better, larger chunks have less overhead.
+ * @param[in] fn Loop body.
+ * @param[in] ctx User context that is passed to the loop body.
+ * @return 0 if success, -1 if fn is NULL.
+ **************************************************************************/
+int neorv32_smp_parallel_for(uint32_t begin, uint32_t end, uint32_t grain, neorv32_smp_for_t fn, void *ctx) {
+
+  if (fn == NULL) {
+    return -1;
+  }
+  __neorv32_smp_parallel(begin, end, grain, fn, NULL, NULL, 0, ctx);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Execute reduction in parallel on both cores: fn(b, e, ctx) is called for disjoint
+ * chunks [b, e) of [begin, end) and all partial results are combined via combine().
+ *
+ * @note See #neorv32_smp_parallel_for(). The order in which partial results are
+ * combined is not defined.
+ *
+ * @param[in] begin First iteration.
+ * @param[in] end Last iteration + 1.
+ * @param[in] grain Iterations per chunk; 0 = automatic (1/16 of the iterations).
+ * @param[in] fn Loop body returning the partial result of a chunk.
+ * @param[in] combine Combine two partial results (associative and commutative, e.g. sum).
+ * @param[in] identity Neutral element of combine (e.g. 0 for a sum).
+ * @param[in] ctx User context that is passed to the loop body.
+ * @return Combined result; identity if the range is empty or fn / combine is NULL.
+ **************************************************************************/
+uint32_t neorv32_smp_parallel_reduce(uint32_t begin, uint32_t end, uint32_t grain, neorv32_smp_reduce_t fn,
+                                     neorv32_smp_combine_t combine, uint32_t identity, void *ctx) {
+
+  if ((fn == NULL) || (combine == NULL)) {
+    return identity;
+  }
+  return __neorv32_smp_parallel(begin, end, grain, NULL, fn, combine, identity, ctx);
+}
@@ -0,0 +1,437 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_swtimer.c
+ * @brief Software timers (hierarchical timing wheel on CLINT MTIMECMP) source file.
+ *
+ * @note Time is counted in resolution units of 2^#NEORV32_SWTIMER_SHIFT MTIME ticks. Each wheel
+ * level represents one 5-bit digit of the expiration time. A timer is placed on the level of the
+ * most significant digit in which its expiration time differs from the wheel's current time, in
+ * the slot given by that digit. When the current time reaches the beginning of an occupied slot,
+ * the slot's timers are moved to lower levels (cascading) and finally expire. The next
+ * interesting point in time is derived from the slot occupancy bitmaps of all levels.
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name Wheel geometry and list IDs
+ **************************************************************************/
+/**@{*/
+#define SWTIMER_SLOTS    32   // slots per level (one bit of a 32-bit occupancy bitmap each)
+#define SWTIMER_BITS     5    // log2(SWTIMER_SLOTS)
+#define SWTIMER_OVERFLOW 0xfd // timer is on the overflow list
+#define SWTIMER_DUE      0xfe // timer is on the due list
+#define SWTIMER_INACTIVE 0xff // timer is not linked to any list
+/**@}*/
+
+#if (NEORV32_SWTIMER_LEVELS < 1) || (NEORV32_SWTIMER_LEVELS > 7)
+#error "NEORV32_SWTIMER_LEVELS has to be 1..7"
+#endif
+
+
+/**********************************************************************//**
+ * Timing wheel of one core.
+ **************************************************************************/
+typedef struct {
+  neorv32_swtimer_t *slot[NEORV32_SWTIMER_LEVELS][SWTIMER_SLOTS]; /**< timer lists of each slot */
+  uint32_t          bitmap[NEORV32_SWTIMER_LEVELS];              /**< occupied slots of each level */
+  neorv32_swtimer_t *due;                                         /**< expired timers */
+  neorv32_swtimer_t *overflow;                                    /**< timers beyond the wheel's range */
+  uint64_t          now;                                          /**< current time (resolution units) */
+  uint32_t          ready;                                        /**< wheel has been set up */
+} __neorv32_swtimer_wheel_t;
+
+
+/**********************************************************************//**
+ * Timing wheel of each core.
+ **************************************************************************/
+static __neorv32_swtimer_wheel_t __neorv32_swtimer_wheel[NEORV32_RTE_MAX_HARTS];
+
+
+/**********************************************************************//**
+ * Private function: add timer to the beginning of a list.
+ *
+ * @param[in,out] head List head.
+ * @param[in,out] timer Timer.
+ * @param[in] list List ID.
+ **************************************************************************/
+static void __neorv32_swtimer_link(neorv32_swtimer_t **head, neorv32_swtimer_t *timer, uint8_t list) {
+
+  timer->next = *head;
+  if (*head != NULL) {
+    (*head)->pprev = &timer->next;
+  }
+  *head = timer;
+  timer->pprev = head;
+  timer->list = list;
+}
+
+
+/**********************************************************************//**
+ * Private function: remove timer from its list.
+ *
+ * @param[in,out] w Timing wheel.
+ * @param[in,out] timer Timer (must be linked to a list).
+ **************************************************************************/
+static void __neorv32_swtimer_unlink(__neorv32_swtimer_wheel_t *w, neorv32_swtimer_t *timer) {
+
+  uint32_t level, slot;
+
+  *timer->pprev = timer->next;
+  if (timer->next != NULL) {
+    timer->next->pprev = timer->pprev;
+  }
+
+  if (timer->list < (NEORV32_SWTIMER_LEVELS * SWTIMER_SLOTS)) {
+    level = timer->list / SWTIMER_SLOTS;
+    slot  = timer->list % SWTIMER_SLOTS;
+    if (w->slot[level][slot] == NULL) {
+      w->bitmap[level] &= ~(1u << slot);
+    }
+  }
+  timer->list = SWTIMER_INACTIVE;
+}
+
+
+/**********************************************************************//**
+ * Private function: add timer to the wheel according to its expiration time.
+ *
+ * @param[in,out] w Timing wheel.
+ * @param[in,out] timer Timer (must not be linked to any list).
+ **************************************************************************/
+static void __neorv32_swtimer_insert(__neorv32_swtimer_wheel_t *w, neorv32_swtimer_t *timer) {
+
+  uint64_t expire = (timer->time + ((1ULL << NEORV32_SWTIMER_SHIFT) - 1)) >> NEORV32_SWTIMER_SHIFT; // round up
+  uint64_t diff = expire ^ w->now;
+  uint32_t level, slot;
+
+  if (expire <= w->now) {
+    __neorv32_swtimer_link(&w->due, timer, SWTIMER_DUE);
+    return;
+  }
+  if ((diff >> (SWTIMER_BITS * NEORV32_SWTIMER_LEVELS)) != 0) {
+    __neorv32_swtimer_link(&w->overflow, timer, SWTIMER_OVERFLOW);
+    return;
+  }
+
+  // most significant differing digit
+  level = 0;
+  while ((diff >> (SWTIMER_BITS * (level + 1))) != 0) {
+    level++;
+  }
+  slot = (uint32_t)(expire >> (SWTIMER_BITS * level)) & (SWTIMER_SLOTS - 1);
+
+  __neorv32_swtimer_link(&w->slot[level][slot], timer, (uint8_t)(level * SWTIMER_SLOTS + slot));
+  w->bitmap[level] |= 1u << slot;
+}
+
+
+/**********************************************************************//**
+ * Private function: get next point in time at which the wheel has to be processed.
+ *
+ * @param[in] w Timing wheel.
+ * @return Time in resolution units (UINT64_MAX if there are no active timers).
+ **************************************************************************/
+static uint64_t __neorv32_swtimer_next(__neorv32_swtimer_wheel_t *w) {
+
+  uint64_t next = UINT64_MAX, tmp;
+  uint32_t level, shift;
+
+  if (w->due != NULL) {
+    return w->now;
+  }
+
+  // occupied slots are always ahead of the current time's digit; the lowest one is the next event
+  for (level=0; level<NEORV32_SWTIMER_LEVELS; level++) {
+    if (w->bitmap[level]) {
+      shift = SWTIMER_BITS * level;
+      tmp = ((w->now >> (shift + SWTIMER_BITS)) << (shift + SWTIMER_BITS)) |
+            ((uint64_t)__builtin_ctz(w->bitmap[level]) << shift);
+      if (tmp < next) {
+        next = tmp;
+      }
+    }
+  }
+
+  // overflow timers are re-inserted when the wheel's range is left
+  if (w->overflow != NULL) {
+    shift = SWTIMER_BITS * NEORV32_SWTIMER_LEVELS;
+    tmp = ((w->now >> shift) + 1) << shift;
+    if (tmp < next) {
+      next = tmp;
+    }
+  }
+
+  return next;
+}
+
+
+/**********************************************************************//**
+ * Private function: re-insert all timers of a list.
+ *
+ * @param[in,out] w Timing wheel.
+ * @param[in] list First timer of the list (already detached from the wheel).
+ **************************************************************************/
+static void __neorv32_swtimer_reinsert(__neorv32_swtimer_wheel_t *w, neorv32_swtimer_t *list) {
+
+  neorv32_swtimer_t *next;
+
+  while (list != NULL) {
+    next = list->next;
+    __neorv32_swtimer_insert(w, list);
+    list = next;
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: advance wheel to a specific time and execute all expired timers.
+ *
+ * @param[in,out] w Timing wheel.
+ * @param[in] now Current time in resolution units.
+ **************************************************************************/
+static void __neorv32_swtimer_advance(__neorv32_swtimer_wheel_t *w, uint64_t now) {
+
+  uint64_t next;
+  uint32_t level, slot;
+  neorv32_swtimer_t *list, *timer;
+
+  while ((next = __neorv32_swtimer_next(w)) <= now) {
+
+    if (next != w->now) {
+      if ((next >> (SWTIMER_BITS * NEORV32_SWTIMER_LEVELS)) != (w->now >> (SWTIMER_BITS * NEORV32_SWTIMER_LEVELS))) {
+        list = w->overflow;
+        w->overflow = NULL;
+        w->now = next;
+        __neorv32_swtimer_reinsert(w, list);
+      }
+      w->now = next;
+
+      // cascade (or expire) all slots that start at the current time
+      for (level=0; level<NEORV32_SWTIMER_LEVELS; level++) {
+        slot = (uint32_t)(next >> (SWTIMER_BITS * level)) & (SWTIMER_SLOTS - 1);
+        if (w->bitmap[level] & (1u << slot)) {
+          list = w->slot[level][slot];
+          w->slot[level][slot] = NULL;
+          w->bitmap[level] &= ~(1u << slot);
+          __neorv32_swtimer_reinsert(w, list);
+        }
+      }
+    }
+
+    // execute expired timers; callbacks may start/stop any timer
+    while ((timer = w->due) != NULL) {
+      __neorv32_swtimer_unlink(w, timer);
+      if (timer->period != 0) {
+        timer->time += timer->period;
+        __neorv32_swtimer_insert(w, timer);
+      }
+      timer->callback(timer->arg);
+    }
+  }
+
+  if (now > w->now) {
+    w->now = now;
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: program MTIMECMP to the next wheel event.
+ *
+ * @param[in] w Timing wheel.
+ **************************************************************************/
+static void __neorv32_swtimer_program(__neorv32_swtimer_wheel_t *w) {
+
+  uint64_t next = __neorv32_swtimer_next(w);
+
+  if (next == UINT64_MAX) {
+    neorv32_clint_mtimecmp_set(-1);
+  }
+  else {
+    neorv32_clint_mtimecmp_set(next << NEORV32_SWTIMER_SHIFT);
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: machine timer interrupt handler.
+ *
+ * @note The timer interrupt is acknowledged by programming MTIMECMP to a future time.
+ * If the next event has already passed, the interrupt stays pending and the handler is
+ * executed again.
+ **************************************************************************/
+static void __neorv32_swtimer_irq_handler(void) {
+
+  __neorv32_swtimer_wheel_t *w = &__neorv32_swtimer_wheel[neorv32_cpu_csr_read(CSR_MHARTID)];
+
+  __neorv32_swtimer_advance(w, neorv32_clint_time_get() >> NEORV32_SWTIMER_SHIFT);
+  __neorv32_swtimer_program(w);
+}
+
+
+/**********************************************************************//**
+ * Setup software timer service for the calling core: install the machine timer
+ * interrupt handler (RTE) and enable the machine timer interrupt.
+ *
+ * @note Each core that uses software timers has to call this function once (after
+ * #neorv32_rte_setup()). Interrupts have to be enabled globally by the application.
+ *
+ * @warning The CLINT's MTIMECMP register of the calling core is exclusively used by this service.
+ *
+ * @return 0 if success, -1 if CLINT not available or invalid core.
+ **************************************************************************/
+int neorv32_swtimer_setup(void) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_swtimer_wheel_t *w;
+  uint32_t i;
+
+  if ((neorv32_clint_available() == 0) || (hart >= NEORV32_RTE_MAX_HARTS)) {
+    return -1;
+  }
+
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << CSR_MIE_MTIE);
+  neorv32_clint_mtimecmp_set(-1);
+
+  w = &__neorv32_swtimer_wheel[hart];
+  for (i=0; i<NEORV32_SWTIMER_LEVELS; i++) {
+    w->bitmap[i] = 0;
+  }
+  for (i=0; i<(NEORV32_SWTIMER_LEVELS * SWTIMER_SLOTS); i++) {
+    w->slot[i / SWTIMER_SLOTS][i % SWTIMER_SLOTS] = NULL;
+  }
+  w->due      = NULL;
+  w->overflow = NULL;
+  w->now      = neorv32_clint_time_get() >> NEORV32_SWTIMER_SHIFT;
+  w->ready    = 1;
+
+  neorv32_rte_handler_install_hart((int)hart, RTE_TRAP_MTI, __neorv32_swtimer_irq_handler);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MTIE);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Initialize a software timer.
+ *
+ * @param[in,out] timer Timer.
+ * @param[in] callback Function that is called when the timer expires (in interrupt context
+ * of the core that has started the timer).
+ * @param[in] arg Argument for the callback function.
+ **************************************************************************/
+void neorv32_swtimer_init(neorv32_swtimer_t *timer, void (*callback)(void *arg), void *arg) {
+
+  timer->next     = NULL;
+  timer->pprev    = NULL;
+  timer->time     = 0;
+  timer->period   = 0;
+  timer->callback = callback;
+  timer->arg      = arg;
+  timer->list     = SWTIMER_INACTIVE;
+  timer->hart     = 0;
+}
+
+
+/**********************************************************************//**
+ * Start (or restart) a software timer on the calling core, relative to the current time.
+ *
+ * @param[in,out] timer Timer.
+ * @param[in] delay Time until the first expiration in MTIME ticks.
+ * @param[in] period Reload period in MTIME ticks (0 = one-shot timer).
+ * @return 0 if success, -1 if service not set up on this core or timer is running on another core.
+ **************************************************************************/
+int neorv32_swtimer_start(neorv32_swtimer_t *timer, uint64_t delay, uint64_t period) {
+
+  return neorv32_swtimer_start_at(timer, neorv32_clint_time_get() + delay, period);
+}
+
+
+/**********************************************************************//**
+ * Start (or restart) a software timer on the calling core at an absolute time.
+ * Periodic timers are reloaded relative to their expiration time, so they do not drift.
+ *
+ * @param[in,out] timer Timer.
+ * @param[in] time Time of the first expiration (MTIME).
+ * @param[in] period Reload period in MTIME ticks (0 = one-shot timer).
+ * @return 0 if success, -1 if service not set up on this core or timer is running on another core.
+ **************************************************************************/
+int neorv32_swtimer_start_at(neorv32_swtimer_t *timer, uint64_t time, uint64_t period) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  __neorv32_swtimer_wheel_t *w;
+  uint32_t mstatus;
+
+  if ((hart >= NEORV32_RTE_MAX_HARTS) || (__neorv32_swtimer_wheel[hart].ready == 0)) {
+    return -1;
+  }
+  if ((timer->list != SWTIMER_INACTIVE) && (timer->hart != hart)) {
+    return -1;
+  }
+  w = &__neorv32_swtimer_wheel[hart];
+
+  mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  if (timer->list != SWTIMER_INACTIVE) {
+    __neorv32_swtimer_unlink(w, timer);
+  }
+  timer->time   = time;
+  timer->period = period;
+  timer->hart   = (uint8_t)hart;
+  __neorv32_swtimer_insert(w, timer);
+  __neorv32_swtimer_program(w);
+
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Stop a software timer. Can also be called from the timer's own callback.
+ *
+ * @note This has to be called on the core that has started the timer.
+ *
+ * @param[in,out] timer Timer.
+ * @return 0 if success (or timer not running), -1 if timer is running on another core.
+ **************************************************************************/
+int neorv32_swtimer_stop(neorv32_swtimer_t *timer) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  uint32_t mstatus;
+
+  mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  if (timer->list != SWTIMER_INACTIVE) {
+    if (timer->hart != hart) {
+      neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+      return -1;
+    }
+    __neorv32_swtimer_unlink(&__neorv32_swtimer_wheel[hart], timer);
+  }
+
+  // MTIMECMP is not updated; an interrupt for a stopped timer has no effect
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Check if a software timer is running.
+ *
+ * @param[in] timer Timer.
+ * @return 1 if timer is running, 0 if not.
+ **************************************************************************/
+int neorv32_swtimer_active(neorv32_swtimer_t *timer) {
+
+  return (timer->list != SWTIMER_INACTIVE) ? 1 : 0;
+}
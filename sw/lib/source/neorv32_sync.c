@@ -0,0 +1,514 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_sync.c
+ * @brief SMP synchronization primitives (ticket locks, reader-writer locks, barriers,
+ * once-flags) source file.
+ *
+ * @note Waiting cores poll with exponential backoff so they do not saturate the shared
+ * bus (slowing down the core that holds the lock). Ticket locks back off proportionally
+ * to the number of waiters in front of them.
+ */
+
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * Reader-writer lock state.
+ **************************************************************************/
+#define RWLOCK_WRITER  0x80000000u // lock is held by a writer
+#define RWLOCK_WAITING 0x40000000u // a writer is waiting (blocks new readers)
+
+
+#if !defined __riscv_atomic
+/**********************************************************************//**
+ * HWSPINLOCK usage (0 = not probed yet, 1 = not used, 2 = used).
+ **************************************************************************/
+static uint32_t __neorv32_sync_hwlock = 0;
+
+
+/**********************************************************************//**
+ * Private function: there is no mutual exclusion across cores (multi-core without A ISA
+ * extension and HWSPINLOCK). Print an error message via UART0 (if available) and halt
+ * the calling core.
+ **************************************************************************/
+static void __neorv32_sync_error(void) {
+
+  if (neorv32_uart0_available()) {
+    neorv32_uart0_puts("<NEORV32-SYNC> [ERROR] SMP synchronization requires the A ISA extension "
+                       "or the HWSPINLOCK! Halting CPU\n");
+  }
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  while (1) {
+    asm volatile ("wfi");
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: enter critical section (disable interrupts, acquire HWSPINLOCK).
+ *
+ * @note Halts the calling core if there is no mutual exclusion across cores. As all
+ * objects are initialized by atomic accesses, this already happens in the init functions.
+ *
+ * @return Previous mstatus.
+ **************************************************************************/
+static uint32_t __neorv32_sync_enter(void) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  if (__neorv32_sync_hwlock == 0) {
+    if (neorv32_sysinfo_get_numcores() > 1) {
+      if (neorv32_hwspinlock_available() == 0) {
+        __neorv32_sync_error();
+      }
+      __neorv32_sync_hwlock = 2;
+    }
+    else {
+      __neorv32_sync_hwlock = 1;
+    }
+  }
+  if (__neorv32_sync_hwlock == 2) {
+    neorv32_hwspinlock_acquire_blocking(NEORV32_SYNC_HWSPINLOCK);
+  }
+  asm volatile ("fence"); // reload object from main memory
+  return mstatus;
+}
+
+
+/**********************************************************************//**
+ * Private function: leave critical section.
+ *
+ * @param[in] mstatus Previous mstatus (from #__neorv32_sync_enter()).
+ **************************************************************************/
+static void __neorv32_sync_exit(uint32_t mstatus) {
+
+  asm volatile ("fence"); // write back object to main memory
+  if (__neorv32_sync_hwlock == 2) {
+    neorv32_hwspinlock_release(NEORV32_SYNC_HWSPINLOCK);
+  }
+  neorv32_cpu_csr_write(CSR_MSTATUS, mstatus);
+}
+#endif
+
+
+/**********************************************************************//**
+ * Private function: load word from shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @return Data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_sync_load(volatile uint32_t *addr) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_or(addr, 0, __ATOMIC_SEQ_CST); // -> amoor.w
+#else
+  asm volatile ("fence"); // invalidate cached copy
+  return *addr;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: atomic swap.
+ *
+ * @param[in] addr Address.
+ * @param[in] data New data word.
+ * @return Previous data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_sync_swap(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  return __atomic_exchange_n(addr, data, __ATOMIC_SEQ_CST); // -> amoswap.w
+#else
+  uint32_t mstatus = __neorv32_sync_enter();
+  uint32_t old = *addr;
+  *addr = data;
+  __neorv32_sync_exit(mstatus);
+  return old;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: atomic add.
+ *
+ * @param[in] addr Address.
+ * @param[in] data Value to be added.
+ * @return Previous data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_sync_add(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_add(addr, data, __ATOMIC_SEQ_CST); // -> amoadd.w
+#else
+  uint32_t mstatus = __neorv32_sync_enter();
+  uint32_t old = *addr;
+  *addr = old + data;
+  __neorv32_sync_exit(mstatus);
+  return old;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: atomic bit-wise AND.
+ *
+ * @param[in] addr Address.
+ * @param[in] data Mask.
+ * @return Previous data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_sync_and(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_and(addr, data, __ATOMIC_SEQ_CST); // -> amoand.w
+#else
+  uint32_t mstatus = __neorv32_sync_enter();
+  uint32_t old = *addr;
+  *addr = old & data;
+  __neorv32_sync_exit(mstatus);
+  return old;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: atomic bit-wise OR.
+ *
+ * @param[in] addr Address.
+ * @param[in] data Mask.
+ * @return Previous data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_sync_or(volatile uint32_t *addr, uint32_t data) {
+
+#if defined __riscv_atomic
+  return __atomic_fetch_or(addr, data, __ATOMIC_SEQ_CST); // -> amoor.w
+#else
+  uint32_t mstatus = __neorv32_sync_enter();
+  uint32_t old = *addr;
+  *addr = old | data;
+  __neorv32_sync_exit(mstatus);
+  return old;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: atomic compare-and-swap.
+ *
+ * @param[in] addr Address.
+ * @param[in] expected Expected data word.
+ * @param[in] desired New data word.
+ * @return 1 if swapped, 0 if the data word did not match.
+ **************************************************************************/
+static inline int __neorv32_sync_cas(volatile uint32_t *addr, uint32_t expected, uint32_t desired) {
+
+#if defined __riscv_atomic
+  return __sync_bool_compare_and_swap(addr, expected, desired) ? 1 : 0; // -> lr/sc
+#else
+  int ok = 0;
+  uint32_t mstatus = __neorv32_sync_enter();
+  if (*addr == expected) {
+    *addr = desired;
+    ok = 1;
+  }
+  __neorv32_sync_exit(mstatus);
+  return ok;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Private function: busy wait.
+ *
+ * @param[in] n Number of iterations.
+ **************************************************************************/
+static inline void __neorv32_sync_delay(uint32_t n) {
+
+  while (n--) {
+    asm volatile ("nop");
+  }
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// Backoff
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Exponential backoff: busy-wait for *delay iterations (without accessing memory) and
+ * double the delay for the next call (up to #NEORV32_SYNC_BACKOFF_MAX).
+ *
+ * @param[in,out] delay Current delay; initialize with 1 before the first call.
+ **************************************************************************/
+void neorv32_sync_backoff(uint32_t *delay) {
+
+  __neorv32_sync_delay(*delay);
+  if (*delay < NEORV32_SYNC_BACKOFF_MAX) {
+    *delay <<= 1;
+  }
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// Ticket lock
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Initialize ticket lock (unlocked).
+ *
+ * @param[in,out] lock Ticket lock.
+ **************************************************************************/
+void neorv32_sync_ticket_init(neorv32_sync_ticket_t *lock) {
+
+  asm volatile ("fence"); // write back cached initialization before atomic accesses
+  __neorv32_sync_swap(&lock->next, 0);
+  __neorv32_sync_swap(&lock->owner, 0);
+}
+
+
+/**********************************************************************//**
+ * Acquire ticket lock (blocking). Cores acquire the lock in the order of their requests.
+ *
+ * @warning The lock is not recursive. Do not acquire a lock in an interrupt handler that
+ * can interrupt the owner of the same lock.
+ *
+ * @param[in,out] lock Ticket lock.
+ **************************************************************************/
+void neorv32_sync_ticket_acquire(neorv32_sync_ticket_t *lock) {
+
+  uint32_t ticket = __neorv32_sync_add(&lock->next, 1);
+  uint32_t owner, delay;
+
+  while (1) {
+    owner = __neorv32_sync_load(&lock->owner);
+    if (owner == ticket) {
+      break;
+    }
+    // proportional backoff: wait longer if there are more cores in front of us
+    delay = (ticket - owner) * (NEORV32_SYNC_BACKOFF_MAX / 4);
+    __neorv32_sync_delay((delay < NEORV32_SYNC_BACKOFF_MAX) ? delay : NEORV32_SYNC_BACKOFF_MAX);
+  }
+  asm volatile ("fence"); // reload protected data
+}
+
+
+/**********************************************************************//**
+ * Try to acquire ticket lock (non-blocking).
+ *
+ * @param[in,out] lock Ticket lock.
+ * @return 0 if the lock has been acquired, -1 if it is locked.
+ **************************************************************************/
+int neorv32_sync_ticket_try(neorv32_sync_ticket_t *lock) {
+
+  uint32_t owner = __neorv32_sync_load(&lock->owner);
+
+  if (__neorv32_sync_cas(&lock->next, owner, owner + 1)) {
+    asm volatile ("fence"); // reload protected data
+    return 0;
+  }
+  return -1;
+}
+
+
+/**********************************************************************//**
+ * Release ticket lock.
+ *
+ * @param[in,out] lock Ticket lock.
+ **************************************************************************/
+void neorv32_sync_ticket_release(neorv32_sync_ticket_t *lock) {
+
+  asm volatile ("fence"); // write back protected data
+  __neorv32_sync_add(&lock->owner, 1);
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// Reader-writer lock
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Initialize reader-writer lock (unlocked).
+ *
+ * @param[in,out] lock Reader-writer lock.
+ **************************************************************************/
+void neorv32_sync_rwlock_init(neorv32_sync_rwlock_t *lock) {
+
+  asm volatile ("fence"); // write back cached initialization before atomic accesses
+  __neorv32_sync_swap(&lock->state, 0);
+}
+
+
+/**********************************************************************//**
+ * Acquire reader-writer lock for reading (blocking). Multiple readers can hold the lock
+ * at the same time; new readers wait if a writer holds or waits for the lock.
+ *
+ * @param[in,out] lock Reader-writer lock.
+ **************************************************************************/
+void neorv32_sync_rwlock_rdlock(neorv32_sync_rwlock_t *lock) {
+
+  uint32_t state, delay = 1;
+
+  while (1) {
+    state = __neorv32_sync_load(&lock->state);
+    if (((state & (RWLOCK_WRITER | RWLOCK_WAITING)) == 0) && __neorv32_sync_cas(&lock->state, state, state + 1)) {
+      break;
+    }
+    neorv32_sync_backoff(&delay);
+  }
+  asm volatile ("fence"); // reload protected data
+}
+
+
+/**********************************************************************//**
+ * Release reader-writer lock (reader).
+ *
+ * @param[in,out] lock Reader-writer lock.
+ **************************************************************************/
+void neorv32_sync_rwlock_rdunlock(neorv32_sync_rwlock_t *lock) {
+
+  __neorv32_sync_add(&lock->state, (uint32_t)-1);
+}
+
+
+/**********************************************************************//**
+ * Acquire reader-writer lock for writing (blocking, exclusive).
+ *
+ * @param[in,out] lock Reader-writer lock.
+ **************************************************************************/
+void neorv32_sync_rwlock_wrlock(neorv32_sync_rwlock_t *lock) {
+
+  uint32_t state, delay = 1;
+
+  while (1) {
+    state = __neorv32_sync_load(&lock->state);
+    if ((state & ~RWLOCK_WAITING) == 0) { // no readers and no writer
+      if (__neorv32_sync_cas(&lock->state, state, RWLOCK_WRITER)) {
+        break;
+      }
+      continue;
+    }
+    if ((state & RWLOCK_WAITING) == 0) {
+      __neorv32_sync_or(&lock->state, RWLOCK_WAITING); // block new readers
+    }
+    neorv32_sync_backoff(&delay);
+  }
+  asm volatile ("fence"); // reload protected data
+}
+
+
+/**********************************************************************//**
+ * Release reader-writer lock (writer).
+ *
+ * @param[in,out] lock Reader-writer lock.
+ **************************************************************************/
+void neorv32_sync_rwlock_wrunlock(neorv32_sync_rwlock_t *lock) {
+
+  asm volatile ("fence"); // write back protected data
+  __neorv32_sync_and(&lock->state, ~RWLOCK_WRITER);
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// Barrier
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Initialize sense-reversing barrier.
+ *
+ * @note Must not be called while cores are waiting at the barrier.
+ *
+ * @param[in,out] barrier Barrier.
+ * @param[in] num Number of participants (1..#NEORV32_RTE_MAX_HARTS, one per core).
+ * @return 0 if success, -1 if invalid number of participants.
+ **************************************************************************/
+int neorv32_sync_barrier_init(neorv32_sync_barrier_t *barrier, uint32_t num) {
+
+  uint32_t i;
+
+  if ((num == 0) || (num > NEORV32_RTE_MAX_HARTS)) {
+    return -1;
+  }
+
+  asm volatile ("fence"); // write back cached initialization before atomic accesses
+  __neorv32_sync_swap(&barrier->count, 0);
+  __neorv32_sync_swap(&barrier->sense, 0);
+  __neorv32_sync_swap(&barrier->num, num);
+  for (i=0; i<NEORV32_RTE_MAX_HARTS; i++) {
+    __neorv32_sync_swap(&barrier->local[i], 0);
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Wait until all participants have arrived at the barrier. Data written by any participant
+ * before the barrier is visible to all participants afterwards.
+ *
+ * @param[in,out] barrier Barrier.
+ **************************************************************************/
+void neorv32_sync_barrier_wait(neorv32_sync_barrier_t *barrier) {
+
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID);
+  uint32_t delay = 1;
+  uint32_t sense = __neorv32_sync_load(&barrier->local[hart]) ^ 1;
+
+  __neorv32_sync_swap(&barrier->local[hart], sense);
+  asm volatile ("fence"); // write back data of this participant
+
+  if (__neorv32_sync_add(&barrier->count, 1) == (__neorv32_sync_load(&barrier->num) - 1)) {
+    // last one: reset counter and release all others
+    __neorv32_sync_swap(&barrier->count, 0);
+    __neorv32_sync_swap(&barrier->sense, sense);
+  }
+  else {
+    while (__neorv32_sync_load(&barrier->sense) != sense) {
+      neorv32_sync_backoff(&delay);
+    }
+  }
+  asm volatile ("fence"); // reload data of all other participants
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// Once-flag
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Execute a function exactly once, even if called by several cores at the same time.
+ * All callers return after the function has been completed.
+ *
+ * @warning Do not call from an interrupt handler that can interrupt the execution of fn.
+ *
+ * @param[in,out] once Once-flag (zero-initialized).
+ * @param[in] fn Function to be executed.
+ **************************************************************************/
+void neorv32_sync_once(neorv32_sync_once_t *once, void (*fn)(void)) {
+
+  uint32_t delay = 1;
+
+  if (__neorv32_sync_load(&once->state) == 2) {
+    asm volatile ("fence"); // reload data initialized by fn
+    return;
+  }
+
+  if (__neorv32_sync_cas(&once->state, 0, 1)) {
+    fn();
+    asm volatile ("fence"); // write back data initialized by fn
+    __neorv32_sync_swap(&once->state, 2);
+    return;
+  }
+
+  while (__neorv32_sync_load(&once->state) != 2) {
+    neorv32_sync_backoff(&delay);
+  }
+  asm volatile ("fence"); // reload data initialized by fn
+}
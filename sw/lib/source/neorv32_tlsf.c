@@ -0,0 +1,517 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_tlsf.c
+ * @brief Two-level segregated fit (TLSF) memory allocator source file.
+ *
+ * @note Allocation and release are O(1): free blocks are kept in segregated lists that
+ * are located via two bitmaps; physically adjacent free blocks are merged immediately.
+ * Each block has an 8-byte header (previous physical block, size + free flag).
+ */
+
+#include <neorv32.h>
+#include <string.h>
+#include <errno.h>
+
+
+/**********************************************************************//**
+ * @name Internal parameters
+ **************************************************************************/
+/**@{*/
+#define TLSF_SL_NUM     (1 << NEORV32_TLSF_SL_LOG2)                    /**< second-level lists per class */
+#define TLSF_FL_SHIFT   (NEORV32_TLSF_SL_LOG2 + 3)                     /**< log2 of smallest first-level class */
+#define TLSF_SMALL      (1 << TLSF_FL_SHIFT)                           /**< blocks below this size are in class 0 */
+#define TLSF_HDR        8                                              /**< block header size */
+#define TLSF_MIN        8                                              /**< minimum payload size (free list links) */
+#define TLSF_MAX        ((1u << (NEORV32_TLSF_FL_NUM + TLSF_FL_SHIFT - 1)) - NEORV32_TLSF_ALIGN) /**< maximum payload */
+#define TLSF_FREE       (1 << 0)                                       /**< size field: block is free */
+/**@}*/
+
+
+/**********************************************************************//**
+ * Memory block. Used blocks only contain the header; the list links are part of the payload.
+ **************************************************************************/
+typedef struct __neorv32_tlsf_block {
+  struct __neorv32_tlsf_block *prev_phys; /**< previous physical block (NULL for the first block) */
+  uint32_t size;                          /**< payload size in bytes | TLSF_FREE */
+  struct __neorv32_tlsf_block *next_free; /**< next free block in list (free blocks only) */
+  struct __neorv32_tlsf_block *prev_free; /**< previous free block in list (free blocks only) */
+} __neorv32_tlsf_block_t;
+
+
+/**********************************************************************//**
+ * Default heap (linker script's heap region).
+ **************************************************************************/
+static neorv32_tlsf_t __neorv32_tlsf_heap;
+static int __neorv32_tlsf_heap_init = 0;
+
+
+/**********************************************************************//**
+ * Private helper functions.
+ **************************************************************************/
+/**@{*/
+static inline uint32_t __neorv32_tlsf_size(__neorv32_tlsf_block_t *b) {
+  return b->size & ~(uint32_t)(NEORV32_TLSF_ALIGN - 1);
+}
+static inline __neorv32_tlsf_block_t *__neorv32_tlsf_next(__neorv32_tlsf_block_t *b) {
+  return (__neorv32_tlsf_block_t*)((uint8_t*)b + TLSF_HDR + __neorv32_tlsf_size(b));
+}
+static inline int __neorv32_tlsf_fls(uint32_t x) { // index of most significant set bit
+  return 31 - __builtin_clz(x);
+}
+/**@}*/
+
+
+/**********************************************************************//**
+ * Private function: get list indices of a block size.
+ *
+ * @param[in] size Block size.
+ * @param[out] fl First-level index.
+ * @param[out] sl Second-level index.
+ **************************************************************************/
+static void __neorv32_tlsf_mapping(uint32_t size, int *fl, int *sl) {
+
+  int f;
+
+  if (size < TLSF_SMALL) {
+    *fl = 0;
+    *sl = (int)(size / (TLSF_SMALL / TLSF_SL_NUM));
+  }
+  else {
+    f = __neorv32_tlsf_fls(size);
+    *sl = (int)((size >> (f - NEORV32_TLSF_SL_LOG2)) ^ TLSF_SL_NUM);
+    *fl = f - (TLSF_FL_SHIFT - 1);
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: insert block into its free list.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] b Free block.
+ **************************************************************************/
+static void __neorv32_tlsf_insert(neorv32_tlsf_t *tlsf, __neorv32_tlsf_block_t *b) {
+
+  int fl, sl;
+  __neorv32_tlsf_mapping(__neorv32_tlsf_size(b), &fl, &sl);
+
+  __neorv32_tlsf_block_t *head = (__neorv32_tlsf_block_t*)tlsf->blocks[fl][sl];
+  b->next_free = head;
+  b->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = b;
+  }
+  tlsf->blocks[fl][sl] = b;
+  tlsf->fl_bitmap |= 1u << fl;
+  tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+
+/**********************************************************************//**
+ * Private function: remove block from its free list.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] b Free block.
+ **************************************************************************/
+static void __neorv32_tlsf_remove(neorv32_tlsf_t *tlsf, __neorv32_tlsf_block_t *b) {
+
+  int fl, sl;
+  __neorv32_tlsf_mapping(__neorv32_tlsf_size(b), &fl, &sl);
+
+  if (b->next_free != NULL) {
+    b->next_free->prev_free = b->prev_free;
+  }
+  if (b->prev_free != NULL) {
+    b->prev_free->next_free = b->next_free;
+  }
+  else { // list head
+    tlsf->blocks[fl][sl] = b->next_free;
+    if (b->next_free == NULL) {
+      tlsf->sl_bitmap[fl] &= ~(1u << sl);
+      if (tlsf->sl_bitmap[fl] == 0) {
+        tlsf->fl_bitmap &= ~(1u << fl);
+      }
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: find a free block that is at least as large as size.
+ *
+ * @param[in] tlsf TLSF control structure.
+ * @param[in] size Requested size (aligned).
+ * @return Free block (still in its list) or NULL if there is none.
+ **************************************************************************/
+static __neorv32_tlsf_block_t *__neorv32_tlsf_search(neorv32_tlsf_t *tlsf, uint32_t size) {
+
+  int fl, sl;
+  uint32_t map;
+
+  // round up to the next list so that any block of that list is large enough
+  if (size >= TLSF_SMALL) {
+    size += (1u << (__neorv32_tlsf_fls(size) - NEORV32_TLSF_SL_LOG2)) - 1;
+  }
+  __neorv32_tlsf_mapping(size, &fl, &sl);
+  if (fl >= NEORV32_TLSF_FL_NUM) {
+    return NULL;
+  }
+
+  map = tlsf->sl_bitmap[fl] & (~0u << sl);
+  if (map == 0) { // no suitable list in this class: use next non-empty class
+    map = tlsf->fl_bitmap & (~0u << (fl + 1));
+    if (map == 0) {
+      return NULL;
+    }
+    fl = __builtin_ctz(map);
+    map = tlsf->sl_bitmap[fl];
+  }
+  sl = __builtin_ctz(map);
+  return (__neorv32_tlsf_block_t*)tlsf->blocks[fl][sl];
+}
+
+
+/**********************************************************************//**
+ * Private function: merge a free block with its free physical neighbors.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] b Free block (not in a list).
+ * @return Merged block (not in a list).
+ **************************************************************************/
+static __neorv32_tlsf_block_t *__neorv32_tlsf_merge(neorv32_tlsf_t *tlsf, __neorv32_tlsf_block_t *b) {
+
+  __neorv32_tlsf_block_t *n = __neorv32_tlsf_next(b);
+  __neorv32_tlsf_block_t *p = b->prev_phys;
+
+  if (n->size & TLSF_FREE) { // absorb next block
+    __neorv32_tlsf_remove(tlsf, n);
+    b->size += TLSF_HDR + __neorv32_tlsf_size(n);
+    __neorv32_tlsf_next(b)->prev_phys = b;
+  }
+  if ((p != NULL) && (p->size & TLSF_FREE)) { // get absorbed by previous block
+    __neorv32_tlsf_remove(tlsf, p);
+    p->size += TLSF_HDR + __neorv32_tlsf_size(b);
+    __neorv32_tlsf_next(p)->prev_phys = p;
+    b = p;
+  }
+  return b;
+}
+
+
+/**********************************************************************//**
+ * Private function: shrink a used block to size and release the remainder (if large enough).
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] b Used block.
+ * @param[in] size New payload size (aligned).
+ **************************************************************************/
+static void __neorv32_tlsf_trim(neorv32_tlsf_t *tlsf, __neorv32_tlsf_block_t *b, uint32_t size) {
+
+  uint32_t bsize = __neorv32_tlsf_size(b);
+
+  if (bsize >= (size + TLSF_HDR + TLSF_MIN)) {
+    __neorv32_tlsf_block_t *r = (__neorv32_tlsf_block_t*)((uint8_t*)b + TLSF_HDR + size);
+    r->size = (bsize - size - TLSF_HDR) | TLSF_FREE;
+    r->prev_phys = b;
+    __neorv32_tlsf_next(r)->prev_phys = r;
+    b->size = size;
+    __neorv32_tlsf_insert(tlsf, __neorv32_tlsf_merge(tlsf, r));
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: round requested size up to the block granularity.
+ *
+ * @param[in] size Requested size in bytes.
+ * @return Aligned size or 0 if too large.
+ **************************************************************************/
+static uint32_t __neorv32_tlsf_adjust(size_t size) {
+
+  if (size > TLSF_MAX) {
+    return 0;
+  }
+  if (size < TLSF_MIN) {
+    return TLSF_MIN;
+  }
+  return ((uint32_t)size + (NEORV32_TLSF_ALIGN - 1)) & ~(uint32_t)(NEORV32_TLSF_ALIGN - 1);
+}
+
+
+/**********************************************************************//**
+ * Initialize a TLSF memory pool.
+ *
+ * @note The TLSF functions are not thread-safe; the caller has to provide mutual exclusion
+ * if a pool is shared between cores or used from interrupt handlers.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] mem Pool memory.
+ * @param[in] size Size of pool memory in bytes (at least 32).
+ * @return 0 if success, -1 if pool memory is too small.
+ **************************************************************************/
+int neorv32_tlsf_init(neorv32_tlsf_t *tlsf, void *mem, size_t size) {
+
+  uint32_t begin = ((uint32_t)mem + (NEORV32_TLSF_ALIGN - 1)) & ~(uint32_t)(NEORV32_TLSF_ALIGN - 1);
+  uint32_t end = ((uint32_t)mem + (uint32_t)size) & ~(uint32_t)(NEORV32_TLSF_ALIGN - 1);
+
+  memset((void*)tlsf, 0, sizeof(neorv32_tlsf_t));
+
+  if ((end <= begin) || ((end - begin) < (2*TLSF_HDR + TLSF_MIN))) {
+    return -1;
+  }
+  if ((end - begin) > (TLSF_MAX + 2*TLSF_HDR)) {
+    end = begin + TLSF_MAX + 2*TLSF_HDR;
+  }
+
+  // one large free block followed by a zero-size used sentinel block
+  __neorv32_tlsf_block_t *b = (__neorv32_tlsf_block_t*)begin;
+  b->prev_phys = NULL;
+  b->size = (end - begin - 2*TLSF_HDR) | TLSF_FREE;
+  __neorv32_tlsf_block_t *s = __neorv32_tlsf_next(b);
+  s->prev_phys = b;
+  s->size = 0;
+
+  tlsf->total = __neorv32_tlsf_size(b);
+  __neorv32_tlsf_insert(tlsf, b);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Allocate memory from a TLSF pool.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in] size Number of bytes.
+ * @return Pointer to memory (8-byte aligned) or NULL if out of memory.
+ **************************************************************************/
+void *neorv32_tlsf_malloc(neorv32_tlsf_t *tlsf, size_t size) {
+
+  uint32_t asize = __neorv32_tlsf_adjust(size);
+  __neorv32_tlsf_block_t *b;
+
+  if ((asize == 0) || ((b = __neorv32_tlsf_search(tlsf, asize)) == NULL)) {
+    return NULL;
+  }
+
+  __neorv32_tlsf_remove(tlsf, b);
+  b->size &= ~(uint32_t)TLSF_FREE;
+  __neorv32_tlsf_trim(tlsf, b, asize);
+
+  tlsf->used += __neorv32_tlsf_size(b);
+  if (tlsf->used > tlsf->peak) {
+    tlsf->peak = tlsf->used;
+  }
+  return (void*)((uint8_t*)b + TLSF_HDR);
+}
+
+
+/**********************************************************************//**
+ * Release memory to a TLSF pool.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] ptr Memory allocated by #neorv32_tlsf_malloc() (NULL is ignored).
+ **************************************************************************/
+void neorv32_tlsf_free(neorv32_tlsf_t *tlsf, void *ptr) {
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  __neorv32_tlsf_block_t *b = (__neorv32_tlsf_block_t*)((uint8_t*)ptr - TLSF_HDR);
+  tlsf->used -= __neorv32_tlsf_size(b);
+  b->size |= TLSF_FREE;
+  __neorv32_tlsf_insert(tlsf, __neorv32_tlsf_merge(tlsf, b));
+}
+
+
+/**********************************************************************//**
+ * Resize memory from a TLSF pool. The block is resized in place if possible.
+ *
+ * @param[in,out] tlsf TLSF control structure.
+ * @param[in,out] ptr Memory allocated by #neorv32_tlsf_malloc() (NULL: allocate).
+ * @param[in] size New size in bytes (0: release).
+ * @return Pointer to resized memory or NULL if out of memory (original memory is unchanged).
+ **************************************************************************/
+void *neorv32_tlsf_realloc(neorv32_tlsf_t *tlsf, void *ptr, size_t size) {
+
+  if (ptr == NULL) {
+    return neorv32_tlsf_malloc(tlsf, size);
+  }
+  if (size == 0) {
+    neorv32_tlsf_free(tlsf, ptr);
+    return NULL;
+  }
+
+  uint32_t asize = __neorv32_tlsf_adjust(size);
+  if (asize == 0) {
+    return NULL;
+  }
+
+  __neorv32_tlsf_block_t *b = (__neorv32_tlsf_block_t*)((uint8_t*)ptr - TLSF_HDR);
+  __neorv32_tlsf_block_t *n = __neorv32_tlsf_next(b);
+  uint32_t bsize = __neorv32_tlsf_size(b);
+
+  // grow in place by absorbing the next block
+  if ((asize > bsize) && (n->size & TLSF_FREE) && ((bsize + TLSF_HDR + __neorv32_tlsf_size(n)) >= asize)) {
+    __neorv32_tlsf_remove(tlsf, n);
+    b->size += TLSF_HDR + __neorv32_tlsf_size(n);
+    __neorv32_tlsf_next(b)->prev_phys = b;
+  }
+
+  // shrink in place (also trims an extended block)
+  if (__neorv32_tlsf_size(b) >= asize) {
+    __neorv32_tlsf_trim(tlsf, b, asize);
+    tlsf->used = tlsf->used - bsize + __neorv32_tlsf_size(b);
+    if (tlsf->used > tlsf->peak) {
+      tlsf->peak = tlsf->used;
+    }
+    return ptr;
+  }
+
+  // move
+  void *p = neorv32_tlsf_malloc(tlsf, asize);
+  if (p != NULL) {
+    memcpy(p, ptr, bsize);
+    neorv32_tlsf_free(tlsf, ptr);
+  }
+  return p;
+}
+
+
+/**********************************************************************//**
+ * Get TLSF pool statistics.
+ *
+ * @note This function is not O(1): it traverses all free lists.
+ *
+ * @param[in] tlsf TLSF control structure.
+ * @param[out] stats Statistics, #neorv32_tlsf_stats_t.
+ **************************************************************************/
+void neorv32_tlsf_get_stats(neorv32_tlsf_t *tlsf, neorv32_tlsf_stats_t *stats) {
+
+  int fl, sl;
+  uint32_t free_bytes = 0, size;
+  __neorv32_tlsf_block_t *b;
+
+  stats->total   = tlsf->total;
+  stats->used    = tlsf->used;
+  stats->peak    = tlsf->peak;
+  stats->largest = 0;
+
+  // largest free block: largest block of the highest non-empty list
+  if (tlsf->fl_bitmap) {
+    fl = __neorv32_tlsf_fls(tlsf->fl_bitmap);
+    sl = __neorv32_tlsf_fls(tlsf->sl_bitmap[fl]);
+    for (b = (__neorv32_tlsf_block_t*)tlsf->blocks[fl][sl]; b != NULL; b = b->next_free) {
+      size = __neorv32_tlsf_size(b);
+      if (size > stats->largest) {
+        stats->largest = size;
+      }
+    }
+  }
+
+  // free bytes (block headers are not included)
+  for (fl=0; fl<NEORV32_TLSF_FL_NUM; fl++) {
+    for (sl=0; sl<TLSF_SL_NUM; sl++) {
+      for (b = (__neorv32_tlsf_block_t*)tlsf->blocks[fl][sl]; b != NULL; b = b->next_free) {
+        free_bytes += __neorv32_tlsf_size(b);
+      }
+    }
+  }
+  stats->free = free_bytes;
+}
+
+
+/**********************************************************************//**
+ * Get the TLSF pool that manages the linker script's heap region
+ * (#NEORV32_HEAP_BEGIN to #NEORV32_HEAP_END). The pool is initialized on first use.
+ *
+ * @warning The heap must not be used by newlib's allocator at the same time
+ * (see NEORV32_TLSF_MALLOC).
+ *
+ * @return Pointer to heap TLSF control structure or NULL if there is no heap.
+ **************************************************************************/
+neorv32_tlsf_t *neorv32_tlsf_get_heap(void) {
+
+  if (__neorv32_tlsf_heap_init == 0) {
+    if ((NEORV32_HEAP_SIZE == 0) ||
+        (neorv32_tlsf_init(&__neorv32_tlsf_heap, (void*)NEORV32_HEAP_BEGIN, NEORV32_HEAP_END - NEORV32_HEAP_BEGIN))) {
+      return NULL;
+    }
+    __neorv32_tlsf_heap_init = 1;
+  }
+  return &__neorv32_tlsf_heap;
+}
+
+
+#ifdef NEORV32_TLSF_MALLOC
+/**********************************************************************//**
+ * @name Replacements for the C library's allocator functions using the heap TLSF pool.
+ * Protected by newlib's malloc lock (see neorv32_newlib.c).
+ **************************************************************************/
+/**@{*/
+struct _reent;
+void __malloc_lock(struct _reent *r);
+void __malloc_unlock(struct _reent *r);
+
+void *_malloc_r(struct _reent *r, size_t size) {
+  void *p = NULL;
+  __malloc_lock(r);
+  neorv32_tlsf_t *heap = neorv32_tlsf_get_heap();
+  if (heap != NULL) {
+    p = neorv32_tlsf_malloc(heap, size);
+  }
+  __malloc_unlock(r);
+  if (p == NULL) {
+    errno = ENOMEM;
+  }
+  return p;
+}
+
+void _free_r(struct _reent *r, void *ptr) {
+  if (ptr != NULL) {
+    __malloc_lock(r);
+    neorv32_tlsf_free(&__neorv32_tlsf_heap, ptr);
+    __malloc_unlock(r);
+  }
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size) {
+  void *p = NULL;
+  __malloc_lock(r);
+  neorv32_tlsf_t *heap = neorv32_tlsf_get_heap();
+  if (heap != NULL) {
+    p = neorv32_tlsf_realloc(heap, ptr, size);
+  }
+  __malloc_unlock(r);
+  if ((p == NULL) && (size != 0)) {
+    errno = ENOMEM;
+  }
+  return p;
+}
+
+void *_calloc_r(struct _reent *r, size_t num, size_t size) {
+  size_t bytes;
+  if (__builtin_mul_overflow(num, size, &bytes)) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  void *p = _malloc_r(r, bytes);
+  if (p != NULL) {
+    memset(p, 0, bytes);
+  }
+  return p;
+}
+
+void *malloc(size_t size) { return _malloc_r(NULL, size); }
+void free(void *ptr) { _free_r(NULL, ptr); }
+void *realloc(void *ptr, size_t size) { return _realloc_r(NULL, ptr, size); }
+void *calloc(size_t num, size_t size) { return _calloc_r(NULL, num, size); }
+/**@}*/
+#endif
@@ -14,7 +14,6 @@
 #include <neorv32.h>
 #include <string.h>
 #include <stdarg.h>
-#include <ctype.h>
 
 // Drastically reduces the footprint, when knowing that uart is not synthesized anyway.
 #ifdef UART_DISABLED
@@ -34,12 +33,62 @@ char neorv32_uart_getc(neorv32_uart_t *UARTx) {return 0; }
 int  neorv32_uart_char_received(neorv32_uart_t *UARTx) { return 0; }
 char neorv32_uart_char_received_get(neorv32_uart_t *UARTx) { return 0; }
 void neorv32_uart_puts(neorv32_uart_t *UARTx, const char *s) {}
+void neorv32_uart_write(neorv32_uart_t *UARTx, const char *buffer, int length) {}
 void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args) {}
 void neorv32_uart_printf(neorv32_uart_t *UARTx, const char *format, ...) {}
 int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int echo) { return 0; }
+int  neorv32_uart_irq_setup(neorv32_uart_t *UARTx, char *tx_buf, int tx_size, char *rx_buf, int rx_size) { return -1; }
+int  neorv32_uart_irq_write(neorv32_uart_t *UARTx, const char *buffer, int length) { return 0; }
+int  neorv32_uart_irq_read(neorv32_uart_t *UARTx, char *buffer, int length) { return 0; }
+int  neorv32_uart_irq_tx_free(neorv32_uart_t *UARTx) { return 0; }
+int  neorv32_uart_irq_rx_available(neorv32_uart_t *UARTx) { return 0; }
+void neorv32_uart_irq_flush(neorv32_uart_t *UARTx) {}
+int  neorv32_uart_write_dma(neorv32_uart_t *UARTx, const char *buffer, int length) { return -1; }
+int  neorv32_uart_write_dma_done(neorv32_uart_t *UARTx) { return 0; }
 #else
 
 
+// ------------------------------------------------------------------------------------------------
+// Private variables and functions of the interrupt-driven driver
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Software ring buffers of the interrupt-driven driver (one set per UART).
+ **************************************************************************/
+typedef struct {
+  char *tx_buf;              /**< TX ring buffer */
+  uint32_t tx_mask;          /**< TX ring buffer size - 1 */
+  volatile uint32_t tx_head; /**< TX write index (free-running), written by application */
+  volatile uint32_t tx_tail; /**< TX read index (free-running), written by TX interrupt handler */
+  char *rx_buf;              /**< RX ring buffer */
+  uint32_t rx_mask;          /**< RX ring buffer size - 1 */
+  volatile uint32_t rx_head; /**< RX write index (free-running), written by RX interrupt handler */
+  volatile uint32_t rx_tail; /**< RX read index (free-running), written by application */
+} neorv32_uart_irq_buf_t;
+
+static neorv32_uart_irq_buf_t __neorv32_uart_irq_buf[2];
+
+/**********************************************************************//**
+ * State of a DMA-based transmission that has to be restored on completion (one per UART).
+ **************************************************************************/
+typedef struct {
+  uint8_t active;  /**< DMA transmission started by #neorv32_uart_write_dma() */
+  uint8_t tx_irq;  /**< UART_CTRL_IRQ_TX_NHALF was set before the transmission */
+  uint8_t mie_en;  /**< UART TX FIRQ was enabled in MIE before the transmission */
+} neorv32_uart_dma_state_t;
+
+static neorv32_uart_dma_state_t __neorv32_uart_dma_state[2];
+
+static neorv32_uart_irq_buf_t *__neorv32_uart_irq_get_buf(neorv32_uart_t *UARTx);
+static void __neorv32_uart_irq_tx_service(neorv32_uart_t *UARTx, neorv32_uart_irq_buf_t *buf);
+static void __neorv32_uart_irq_rx_service(neorv32_uart_t *UARTx, neorv32_uart_irq_buf_t *buf);
+static void __neorv32_uart0_irq_tx(void);
+static void __neorv32_uart0_irq_rx(void);
+static void __neorv32_uart1_irq_tx(void);
+static void __neorv32_uart1_irq_rx(void);
+
+
+
 /**********************************************************************//**
  * Check if UART unit was synthesized.
  *
@@ -349,94 +398,83 @@ void neorv32_uart_puts(neorv32_uart_t *UARTx, const char *s) {
 
 
 /**********************************************************************//**
- * Custom version of 'vprintf' printing to UART.
+ * Send data block via UART. Data is written in bursts (as many bytes as the
+ * TX FIFO can take) with a single status check per burst.
  *
- * @warning: This functions only provides a minimal subset of the 'vprintf' formating features!
  * @note This function is blocking.
  *
  * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
- * @param[in] format Pointer to format string.
- * @param[in] args A value identifying a variable arguments list.
+ * @param[in] buffer Data to be sent.
+ * @param[in] length Number of bytes to be sent.
  **************************************************************************/
-void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args) {
+void neorv32_uart_write(neorv32_uart_t *UARTx, const char *buffer, int length) {
 
-  char c = 0;
-  char string_buf[36];
-  int32_t n = 0;
-  unsigned int i = 0;
-
-  // prevent uninitialized stack bytes
-  for (i=0; i<sizeof(string_buf); i++) {
-    string_buf[i] = 0;
-  }
-
-  while ((c = *format++)) {
-    if (c == '%') {
-      c = tolower(*format++);
-      switch (c) {
-
-        case 's': // string
-          neorv32_uart_puts(UARTx, va_arg(args, char*));
-          break;
-
-        case 'c': // char
-          neorv32_uart_putc(UARTx, (char)va_arg(args, int));
-          break;
-
-        case 'i': // 32-bit signed
-        case 'd':
-          n = (int32_t)va_arg(args, int32_t);
-          if (n < 0) {
-            n = -n;
-            neorv32_uart_putc(UARTx, '-');
-          }
-          neorv32_aux_itoa(string_buf, (uint32_t)n, 10);
-          neorv32_uart_puts(UARTx, string_buf);
-          break;
-
-        case 'u': // 32-bit unsigned
-          neorv32_aux_itoa(string_buf, va_arg(args, uint32_t), 10);
-          neorv32_uart_puts(UARTx, string_buf);
-          break;
-
-        case 'x': // 32-bit hexadecimal with leading zeros
-        case 'p':
-          neorv32_aux_itoa(string_buf, va_arg(args, uint32_t), 16);
-          i = 8 - strlen(string_buf);
-          while (i--) { // add leading zeros
-            neorv32_uart_putc(UARTx, '0');
-          }
-          neorv32_uart_puts(UARTx, string_buf);
-          break;
-
-        case '%': // escaped percent sign
-          neorv32_uart_putc(UARTx, c);
-          break;
-
-        default: // unsupported formatting character
-          neorv32_uart_putc(UARTx, '%');
-          neorv32_uart_putc(UARTx, c);
-          break;
-      }
+  int depth = neorv32_uart_get_tx_fifo_depth(UARTx);
+  int n;
+  uint32_t ctrl;
+
+  while (length > 0) {
+    ctrl = UARTx->CTRL;
+    if (ctrl & (1 << UART_CTRL_TX_EMPTY)) { // all entries free
+      n = depth;
+    }
+    else if (ctrl & (1 << UART_CTRL_TX_NHALF)) { // at least half of the entries free
+      n = depth >> 1;
+    }
+    else if ((ctrl & (1 << UART_CTRL_TX_FULL)) == 0) { // at least one entry free
+      n = 1;
     }
     else {
-      if (c == '\n') {
-        neorv32_uart_putc(UARTx, '\r');
-      }
-      neorv32_uart_putc(UARTx, c);
+      continue;
+    }
+    if (n > length) {
+      n = length;
+    }
+    length -= n;
+    while (n--) {
+      UARTx->DATA = (uint32_t)((uint8_t)*buffer++) << UART_DATA_RTX_LSB;
     }
   }
 }
 
 
+/**********************************************************************//**
+ * Private output sink for the formatting engine (#neorv32_fmt_sink_t).
+ *
+ * @param[in,out] ctx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] buffer Rendered characters.
+ * @param[in] length Number of characters.
+ **************************************************************************/
+static void __neorv32_uart_fmt_sink(void *ctx, const char *buffer, int length) {
+
+  neorv32_uart_write((neorv32_uart_t*)ctx, buffer, length);
+}
+
+
+/**********************************************************************//**
+ * Custom version of 'vprintf' printing to UART.
+ *
+ * @note The output is rendered by #neorv32_fmt_vprintf() (see there for the supported
+ * formatting features) and sent in TX FIFO-sized bursts. Line breaks "\n" are sent as "\r\n".
+ * @note This function is blocking.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] format Pointer to format string.
+ * @param[in] args A value identifying a variable arguments list.
+ **************************************************************************/
+void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args) {
+
+  neorv32_fmt_vprintf(__neorv32_uart_fmt_sink, (void*)UARTx, NEORV32_FMT_CRLF, format, args);
+}
+
+
 /**********************************************************************//**
  * Custom version of 'printf' printing to UART.
  *
- * @warning: This functions only provides a minimal subset of the 'printf' formatting features!
  * @note This function is blocking.
  *
  * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
- * @param[in] format Pointer to format string. See neorv32_uart_vprintf.
+ * @param[in] format Pointer to format string. See #neorv32_fmt_vprintf().
  **************************************************************************/
 void neorv32_uart_printf(neorv32_uart_t *UARTx, const char *format, ...) {
 
@@ -489,4 +527,390 @@ int neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int ech
   return length;
 }
 
+
+
+// ------------------------------------------------------------------------------------------------
+// Interrupt-driven driver
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Setup interrupt-driven (non-blocking) operation using software ring buffers.
+ *
+ * @note The UART has to be configured via #neorv32_uart_setup() before. This function
+ * installs fast RTE handlers for the UART's RX/TX interrupts and enables them in MIE of
+ * the calling core. Interrupts have to be enabled globally by the application.
+ *
+ * @note The RX interrupt fires if the RX FIFO is at least half-full; remaining data is
+ * fetched by #neorv32_uart_irq_read(). The TX interrupt is active only while there is
+ * data left in the TX ring buffer.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] tx_buf Memory for the TX ring buffer (NULL if not used).
+ * @param[in] tx_size Size of tx_buf in bytes; has to be a power of two (or 0 if not used).
+ * @param[in,out] rx_buf Memory for the RX ring buffer (NULL if not used).
+ * @param[in] rx_size Size of rx_buf in bytes; has to be a power of two (or 0 if not used).
+ * @return 0 if success, -1 if UART not available or invalid buffer size.
+ **************************************************************************/
+int neorv32_uart_irq_setup(neorv32_uart_t *UARTx, char *tx_buf, int tx_size, char *rx_buf, int rx_size) {
+
+  if ((neorv32_uart_available(UARTx) == 0) ||
+      (tx_size < 0) || (tx_size & (tx_size - 1)) || ((tx_size != 0) && (tx_buf == NULL)) ||
+      (rx_size < 0) || (rx_size & (rx_size - 1)) || ((rx_size != 0) && (rx_buf == NULL))) {
+    return -1;
+  }
+
+  int tx_id, rx_id;
+  uint32_t firq;
+  void (*tx_handler)(void), (*rx_handler)(void);
+  if (((uint32_t)UARTx) == NEORV32_UART1_BASE) {
+    tx_id = UART1_TX_RTE_ID;
+    rx_id = UART1_RX_RTE_ID;
+    firq = (1 << UART1_TX_FIRQ_ENABLE) | (1 << UART1_RX_FIRQ_ENABLE);
+    tx_handler = __neorv32_uart1_irq_tx;
+    rx_handler = __neorv32_uart1_irq_rx;
+  }
+  else {
+    tx_id = UART0_TX_RTE_ID;
+    rx_id = UART0_RX_RTE_ID;
+    firq = (1 << UART0_TX_FIRQ_ENABLE) | (1 << UART0_RX_FIRQ_ENABLE);
+    tx_handler = __neorv32_uart0_irq_tx;
+    rx_handler = __neorv32_uart0_irq_rx;
+  }
+
+  // stop interrupt-driven operation
+  neorv32_cpu_csr_clr(CSR_MIE, firq);
+  UARTx->CTRL &= ~((uint32_t)(0x1fU << UART_CTRL_IRQ_RX_NEMPTY));
+
+  // initialize ring buffers
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  buf->tx_buf  = tx_buf;
+  buf->tx_mask = (uint32_t)(tx_size - 1);
+  buf->tx_head = 0;
+  buf->tx_tail = 0;
+  buf->rx_buf  = rx_buf;
+  buf->rx_mask = (uint32_t)(rx_size - 1);
+  buf->rx_head = 0;
+  buf->rx_tail = 0;
+
+  // install handlers; they do not need the interrupted context
+  neorv32_rte_handler_install_fast(tx_id, tx_handler);
+  neorv32_rte_handler_install_fast(rx_id, rx_handler);
+
+  // TX interrupt is enabled on demand
+  if (rx_size != 0) {
+    UARTx->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_RX_HALF);
+  }
+  neorv32_cpu_csr_set(CSR_MIE, firq);
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Write data to the TX ring buffer (non-blocking).
+ *
+ * @note Has to be called on the core that executes the UART interrupt handlers
+ * (the core that has called #neorv32_uart_irq_setup()).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] buffer Data to be sent.
+ * @param[in] length Number of bytes to be sent.
+ * @return Number of bytes actually copied to the TX ring buffer.
+ **************************************************************************/
+int neorv32_uart_irq_write(neorv32_uart_t *UARTx, const char *buffer, int length) {
+
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  if (buf->tx_buf == NULL) {
+    return 0;
+  }
+
+  uint32_t head = buf->tx_head;
+  uint32_t free = (buf->tx_mask + 1) - (head - buf->tx_tail);
+  int cnt = 0;
+
+  while ((cnt < length) && (free != 0)) {
+    buf->tx_buf[head & buf->tx_mask] = buffer[cnt];
+    head++;
+    cnt++;
+    free--;
+  }
+  buf->tx_head = head;
+
+  // (re-)start transmission; the TX interrupt disables itself when there is no more data;
+  // the read-modify-write of CTRL must not interleave with the handler's clear
+  if (cnt != 0) {
+    uint32_t firq = 1 << ((((uint32_t)UARTx) == NEORV32_UART1_BASE) ? UART1_TX_FIRQ_ENABLE : UART0_TX_FIRQ_ENABLE);
+    uint32_t enabled = neorv32_cpu_csr_read(CSR_MIE) & firq; // touch only our own MIE bit
+    neorv32_cpu_csr_clr(CSR_MIE, firq);
+    UARTx->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF);
+    neorv32_cpu_csr_set(CSR_MIE, enabled);
+  }
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Read data from the RX ring buffer (non-blocking).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] buffer Buffer for the received data.
+ * @param[in] length Maximum number of bytes to read.
+ * @return Number of bytes actually read.
+ **************************************************************************/
+int neorv32_uart_irq_read(neorv32_uart_t *UARTx, char *buffer, int length) {
+
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  if (buf->rx_buf == NULL) {
+    return 0;
+  }
+
+  // fetch data that did not trigger the RX interrupt yet (RX FIFO less than half-full)
+  uint32_t firq = 1 << ((((uint32_t)UARTx) == NEORV32_UART1_BASE) ? UART1_RX_FIRQ_ENABLE : UART0_RX_FIRQ_ENABLE);
+  uint32_t enabled = neorv32_cpu_csr_read(CSR_MIE) & firq; // touch only our own MIE bit
+  neorv32_cpu_csr_clr(CSR_MIE, firq);
+  __neorv32_uart_irq_rx_service(UARTx, buf);
+  neorv32_cpu_csr_set(CSR_MIE, enabled);
+
+  uint32_t tail = buf->rx_tail;
+  uint32_t head = buf->rx_head;
+  int cnt = 0;
+
+  while ((cnt < length) && (tail != head)) {
+    buffer[cnt] = buf->rx_buf[tail & buf->rx_mask];
+    tail++;
+    cnt++;
+  }
+  buf->rx_tail = tail;
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Get free space in the TX ring buffer.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Number of bytes that can be written without being discarded.
+ **************************************************************************/
+int neorv32_uart_irq_tx_free(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  if (buf->tx_buf == NULL) {
+    return 0;
+  }
+  return (int)((buf->tx_mask + 1) - (buf->tx_head - buf->tx_tail));
+}
+
+
+/**********************************************************************//**
+ * Get number of bytes available in the RX ring buffer.
+ *
+ * @note Data that is still in the RX FIFO is not taken into account.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Number of bytes that can be read.
+ **************************************************************************/
+int neorv32_uart_irq_rx_available(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  return (int)(buf->rx_head - buf->rx_tail);
+}
+
+
+/**********************************************************************//**
+ * Wait until all data of the TX ring buffer has been sent.
+ *
+ * @note This function is blocking. It does not depend on interrupts being
+ * enabled (e.g. for shutdown paths or if called from a trap handler).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ **************************************************************************/
+void neorv32_uart_irq_flush(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_irq_buf_t *buf = __neorv32_uart_irq_get_buf(UARTx);
+  uint32_t firq = 1 << ((((uint32_t)UARTx) == NEORV32_UART1_BASE) ? UART1_TX_FIRQ_ENABLE : UART0_TX_FIRQ_ENABLE);
+  uint32_t enabled;
+
+  // move data to the TX FIFO ourselves
+  while (buf->tx_tail != buf->tx_head) {
+    enabled = neorv32_cpu_csr_read(CSR_MIE) & firq; // touch only our own MIE bit
+    neorv32_cpu_csr_clr(CSR_MIE, firq);
+    __neorv32_uart_irq_tx_service(UARTx, buf);
+    neorv32_cpu_csr_set(CSR_MIE, enabled);
+  }
+
+  // wait until the last byte has been sent
+  while (neorv32_uart_tx_busy(UARTx));
+}
+
+
+// ------------------------------------------------------------------------------------------------
+// DMA-based transmission
+// ------------------------------------------------------------------------------------------------
+
+/**********************************************************************//**
+ * Send data via DMA (non-blocking). The DMA copies the buffer to the TX FIFO
+ * paced by the UART's "TX FIFO not half-full" interrupt request.
+ *
+ * @note Completion is signaled by the DMA (#DMA_FIRQ_ENABLE interrupt or #neorv32_dma_status()).
+ * The transmission has to be finished by #neorv32_uart_write_dma_done() (polling or from the DMA
+ * interrupt handler), which restores the UART and DMA configuration.
+ *
+ * @warning The UART TX interrupt is not available while the transmission is in progress: the
+ * TX interrupt request line is used by the DMA and the TX FIRQ is masked in MIE of the calling
+ * core. The interrupt-driven TX functions (including the deferred log) must not be used and
+ * the buffer must not be modified until #neorv32_uart_write_dma_done() has returned 0.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] buffer Data to be sent.
+ * @param[in] length Number of bytes to be sent (1..2^24-1).
+ * @return 0 if transfer started, -1 if UART/DMA not available, DMA busy or invalid length.
+ **************************************************************************/
+int neorv32_uart_write_dma(neorv32_uart_t *UARTx, const char *buffer, int length) {
+
+  if ((neorv32_uart_available(UARTx) == 0) || (neorv32_dma_available() == 0) ||
+      (length <= 0) || (length > 0x00ffffff) || (NEORV32_DMA->CTRL & (1 << DMA_CTRL_BUSY))) {
+    return -1;
+  }
+
+  int firq = (((uint32_t)UARTx) == NEORV32_UART1_BASE) ? UART1_TX_FIRQ_ENABLE : UART0_TX_FIRQ_ENABLE;
+  neorv32_uart_dma_state_t *state = &__neorv32_uart_dma_state[(((uint32_t)UARTx) == NEORV32_UART1_BASE) ? 1 : 0];
+
+  // TX interrupt request is used by the DMA only; backup current configuration
+  state->mie_en = (neorv32_cpu_csr_read(CSR_MIE) & (1 << firq)) ? 1 : 0;
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << firq);
+  state->tx_irq = (UARTx->CTRL & (1 << UART_CTRL_IRQ_TX_NHALF)) ? 1 : 0;
+  state->active = 1;
+  UARTx->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF);
+
+  neorv32_dma_desc_t desc;
+  desc.src = (uint32_t)buffer;
+  desc.dst = (uint32_t)(&(UARTx->DATA));
+  desc.num = (uint32_t)length;
+  desc.cmd = DMA_CMD_B2UW | DMA_CMD_SRC_INC | DMA_CMD_DST_CONST;
+
+  neorv32_dma_enable();
+  neorv32_dma_request_enable(firq - CSR_MIE_FIRQ0E);
+  neorv32_dma_transfer(&desc);
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Finish a DMA-based transmission (see #neorv32_uart_write_dma()). If the DMA
+ * transfer has completed, peripheral-paced DMA transfers are disabled (this also
+ * clears a pending DMA interrupt) and the UART's TX interrupt configuration in CTRL
+ * and MIE is restored to the state before the transmission.
+ *
+ * @note Can be polled or called from the DMA interrupt handler. Has to be executed
+ * on the core that started the transmission. The last bytes might still be in the
+ * UART's TX FIFO when this function returns 0 (see #neorv32_uart_tx_busy()).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return 0 if the transmission has completed (or no transmission was started),
+ * 1 if the transmission is still in progress, -1 if the DMA reported a bus error
+ * (configuration is restored anyway).
+ **************************************************************************/
+int neorv32_uart_write_dma_done(neorv32_uart_t *UARTx) {
+
+  int firq = (((uint32_t)UARTx) == NEORV32_UART1_BASE) ? UART1_TX_FIRQ_ENABLE : UART0_TX_FIRQ_ENABLE;
+  neorv32_uart_dma_state_t *state = &__neorv32_uart_dma_state[(((uint32_t)UARTx) == NEORV32_UART1_BASE) ? 1 : 0];
+
+  if (state->active == 0) {
+    return 0;
+  }
+
+  int status = neorv32_dma_status();
+  if (status == DMA_STATUS_BUSY) {
+    return 1;
+  }
+
+  // release TX interrupt request line
+  neorv32_dma_request_disable();
+  if (state->tx_irq == 0) {
+    UARTx->CTRL &= ~((uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF));
+  }
+  if (state->mie_en) {
+    neorv32_cpu_csr_set(CSR_MIE, 1 << firq);
+  }
+  state->active = 0;
+
+  return (status < 0) ? -1 : 0;
+}
+
+
+/**********************************************************************//**
+ * Private function to get the ring buffers of a UART.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Pointer to ring buffer descriptor.
+ **************************************************************************/
+static neorv32_uart_irq_buf_t *__neorv32_uart_irq_get_buf(neorv32_uart_t *UARTx) {
+
+  if (((uint32_t)UARTx) == NEORV32_UART1_BASE) {
+    return &__neorv32_uart_irq_buf[1];
+  }
+  else {
+    return &__neorv32_uart_irq_buf[0];
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function to move data from the TX ring buffer to the TX FIFO.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] buf Ring buffer descriptor.
+ **************************************************************************/
+static void __neorv32_uart_irq_tx_service(neorv32_uart_t *UARTx, neorv32_uart_irq_buf_t *buf) {
+
+  uint32_t tail = buf->tx_tail;
+  uint32_t head = buf->tx_head;
+
+  while ((tail != head) && ((UARTx->CTRL & (1 << UART_CTRL_TX_FULL)) == 0)) {
+    UARTx->DATA = (uint32_t)((uint8_t)buf->tx_buf[tail & buf->tx_mask]) << UART_DATA_RTX_LSB;
+    tail++;
+  }
+  buf->tx_tail = tail;
+
+  // no more data: stop TX interrupt (re-enabled by neorv32_uart_irq_write)
+  if (tail == buf->tx_head) {
+    UARTx->CTRL &= ~((uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF));
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function to move data from the RX FIFO to the RX ring buffer.
+ *
+ * @note Data is discarded if the RX ring buffer is full.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] buf Ring buffer descriptor.
+ **************************************************************************/
+static void __neorv32_uart_irq_rx_service(neorv32_uart_t *UARTx, neorv32_uart_irq_buf_t *buf) {
+
+  uint32_t head = buf->rx_head;
+  char c;
+
+  while (UARTx->CTRL & (1 << UART_CTRL_RX_NEMPTY)) {
+    c = (char)(UARTx->DATA >> UART_DATA_RTX_LSB);
+    if ((head - buf->rx_tail) <= buf->rx_mask) { // free space left?
+      buf->rx_buf[head & buf->rx_mask] = c;
+      head++;
+    }
+  }
+  buf->rx_head = head;
+}
+
+
+/**********************************************************************//**
+ * Private UART0/UART1 interrupt handlers.
+ **************************************************************************/
+static void __neorv32_uart0_irq_tx(void) { __neorv32_uart_irq_tx_service(NEORV32_UART0, &__neorv32_uart_irq_buf[0]); }
+static void __neorv32_uart0_irq_rx(void) { __neorv32_uart_irq_rx_service(NEORV32_UART0, &__neorv32_uart_irq_buf[0]); }
+static void __neorv32_uart1_irq_tx(void) { __neorv32_uart_irq_tx_service(NEORV32_UART1, &__neorv32_uart_irq_buf[1]); }
+static void __neorv32_uart1_irq_rx(void) { __neorv32_uart_irq_rx_service(NEORV32_UART1, &__neorv32_uart_irq_buf[1]); }
+
 #endif //UART_DISABLED
@@ -0,0 +1,490 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_wstask.c
+ * @brief Work-stealing task-parallel runtime (SMP) source file.
+ *
+ * @note Core 0 runs the application; core 1 runs a persistent worker that steals tasks
+ * from core 0 and executes the tasks it spawns itself. The worker backs off exponentially
+ * when there is nothing to steal and finally sleeps until a task is spawned (MSI wake-up).
+ * Task descriptors and task data are written back (fence) before a task is published and
+ * reloaded (fence) after a task has been stolen.
+ */
+
+#include <neorv32.h>
+
+#if (NEORV32_WSTASK_DEQUE_SIZE < 2) || ((NEORV32_WSTASK_DEQUE_SIZE & (NEORV32_WSTASK_DEQUE_SIZE - 1)) != 0)
+#error "NEORV32_WSTASK_DEQUE_SIZE has to be a power of two"
+#endif
+
+
+/**********************************************************************//**
+ * Chase-Lev work-stealing deque (owner: push/pop at bottom, thieves: steal at top) and
+ * statistics of one core. All members are accessed by atomic memory operations only; the
+ * structure is aligned to cache blocks so it never shares a block with cached data.
+ **************************************************************************/
+typedef struct __attribute__((aligned(NEORV32_WSTASK_CACHE_BLOCK))) {
+  volatile uint32_t top;                                  /**< next task to be stolen */
+  volatile uint32_t bottom;                               /**< next free entry */
+  volatile uint32_t task[NEORV32_WSTASK_DEQUE_SIZE];      /**< task descriptor addresses */
+  volatile uint32_t sleeping;                             /**< owner is sleeping and has to be woken up */
+  volatile uint32_t depth;                                /**< task nesting level of the owner */
+  volatile uint32_t stats[9];                             /**< statistics (#__neorv32_wstask_stat_enum) */
+} __neorv32_wstask_deque_t;
+
+
+/**********************************************************************//**
+ * Statistics counters (busy and idle are 64-bit: low word, high word).
+ **************************************************************************/
+enum __neorv32_wstask_stat_enum {
+  STAT_SPAWNED = 0, STAT_EXECUTED, STAT_STEALS, STAT_STEAL_FAILS, STAT_SLEEPS,
+  STAT_BUSY_LO, STAT_BUSY_HI, STAT_IDLE_LO, STAT_IDLE_HI
+};
+
+
+/**********************************************************************//**
+ * Deque and statistics of each core; statistics baseline (core 0 only).
+ **************************************************************************/
+static __neorv32_wstask_deque_t __neorv32_wstask_deque[NEORV32_RTE_MAX_HARTS];
+static neorv32_wstask_stats_t __neorv32_wstask_base[NEORV32_RTE_MAX_HARTS];
+
+
+#if defined __riscv_atomic
+/**********************************************************************//**
+ * Private function: load word from shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @return Data word.
+ **************************************************************************/
+static inline uint32_t __neorv32_wstask_load(volatile uint32_t *addr) {
+
+  return __atomic_fetch_or(addr, 0, __ATOMIC_SEQ_CST); // -> amoor.w
+}
+
+
+/**********************************************************************//**
+ * Private function: store word to shared memory (bypassing the caches).
+ *
+ * @param[in] addr Address.
+ * @param[in] data Data word.
+ **************************************************************************/
+static inline void __neorv32_wstask_store(volatile uint32_t *addr, uint32_t data) {
+
+  __atomic_exchange_n(addr, data, __ATOMIC_SEQ_CST); // -> amoswap.w
+}
+
+
+/**********************************************************************//**
+ * Private function: increment statistics counter of a core.
+ *
+ * @param[in] hart Core ID.
+ * @param[in] id Counter (#__neorv32_wstask_stat_enum).
+ **************************************************************************/
+static inline void __neorv32_wstask_count(uint32_t hart, int id) {
+
+  __atomic_add_fetch(&__neorv32_wstask_deque[hart].stats[id], 1, __ATOMIC_RELAXED); // -> amoadd.w
+}
+
+
+/**********************************************************************//**
+ * Private function: add cycles to a 64-bit statistics counter of a core (single writer).
+ *
+ * @param[in] hart Core ID.
+ * @param[in] id Low word of the counter (#__neorv32_wstask_stat_enum).
+ * @param[in] cycles Cycles to add.
+ **************************************************************************/
+static void __neorv32_wstask_cycles(uint32_t hart, int id, uint64_t cycles) {
+
+  volatile uint32_t *cnt = &__neorv32_wstask_deque[hart].stats[id];
+  uint32_t lo = (uint32_t)cycles;
+  uint32_t old = __atomic_fetch_add(&cnt[0], lo, __ATOMIC_RELAXED); // -> amoadd.w
+
+  __atomic_add_fetch(&cnt[1], (uint32_t)(cycles >> 32) + (((old + lo) < old) ? 1 : 0), __ATOMIC_RELAXED);
+}
+
+
+/**********************************************************************//**
+ * Private function: push task to the bottom of the own deque (owner only).
+ *
+ * @param[in,out] d Deque.
+ * @param[in] task Task descriptor.
+ * @return 0 if success, -1 if the deque is full.
+ **************************************************************************/
+static int __neorv32_wstask_push(__neorv32_wstask_deque_t *d, neorv32_wstask_t *task) {
+
+  uint32_t b = __neorv32_wstask_load(&d->bottom);
+  uint32_t t = __neorv32_wstask_load(&d->top);
+
+  if ((b - t) >= NEORV32_WSTASK_DEQUE_SIZE) {
+    return -1;
+  }
+  __neorv32_wstask_store(&d->task[b & (NEORV32_WSTASK_DEQUE_SIZE - 1)], (uint32_t)task);
+  __neorv32_wstask_store(&d->bottom, b + 1);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Private function: pop task from the bottom of the own deque (owner only).
+ *
+ * @param[in,out] d Deque.
+ * @return Task descriptor; NULL if the deque is empty.
+ **************************************************************************/
+static neorv32_wstask_t *__neorv32_wstask_pop(__neorv32_wstask_deque_t *d) {
+
+  uint32_t b = __neorv32_wstask_load(&d->bottom) - 1;
+  __neorv32_wstask_store(&d->bottom, b);
+  uint32_t t = __neorv32_wstask_load(&d->top);
+  int32_t size = (int32_t)(b - t);
+  neorv32_wstask_t *task;
+
+  if (size < 0) { // empty
+    __neorv32_wstask_store(&d->bottom, b + 1);
+    return NULL;
+  }
+  task = (neorv32_wstask_t*)__neorv32_wstask_load(&d->task[b & (NEORV32_WSTASK_DEQUE_SIZE - 1)]);
+  if (size > 0) {
+    return task;
+  }
+
+  // last task: race against thieves
+  if (!__sync_bool_compare_and_swap(&d->top, t, t + 1)) { // -> lr/sc
+    task = NULL;
+  }
+  __neorv32_wstask_store(&d->bottom, b + 1);
+  return task;
+}
+
+
+/**********************************************************************//**
+ * Private function: steal task from the top of another core's deque.
+ *
+ * @param[in,out] d Deque.
+ * @return Task descriptor; NULL if the deque is empty or another thief was faster.
+ **************************************************************************/
+static neorv32_wstask_t *__neorv32_wstask_steal(__neorv32_wstask_deque_t *d) {
+
+  uint32_t t = __neorv32_wstask_load(&d->top);
+  uint32_t b = __neorv32_wstask_load(&d->bottom);
+  neorv32_wstask_t *task;
+
+  if ((int32_t)(b - t) <= 0) {
+    return NULL;
+  }
+  task = (neorv32_wstask_t*)__neorv32_wstask_load(&d->task[t & (NEORV32_WSTASK_DEQUE_SIZE - 1)]);
+  if (!__sync_bool_compare_and_swap(&d->top, t, t + 1)) { // -> lr/sc
+    return NULL;
+  }
+  asm volatile ("fence"); // reload task descriptor and task data from main memory
+  return task;
+}
+
+
+/**********************************************************************//**
+ * Private function: execute task and signal completion to its group.
+ *
+ * @param[in] hart Core ID.
+ * @param[in] task Task descriptor.
+ **************************************************************************/
+static void __neorv32_wstask_run(uint32_t hart, neorv32_wstask_t *task) {
+
+  volatile uint32_t *depth = &__neorv32_wstask_deque[hart].depth;
+  neorv32_wstask_group_t *group = task->group;
+  uint64_t t0 = neorv32_cpu_get_cycle();
+
+  __neorv32_wstask_store(depth, __neorv32_wstask_load(depth) + 1);
+  task->fn(task->arg);
+  __neorv32_wstask_store(depth, __neorv32_wstask_load(depth) - 1);
+
+  // waiting for sub-tasks within a task is accounted as busy time
+  if (__neorv32_wstask_load(depth) == 0) {
+    __neorv32_wstask_cycles(hart, STAT_BUSY_LO, neorv32_cpu_get_cycle() - t0);
+  }
+  __neorv32_wstask_count(hart, STAT_EXECUTED);
+  asm volatile ("fence"); // make task results visible to the other core
+  __atomic_sub_fetch(&group->pending, 1, __ATOMIC_SEQ_CST); // -> amoadd.w
+}
+
+
+/**********************************************************************//**
+ * Private function: find a task to execute (own deque first, then steal).
+ *
+ * @param[in] hart Core ID.
+ * @return Task descriptor; NULL if there is no work.
+ **************************************************************************/
+static neorv32_wstask_t *__neorv32_wstask_find(uint32_t hart) {
+
+  neorv32_wstask_t *task = __neorv32_wstask_pop(&__neorv32_wstask_deque[hart]);
+
+  if (task == NULL) {
+    task = __neorv32_wstask_steal(&__neorv32_wstask_deque[hart ^ 1]);
+    if (task != NULL) {
+      __neorv32_wstask_count(hart, STAT_STEALS);
+    }
+    else {
+      __neorv32_wstask_count(hart, STAT_STEAL_FAILS);
+    }
+  }
+  return task;
+}
+
+
+/**********************************************************************//**
+ * Private function: busy-wait (exponential backoff).
+ *
+ * @param[in] hart Core ID.
+ * @param[in] iterations Number of delay loop iterations.
+ **************************************************************************/
+static void __neorv32_wstask_backoff(uint32_t hart, uint32_t iterations) {
+
+  uint64_t t0 = neorv32_cpu_get_cycle();
+
+  while (iterations--) {
+    asm volatile ("nop");
+  }
+  if (__neorv32_wstask_load(&__neorv32_wstask_deque[hart].depth) == 0) {
+    __neorv32_wstask_cycles(hart, STAT_IDLE_LO, neorv32_cpu_get_cycle() - t0);
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: persistent worker (main function of core 1).
+ *
+ * @return Does not return.
+ **************************************************************************/
+static int __neorv32_wstask_worker(void) {
+
+  const uint32_t hart = 1;
+  __neorv32_wstask_deque_t *d = &__neorv32_wstask_deque[hart];
+  neorv32_wstask_t *task;
+  uint32_t delay = 1;
+  uint64_t t0;
+
+  neorv32_rte_setup();
+
+  // the MSI is used as wake-up source only; interrupts remain globally disabled
+  neorv32_cpu_csr_write(CSR_MIE, 1 << CSR_MIE_MSIE);
+
+  while (1) {
+    task = __neorv32_wstask_find(hart);
+    if (task != NULL) {
+      __neorv32_wstask_run(hart, task);
+      delay = 1;
+      continue;
+    }
+
+    if (delay < NEORV32_WSTASK_BACKOFF_MAX) {
+      __neorv32_wstask_backoff(hart, delay);
+      delay <<= 1;
+      continue;
+    }
+
+    // go to sleep; a core that spawns a task sees the sleeping flag and triggers our MSI
+    t0 = neorv32_cpu_get_cycle();
+    neorv32_clint_msi_clr(hart);
+    __neorv32_wstask_store(&d->sleeping, 1);
+    if ((int32_t)(__neorv32_wstask_load(&__neorv32_wstask_deque[0].bottom) -
+                  __neorv32_wstask_load(&__neorv32_wstask_deque[0].top)) <= 0) {
+      neorv32_cpu_sleep();
+      __neorv32_wstask_count(hart, STAT_SLEEPS);
+    }
+    __neorv32_wstask_store(&d->sleeping, 0);
+    __neorv32_wstask_cycles(hart, STAT_IDLE_LO, neorv32_cpu_get_cycle() - t0);
+    delay = 1;
+  }
+  return 0;
+}
+#endif
+
+
+/**********************************************************************//**
+ * Setup the work-stealing runtime: clear all deques and statistics.
+ *
+ * @warning This function can be executed on core 0 only and must not be called while
+ * tasks are pending.
+ **************************************************************************/
+void neorv32_wstask_setup(void) {
+
+#if defined __riscv_atomic
+  uint32_t i, j;
+
+  for (i=0; i<NEORV32_RTE_MAX_HARTS; i++) {
+    __neorv32_wstask_store(&__neorv32_wstask_deque[i].top, 0);
+    __neorv32_wstask_store(&__neorv32_wstask_deque[i].bottom, 0);
+    __neorv32_wstask_store(&__neorv32_wstask_deque[i].sleeping, 0);
+    __neorv32_wstask_store(&__neorv32_wstask_deque[i].depth, 0);
+    for (j=0; j<9; j++) {
+      __neorv32_wstask_store(&__neorv32_wstask_deque[i].stats[j], 0);
+    }
+  }
+#endif
+  uint32_t k;
+  neorv32_wstask_stats_t zero = {0};
+  for (k=0; k<NEORV32_RTE_MAX_HARTS; k++) {
+    __neorv32_wstask_base[k] = zero;
+  }
+}
+
+
+/**********************************************************************//**
+ * Launch the work-stealing worker on core 1 (#neorv32_smp_launch()).
+ *
+ * @warning This function can be executed on core 0 only. Core 1 is dedicated to the worker
+ * afterwards (it cannot run the parallel loop worker of #neorv32_smp_worker_start() at the
+ * same time).
+ *
+ * @param[in] stack_memory Pointer to beginning of core1's stack memory array
+ * (has to be large enough for the deepest task nesting).
+ * @param[in] stack_size_bytes Core1's stack size in bytes.
+ * @return 0 if launching succeeded, -1 if invalid hart ID, CLINT not available or the
+ * A ISA extension is not available, -2 if core1 is not responding.
+ **************************************************************************/
+int neorv32_wstask_start(uint8_t* stack_memory, size_t stack_size_bytes) {
+
+#if defined __riscv_atomic
+  return neorv32_smp_launch(__neorv32_wstask_worker, stack_memory, stack_size_bytes);
+#else
+  (void)stack_memory;
+  (void)stack_size_bytes;
+  return -1;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Initialize task group.
+ *
+ * @param[in,out] group Task group.
+ **************************************************************************/
+void neorv32_wstask_group_init(neorv32_wstask_group_t *group) {
+
+#if defined __riscv_atomic
+  __neorv32_wstask_store(&group->pending, 0);
+#else
+  group->pending = 0;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Spawn a task: the task is put into the calling core's deque and executed either
+ * by this core (in #neorv32_wstask_sync()) or by the other core (stolen).
+ *
+ * @note Must not be called from interrupt handlers. All data the task accesses must
+ * be written before spawning it.
+ *
+ * @param[in,out] group Task group; has to be synchronized via #neorv32_wstask_sync().
+ * @param[in,out] task Task descriptor (has to remain valid until the group has been synchronized).
+ * @param[in] fn Task function.
+ * @param[in] arg Task argument.
+ **************************************************************************/
+void neorv32_wstask_spawn(neorv32_wstask_group_t *group, neorv32_wstask_t *task, void (*fn)(void *arg), void *arg) {
+
+  task->fn = fn;
+  task->arg = arg;
+  task->group = group;
+
+#if defined __riscv_atomic
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID) & 1;
+
+  __neorv32_wstask_count(hart, STAT_SPAWNED);
+  __atomic_add_fetch(&group->pending, 1, __ATOMIC_SEQ_CST); // -> amoadd.w
+  asm volatile ("fence"); // make task descriptor and task data visible to the other core
+
+  if (__neorv32_wstask_push(&__neorv32_wstask_deque[hart], task) == 0) {
+    if (__neorv32_wstask_load(&__neorv32_wstask_deque[hart ^ 1].sleeping)) {
+      neorv32_clint_msi_set((int)(hart ^ 1)); // wake up the other core
+    }
+    return;
+  }
+  __neorv32_wstask_run(hart, task); // deque full: execute right away
+#else
+  fn(arg);
+#endif
+}
+
+
+/**********************************************************************//**
+ * Wait until all tasks of a group have been completed. The calling core executes
+ * tasks of its own deque and steals tasks from the other core while waiting.
+ *
+ * @param[in,out] group Task group.
+ **************************************************************************/
+void neorv32_wstask_sync(neorv32_wstask_group_t *group) {
+
+#if defined __riscv_atomic
+  uint32_t hart = neorv32_cpu_csr_read(CSR_MHARTID) & 1;
+  neorv32_wstask_t *task;
+  uint32_t delay = 1;
+
+  while (__neorv32_wstask_load(&group->pending) != 0) {
+    task = __neorv32_wstask_find(hart);
+    if (task != NULL) {
+      __neorv32_wstask_run(hart, task);
+      delay = 1;
+    }
+    else { // the remaining tasks are being executed by the other core
+      __neorv32_wstask_backoff(hart, delay);
+      if (delay < NEORV32_WSTASK_BACKOFF_MAX) {
+        delay <<= 1;
+      }
+    }
+  }
+  asm volatile ("fence"); // reload task results of the other core
+#else
+  (void)group;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Get runtime statistics of a core.
+ *
+ * @note Busy and idle times are accounted outside of tasks only (a task that waits for its
+ * sub-tasks is busy). Core 1 utilization = busy / (busy + idle); core 0 is idle only while
+ * the application waits in #neorv32_wstask_sync(). All statistics are zero if the A ISA
+ * extension is not available.
+ *
+ * @param[in] hart Core ID (0..#NEORV32_RTE_MAX_HARTS-1).
+ * @param[out] stats Statistics (#neorv32_wstask_stats_t) since setup or last reset.
+ * @param[in] reset Reset statistics of this core after reading them when non-zero.
+ **************************************************************************/
+void neorv32_wstask_get_stats(int hart, neorv32_wstask_stats_t *stats, int reset) {
+
+  neorv32_wstask_stats_t now = {0};
+
+  if (((uint32_t)hart) >= NEORV32_RTE_MAX_HARTS) {
+    return;
+  }
+
+#if defined __riscv_atomic
+  volatile uint32_t *cnt = __neorv32_wstask_deque[hart].stats;
+  now.spawned     = __neorv32_wstask_load(&cnt[STAT_SPAWNED]);
+  now.executed    = __neorv32_wstask_load(&cnt[STAT_EXECUTED]);
+  now.steals      = __neorv32_wstask_load(&cnt[STAT_STEALS]);
+  now.steal_fails = __neorv32_wstask_load(&cnt[STAT_STEAL_FAILS]);
+  now.sleeps      = __neorv32_wstask_load(&cnt[STAT_SLEEPS]);
+  now.busy        = ((uint64_t)__neorv32_wstask_load(&cnt[STAT_BUSY_HI]) << 32) | __neorv32_wstask_load(&cnt[STAT_BUSY_LO]);
+  now.idle        = ((uint64_t)__neorv32_wstask_load(&cnt[STAT_IDLE_HI]) << 32) | __neorv32_wstask_load(&cnt[STAT_IDLE_LO]);
+#endif
+
+  neorv32_wstask_stats_t *base = &__neorv32_wstask_base[hart];
+  stats->spawned     = now.spawned     - base->spawned;
+  stats->executed    = now.executed    - base->executed;
+  stats->steals      = now.steals      - base->steals;
+  stats->steal_fails = now.steal_fails - base->steal_fails;
+  stats->sleeps      = now.sleeps      - base->sleeps;
+  stats->busy        = now.busy        - base->busy;
+  stats->idle        = now.idle        - base->idle;
+
+  if (reset) {
+    *base = now;
+  }
+}
@@ -0,0 +1,267 @@
+// ================================================================================ //
+// Deferred binary log decoder                                                      //
+// -------------------------------------------------------------------------------- //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2025 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+// Decodes the binary record stream generated by NEORV32_LOG() (neorv32_log.c) using the
+// format strings from the ".neorv32_log" section of the application's ELF file.
+// Build: "make log_decode" in any application folder (or gcc log_decode.c -o log_decode)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// record header word (see neorv32_log.h)
+#define LOG_SYNC     0xa
+#define LOG_MAX_ARGS 15
+
+// format strings
+static char    *fmt_sec  = NULL;
+static uint32_t fmt_size = 0;
+
+
+// read little-endian values
+static uint32_t get16(const unsigned char *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8); }
+static uint32_t get32(const unsigned char *p) { return get16(p) | (get16(p + 2) << 16); }
+
+
+// load ".neorv32_log" section from 32-bit little-endian ELF file
+static int load_elf(const char *name) {
+
+  FILE *f = fopen(name, "rb");
+  if (f == NULL) {
+    return -1;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (size <= 0) {
+    fclose(f);
+    return -1;
+  }
+  unsigned char *elf = malloc(size);
+  if ((elf == NULL) || (fread(elf, 1, size, f) != (size_t)size)) {
+    free(elf);
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+
+  // ELF32 little-endian?
+  if ((size < 52) || (memcmp(elf, "\177ELF", 4) != 0) || (elf[4] != 1) || (elf[5] != 1)) {
+    free(elf);
+    return -1;
+  }
+
+  uint32_t shoff     = get32(elf + 32);
+  uint32_t shentsize = get16(elf + 46);
+  uint32_t shnum     = get16(elf + 48);
+  uint32_t shstrndx  = get16(elf + 50);
+  if ((shoff + shnum * shentsize > (uint32_t)size) || (shstrndx >= shnum)) {
+    free(elf);
+    return -1;
+  }
+
+  const unsigned char *strtab = elf + get32(elf + shoff + shstrndx * shentsize + 16);
+  uint32_t i;
+  for (i=0; i<shnum; i++) {
+    const unsigned char *sh = elf + shoff + i * shentsize;
+    if (strcmp((const char*)strtab + get32(sh), ".neorv32_log") == 0) {
+      fmt_size = get32(sh + 20);
+      fmt_sec  = malloc(fmt_size + 1);
+      if ((fmt_sec == NULL) || (get32(sh + 16) + fmt_size > (uint32_t)size)) {
+        free(fmt_sec);
+        fmt_sec = NULL;
+        free(elf);
+        return -1;
+      }
+      memcpy(fmt_sec, elf + get32(sh + 16), fmt_size);
+      fmt_sec[fmt_size] = '\0';
+      free(elf);
+      return 0;
+    }
+  }
+  free(elf);
+  return -1;
+}
+
+
+// number of arguments required by format string (including '*' width/precision arguments)
+static int count_args(const char *fmt) {
+
+  int n = 0;
+  while (*fmt) {
+    if (*fmt++ != '%') {
+      continue;
+    }
+    if (*fmt == '%') {
+      fmt++;
+      continue;
+    }
+    while (*fmt && strchr("-0123456789.l*", *fmt)) {
+      if (*fmt == '*') {
+        n++;
+      }
+      fmt++;
+    }
+    if (*fmt) {
+      n++;
+      fmt++;
+    }
+  }
+  return n;
+}
+
+
+// print one record (same conversions as neorv32_fmt_vprintf, 32-bit arguments only)
+static void print_record(const char *fmt, const uint32_t *args) {
+
+  char spec[64];
+  int i;
+
+  while (*fmt) {
+    if (*fmt != '%') {
+      putchar(*fmt++);
+      continue;
+    }
+    // copy conversion specification
+    i = 0;
+    spec[i++] = *fmt++;
+    while (*fmt && strchr("-0123456789.l*", *fmt) && (i < 40)) {
+      if (*fmt == '*') { // width/precision taken from the arguments
+        i += snprintf(spec + i, 12, "%d", (int)(int32_t)*args++);
+      }
+      else if (*fmt != 'l') {
+        spec[i++] = *fmt;
+      }
+      fmt++;
+    }
+    char c = *fmt++;
+    if (c == '\0') {
+      break;
+    }
+    switch (c | 0x20) { // lower case
+      case 'd':
+      case 'i':
+        spec[i++] = 'd'; spec[i] = '\0';
+        printf(spec, (int32_t)*args++);
+        break;
+      case 'u':
+        spec[i++] = 'u'; spec[i] = '\0';
+        printf(spec, *args++);
+        break;
+      case 'x':
+      case 'p':
+        if (i == 1) { // no width: all digits with leading zeros
+          strcpy(spec, "%08");
+          i = 3;
+        }
+        spec[i++] = 'x'; spec[i] = '\0';
+        printf(spec, *args++);
+        break;
+      case 'c':
+        spec[i++] = 'c'; spec[i] = '\0';
+        printf(spec, (int)(*args++ & 0xff));
+        break;
+      case '%':
+        putchar('%');
+        break;
+      default: // not supported (e.g. %s)
+        printf("<%%%c:0x%08x>", c, *args++);
+        break;
+    }
+  }
+}
+
+
+int main(int argc, char *argv[]) {
+
+  if ((argc < 2) || (argc > 4)) {
+    printf("NEORV32 deferred binary log decoder\n"
+           "Usage: log_decode <application ELF> [log stream file, default: stdin] [clock in Hz]\n"
+           "Example: log_decode main.elf /dev/ttyUSB0 100000000\n");
+    return 0;
+  }
+
+  if (load_elf(argv[1])) {
+    fprintf(stderr, "Error: no '.neorv32_log' section found in '%s'\n", argv[1]);
+    return 1;
+  }
+
+  FILE *in = stdin;
+  if ((argc > 2) && (strcmp(argv[2], "-") != 0)) {
+    in = fopen(argv[2], "rb");
+    if (in == NULL) {
+      fprintf(stderr, "Error: cannot open '%s'\n", argv[2]);
+      free(fmt_sec);
+      return 1;
+    }
+  }
+  double clock = (argc > 3) ? atof(argv[3]) : 0.0;
+
+  // sliding window over the byte stream
+  unsigned char win[(LOG_MAX_ARGS + 2) * 4];
+  uint32_t words[LOG_MAX_ARGS + 2];
+  int fill = 0, c, i, num, need;
+  uint32_t id, hdr;
+  uint64_t time = 0;
+  uint32_t last = 0;
+  int first = 1;
+
+  while ((c = fgetc(in)) != EOF) {
+    win[fill++] = (unsigned char)c;
+    while (fill >= 4) {
+      hdr = get32(win);
+      id  = hdr >> 8;
+      num = (hdr >> 4) & 0xf;
+      // valid header: sync pattern, string start inside section, matching number of arguments
+      if (((hdr & 0xf) != LOG_SYNC) || (id >= fmt_size) || ((id != 0) && (fmt_sec[id - 1] != '\0')) ||
+          (fmt_sec[id] == '\0') || (count_args(fmt_sec + id) != num)) {
+        memmove(win, win + 1, --fill); // resync: skip one byte
+        continue;
+      }
+      need = (num + 2) * 4;
+      if (fill < need) {
+        break; // wait for more data
+      }
+      for (i=0; i<num+2; i++) {
+        words[i] = get32(win + 4*i);
+      }
+      memmove(win, win + need, fill - need);
+      fill -= need;
+
+      // extend 32-bit time stamp
+      if (first) {
+        first = 0;
+      }
+      else {
+        time += (uint32_t)(words[1] - last);
+      }
+      last = words[1];
+
+      if (clock > 0.0) {
+        printf("[%12.6f] ", (double)time / clock);
+      }
+      else {
+        printf("[%12llu] ", (unsigned long long)time);
+      }
+      print_record(fmt_sec + id, &words[2]);
+      if (fmt_sec[id + strlen(fmt_sec + id) - 1] != '\n') {
+        putchar('\n');
+      }
+      fflush(stdout);
+    }
+  }
+
+  if (in != stdin) {
+    fclose(in);
+  }
+  free(fmt_sec);
+  return 0;
+}